@@ -79,6 +79,41 @@ private:
 	RVNGStringStream &operator=(const RVNGStringStream &); // assignment is not allowed
 };
 
+class RVNGMMapStreamPrivate;
+
+/** Read-only stream over a file mapped in memory.
+
+Reads return pointers straight into the mapping, so seeking is free and no
+data is copied. Where mapping is not available, the whole file is read in
+memory once instead.
+*/
+class REVENGE_STREAM_API RVNGMMapStream: public RVNGInputStream
+{
+public:
+	explicit RVNGMMapStream(const char *filename);
+	~RVNGMMapStream();
+
+	const unsigned char *read(unsigned long numBytes, unsigned long &numBytesRead);
+	long tell();
+	int seek(long offset, RVNG_SEEK_TYPE seekType);
+	bool isEnd();
+
+	bool isStructured();
+	unsigned subStreamCount();
+	const char *subStreamName(unsigned id);
+	bool existsSubStream(const char *name);
+	RVNGInputStream *getSubStreamById(unsigned id);
+	RVNGInputStream *getSubStreamByName(const char *name);
+
+	/// whether the file could be opened
+	bool isOpen() const;
+
+private:
+	RVNGMMapStreamPrivate *d;
+	RVNGMMapStream(const RVNGMMapStream &); // copy is not allowed
+	RVNGMMapStream &operator=(const RVNGMMapStream &); // assignment is not allowed
+};
+
 }
 
 #endif // RVNGSTREAMIMPLEMENTATION_H
@@ -0,0 +1,96 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* librevenge
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef RVNGPATH_H
+#define RVNGPATH_H
+
+#include "librevenge-api.h"
+
+#include "RVNGProperty.h"
+
+namespace librevenge
+{
+
+class RVNGPathImpl;
+class RVNGPropertyListVector;
+
+/** A path kept as two arrays: the action of each segment, and the
+  * coordinates of all the segments one after the other. It is the typed
+  * form of "svg:d", the vector of property lists holding a
+  * librevenge:path-action each, into which it converts when needed.
+  */
+class REVENGE_API RVNGPath : public RVNGProperty
+{
+public:
+	enum Action
+	{
+		MOVE_TO = 'M',
+		LINE_TO = 'L',
+		CURVE_TO = 'C',
+		QUAD_TO = 'Q',
+		ARC_TO = 'A',
+		CLOSE = 'Z'
+	};
+
+	RVNGPath();
+	RVNGPath(const RVNGPath &path);
+	virtual ~RVNGPath();
+	RVNGPath &operator=(const RVNGPath &path);
+
+	// RVNGProperty methods
+	int getInt() const;
+	double getDouble() const;
+	RVNGUnit getUnit() const;
+	RVNGString getStr() const;
+	RVNGProperty *clone() const;
+
+	void moveTo(double x, double y);
+	void lineTo(double x, double y);
+	void curveTo(double x1, double y1, double x2, double y2, double x, double y);
+	void quadTo(double x1, double y1, double x, double y);
+	void arcTo(double rx, double ry, double rotate, bool largeArc, bool sweep, double x, double y);
+	void close();
+	/** appends a segment, coordinates holding coordinateCount(action) values */
+	void append(Action action, const double *coordinates);
+	/** removes the last segment */
+	void removeLast();
+	void clear();
+
+	unsigned long count() const;
+	bool empty() const;
+	/** the actions of the segments */
+	const unsigned char *getActions() const;
+	/** the coordinates of the segments, in their order: x y for M and L,
+	  * x1 y1 x2 y2 x y for C, x1 y1 x y for Q, rx ry rotate large-arc sweep
+	  * x y for A, the flags being 0 or 1, and none for Z
+	  */
+	const double *getCoordinates() const;
+	/** the path as the vector of property lists of "svg:d"; it is built on
+	  * the first call and kept until the path changes
+	  */
+	const RVNGPropertyListVector &getPropListVector() const;
+
+	/** the number of coordinates of a segment doing action, 0 if unknown */
+	static unsigned coordinateCount(unsigned char action);
+
+private:
+	RVNGPathImpl *m_impl;
+};
+
+}
+
+#endif /* RVNGPATH_H */
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -27,6 +27,8 @@
 namespace librevenge
 {
 
+class RVNGBinaryData;
+
 enum RVNGUnit { RVNG_INCH, RVNG_PERCENT, RVNG_POINT, RVNG_TWIP, RVNG_GENERIC, RVNG_UNIT_ERROR };
 
 class REVENGE_API RVNGProperty
@@ -56,6 +58,11 @@ public:
 	static RVNGProperty *newPercentProp(const double val);
 	static RVNGProperty *newPointProp(const double val);
 	static RVNGProperty *newTwipProp(const double val);
+
+	/** returns the data held by prop if it was created by newBinaryDataProp, NULL otherwise.
+	  * This gives access to the raw bytes without going through getStr(), which encodes them in base64.
+	  */
+	static const RVNGBinaryData *getBinaryData(const RVNGProperty *prop);
 };
 
 }
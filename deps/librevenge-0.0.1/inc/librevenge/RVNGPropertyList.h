@@ -34,6 +34,7 @@ namespace librevenge
 class RVNGPropertyListImpl;
 class RVNGPropertyListIterImpl;
 class RVNGPropertyListVector;
+class RVNGPath;
 
 class REVENGE_API RVNGPropertyList
 {
@@ -50,12 +51,16 @@ public:
 	void insert(const char *name, const unsigned char *buffer, const unsigned long bufferSize);
 	void insert(const char *name, const RVNGBinaryData &data);
 	void insert(const char *name, const RVNGPropertyListVector &vec);
+	/** inserts a path, which child() returns as a property list vector as well */
+	void insert(const char *name, const RVNGPath &path);
 	void remove(const char *name);
 	void clear();
 	bool empty() const;
 
 	const RVNGProperty *operator[](const char *name) const;
 	const RVNGPropertyListVector *child(const char *name) const;
+	/** the path inserted as name, 0 if there is none or if it was inserted as a vector */
+	const RVNGPath *path(const char *name) const;
 	const RVNGPropertyList &operator=(const RVNGPropertyList &propList);
 
 	RVNGString getPropString() const;
@@ -23,6 +23,7 @@
 
 #include "RVNGBinaryData.h"
 #include "RVNGDrawingInterface.h"
+#include "RVNGPath.h"
 #include "RVNGPresentationInterface.h"
 #include "RVNGProperty.h"
 #include "RVNGPropertyList.h"
@@ -512,6 +512,11 @@ public:
 
 	unsigned long loadSmallBlock(unsigned long block, unsigned char *buffer, unsigned long maxlen);
 
+	//! reads len bytes at pos in the file, the missing ones are set to 0
+	void readAt(unsigned long pos, unsigned char *buffer, unsigned long len);
+	//! finds the position of a small block in the file
+	bool smallBlockPos(unsigned long block, unsigned long &pos) const;
+
 protected:
 	bool m_isLoad;
 private:
@@ -1250,19 +1255,23 @@ unsigned long librevenge::IStorage::loadBigBlocks(std::vector<unsigned long> con
 	if (blocks.size() < 1) return 0;
 	if (maxlen == 0) return 0;
 
-	// read block one by one, seems fast enough
+	// read each run of consecutive blocks at once
 	unsigned long bytes = 0;
-	for (unsigned long i=0; (i < blocks.size()) & (bytes<maxlen); i++)
+	for (unsigned long i=0; (i < blocks.size()) & (bytes<maxlen);)
 	{
-		unsigned long block = blocks[i];
-		unsigned long pos =  m_bbat.m_blockSize * (block+1);
-		unsigned long p = (m_bbat.m_blockSize < maxlen-bytes) ? m_bbat.m_blockSize : maxlen-bytes;
+		unsigned long run = 1;
+		while (i+run < blocks.size() && blocks[i+run] == blocks[i+run-1]+1)
+			run++;
+		unsigned long pos =  m_bbat.m_blockSize * (blocks[i]+1);
+		unsigned long p = (run*m_bbat.m_blockSize < maxlen-bytes) ? run*m_bbat.m_blockSize : maxlen-bytes;
 
 		m_input->seek(long(pos), RVNG_SEEK_SET);
 		unsigned long numBytesRead = 0;
 		const unsigned char *buf = m_input->read(p, numBytesRead);
-		memcpy(data+bytes, buf, numBytesRead);
+		if (numBytesRead)
+			memcpy(data+bytes, buf, numBytesRead);
 		bytes += numBytesRead;
+		i += run;
 	}
 
 	return bytes;
@@ -1282,6 +1291,28 @@ unsigned long librevenge::IStorage::loadBigBlock(unsigned long block,
 	return loadBigBlocks(blocks, data, maxlen);
 }
 
+void librevenge::IStorage::readAt(unsigned long pos, unsigned char *data, unsigned long len)
+{
+	m_input->seek(long(pos), RVNG_SEEK_SET);
+	unsigned long numBytesRead = 0;
+	const unsigned char *buf = m_input->read(len, numBytesRead);
+	if (numBytesRead)
+		memcpy(data, buf, numBytesRead);
+	if (numBytesRead < len)
+		memset(data+numBytesRead, 0, len-numBytesRead);
+}
+
+bool librevenge::IStorage::smallBlockPos(unsigned long block, unsigned long &pos) const
+{
+	// the small blocks are stored in the big blocks of m_sb_blocks
+	unsigned long sbPos = block * m_sbat.m_blockSize;
+	unsigned long bbindex = sbPos / m_bbat.m_blockSize;
+	if (bbindex >= m_sb_blocks.size())
+		return false;
+	pos = m_bbat.m_blockSize * (m_sb_blocks[bbindex]+1) + sbPos % m_bbat.m_blockSize;
+	return true;
+}
+
 // return number of bytes which has been read
 unsigned long librevenge::IStorage::loadSmallBlocks(std::vector<unsigned long> const &blocks,
                                                     unsigned char *data, unsigned long maxlen)
@@ -1289,27 +1320,15 @@ unsigned long librevenge::IStorage::loadSmallBlocks(std::vector<unsigned long> c
 	// sentinel
 	if (!data  || blocks.size() < 1 ||  maxlen == 0) return 0;
 
-	// our own local buffer
-	std::vector<unsigned char> tmpBuf(m_bbat.m_blockSize);
-
-	// read small block one by one
+	// read small block one by one, straight from the file
 	unsigned long bytes = 0;
 	for (unsigned long i=0; (i<blocks.size()) & (bytes<maxlen); i++)
 	{
-		unsigned long block = blocks[i];
+		unsigned long pos;
+		if (!smallBlockPos(blocks[i], pos)) break;
 
-		// find where the small-block exactly is
-		unsigned long pos = block * m_sbat.m_blockSize;
-		unsigned long bbindex = pos / m_bbat.m_blockSize;
-		if (bbindex >= m_sb_blocks.size()) break;
-
-		loadBigBlock(m_sb_blocks[ bbindex ], &tmpBuf[0], m_bbat.m_blockSize);
-
-		// copy the data
-		unsigned long offset = pos % m_bbat.m_blockSize;
-		unsigned long p = (maxlen-bytes < m_bbat.m_blockSize-offset) ? maxlen-bytes :  m_bbat.m_blockSize-offset;
-		p = (m_sbat.m_blockSize<p) ? m_sbat.m_blockSize : p;
-		memcpy(data + bytes, &tmpBuf[offset], p);
+		unsigned long p = (maxlen-bytes < m_sbat.m_blockSize) ? maxlen-bytes : m_sbat.m_blockSize;
+		readAt(pos, data + bytes, p);
 		bytes += p;
 	}
 
@@ -1550,15 +1569,17 @@ unsigned long librevenge::IStream::readUsingStorage(unsigned long pos, unsigned
 
 		if (index >= m_blocks.size()) return 0;
 
-		std::vector<unsigned char> buf(sBlockSize);
 		unsigned long offset = pos % sBlockSize;
 		while (totalbytes < maxlen)
 		{
 			if (index >= m_blocks.size()) break;
-			m_iStorage->loadSmallBlock(m_blocks[index], &buf[0], m_iStorage->m_bbat.m_blockSize);
 			unsigned long count = sBlockSize - offset;
 			if (count > maxlen-totalbytes) count = maxlen-totalbytes;
-			memcpy(data+totalbytes, &buf[offset], count);
+			unsigned long blockPos;
+			if (m_iStorage->smallBlockPos(m_blocks[index], blockPos))
+				m_iStorage->readAt(blockPos + offset, data+totalbytes, count);
+			else
+				memset(data+totalbytes, 0, count);
 			totalbytes += count;
 			offset = 0;
 			index++;
@@ -1566,23 +1587,25 @@ unsigned long librevenge::IStream::readUsingStorage(unsigned long pos, unsigned
 	}
 	else
 	{
-		// big file
+		// big file: read each run of consecutive blocks at once
 		unsigned bBlockSize = m_iStorage->m_bbat.m_blockSize;
 		unsigned long index = pos / bBlockSize;
 
 		if (index >= m_blocks.size()) return 0;
 
-		std::vector<unsigned char> buf(bBlockSize);
 		unsigned long offset = pos % bBlockSize;
 		while (totalbytes < maxlen)
 		{
 			if (index >= m_blocks.size()) break;
-			m_iStorage->loadBigBlock(m_blocks[index], &buf[0], bBlockSize);
-			unsigned long count = bBlockSize - offset;
+			unsigned long run = 1;
+			while (index+run < m_blocks.size() && m_blocks[index+run] == m_blocks[index+run-1]+1
+			        && run*bBlockSize < offset+maxlen-totalbytes)
+				run++;
+			unsigned long count = run*bBlockSize - offset;
 			if (count > maxlen-totalbytes) count = maxlen-totalbytes;
-			memcpy(data+totalbytes, &buf[offset], count);
+			m_iStorage->readAt(bBlockSize*(m_blocks[index]+1) + offset, data+totalbytes, count);
 			totalbytes += count;
-			index++;
+			index += run;
 			offset = 0;
 		}
 	}
@@ -0,0 +1,254 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* librevenge
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include <vector>
+#include <librevenge/librevenge.h>
+
+namespace librevenge
+{
+
+class RVNGPathImpl
+{
+public:
+	RVNGPathImpl() : m_actions(), m_coordinates(), m_vector(0) {}
+	RVNGPathImpl(const RVNGPathImpl &impl) :
+		m_actions(impl.m_actions),
+		m_coordinates(impl.m_coordinates),
+		m_vector(0) {}
+	~RVNGPathImpl()
+	{
+		delete m_vector;
+	}
+	void changed()
+	{
+		delete m_vector;
+		m_vector = 0;
+	}
+	void buildVector() const;
+
+	std::vector<unsigned char> m_actions;
+	std::vector<double> m_coordinates;
+	mutable RVNGPropertyListVector *m_vector;
+
+private:
+	// not implemented
+	RVNGPathImpl &operator=(const RVNGPathImpl &);
+};
+
+void RVNGPathImpl::buildVector() const
+{
+	m_vector = new RVNGPropertyListVector();
+	const double *coords = m_coordinates.empty() ? 0 : &m_coordinates[0];
+	RVNGPropertyList segment;
+	for (std::vector<unsigned char>::const_iterator i = m_actions.begin(); i != m_actions.end(); ++i)
+	{
+		segment.clear();
+		switch (*i)
+		{
+		case RVNGPath::MOVE_TO:
+			segment.insert("librevenge:path-action", "M");
+			break;
+		case RVNGPath::LINE_TO:
+			segment.insert("librevenge:path-action", "L");
+			break;
+		case RVNGPath::CURVE_TO:
+			segment.insert("librevenge:path-action", "C");
+			segment.insert("svg:x1", *coords++);
+			segment.insert("svg:y1", *coords++);
+			segment.insert("svg:x2", *coords++);
+			segment.insert("svg:y2", *coords++);
+			break;
+		case RVNGPath::QUAD_TO:
+			segment.insert("librevenge:path-action", "Q");
+			segment.insert("svg:x1", *coords++);
+			segment.insert("svg:y1", *coords++);
+			break;
+		case RVNGPath::ARC_TO:
+			segment.insert("librevenge:path-action", "A");
+			segment.insert("svg:rx", *coords++);
+			segment.insert("svg:ry", *coords++);
+			segment.insert("librevenge:rotate", *coords++, RVNG_GENERIC);
+			segment.insert("librevenge:large-arc", (int)*coords++);
+			segment.insert("librevenge:sweep", (int)*coords++);
+			break;
+		default:
+			segment.insert("librevenge:path-action", "Z");
+			m_vector->append(segment);
+			continue;
+		}
+		segment.insert("svg:x", *coords++);
+		segment.insert("svg:y", *coords++);
+		m_vector->append(segment);
+	}
+}
+
+RVNGPath::RVNGPath() :
+	m_impl(new RVNGPathImpl())
+{
+}
+
+RVNGPath::RVNGPath(const RVNGPath &path) :
+	m_impl(new RVNGPathImpl(*path.m_impl))
+{
+}
+
+RVNGPath::~RVNGPath()
+{
+	delete m_impl;
+}
+
+RVNGPath &RVNGPath::operator=(const RVNGPath &path)
+{
+	if (this != &path)
+	{
+		m_impl->m_actions = path.m_impl->m_actions;
+		m_impl->m_coordinates = path.m_impl->m_coordinates;
+		m_impl->changed();
+	}
+	return *this;
+}
+
+int RVNGPath::getInt() const
+{
+	return 0;
+}
+
+double RVNGPath::getDouble() const
+{
+	return 0.0;
+}
+
+RVNGUnit RVNGPath::getUnit() const
+{
+	return RVNG_UNIT_ERROR;
+}
+
+RVNGString RVNGPath::getStr() const
+{
+	return RVNGString();
+}
+
+RVNGProperty *RVNGPath::clone() const
+{
+	return new RVNGPath(*this);
+}
+
+void RVNGPath::moveTo(double x, double y)
+{
+	const double coords[] = { x, y };
+	append(MOVE_TO, coords);
+}
+
+void RVNGPath::lineTo(double x, double y)
+{
+	const double coords[] = { x, y };
+	append(LINE_TO, coords);
+}
+
+void RVNGPath::curveTo(double x1, double y1, double x2, double y2, double x, double y)
+{
+	const double coords[] = { x1, y1, x2, y2, x, y };
+	append(CURVE_TO, coords);
+}
+
+void RVNGPath::quadTo(double x1, double y1, double x, double y)
+{
+	const double coords[] = { x1, y1, x, y };
+	append(QUAD_TO, coords);
+}
+
+void RVNGPath::arcTo(double rx, double ry, double rotate, bool largeArc, bool sweep, double x, double y)
+{
+	const double coords[] = { rx, ry, rotate, largeArc ? 1.0 : 0.0, sweep ? 1.0 : 0.0, x, y };
+	append(ARC_TO, coords);
+}
+
+void RVNGPath::close()
+{
+	append(CLOSE, 0);
+}
+
+void RVNGPath::append(Action action, const double *coordinates)
+{
+	m_impl->m_actions.push_back((unsigned char)action);
+	m_impl->m_coordinates.insert(m_impl->m_coordinates.end(), coordinates, coordinates + coordinateCount(action));
+	m_impl->changed();
+}
+
+void RVNGPath::removeLast()
+{
+	if (m_impl->m_actions.empty())
+		return;
+	m_impl->m_coordinates.resize(m_impl->m_coordinates.size() - coordinateCount(m_impl->m_actions.back()));
+	m_impl->m_actions.pop_back();
+	m_impl->changed();
+}
+
+void RVNGPath::clear()
+{
+	m_impl->m_actions.clear();
+	m_impl->m_coordinates.clear();
+	m_impl->changed();
+}
+
+unsigned long RVNGPath::count() const
+{
+	return m_impl->m_actions.size();
+}
+
+bool RVNGPath::empty() const
+{
+	return m_impl->m_actions.empty();
+}
+
+const unsigned char *RVNGPath::getActions() const
+{
+	return m_impl->m_actions.empty() ? 0 : &m_impl->m_actions[0];
+}
+
+const double *RVNGPath::getCoordinates() const
+{
+	return m_impl->m_coordinates.empty() ? 0 : &m_impl->m_coordinates[0];
+}
+
+const RVNGPropertyListVector &RVNGPath::getPropListVector() const
+{
+	if (!m_impl->m_vector)
+		m_impl->buildVector();
+	return *m_impl->m_vector;
+}
+
+unsigned RVNGPath::coordinateCount(unsigned char action)
+{
+	switch (action)
+	{
+	case MOVE_TO:
+	case LINE_TO:
+		return 2;
+	case CURVE_TO:
+		return 6;
+	case QUAD_TO:
+		return 4;
+	case ARC_TO:
+		return 7;
+	default:
+		return 0;
+	}
+}
+
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
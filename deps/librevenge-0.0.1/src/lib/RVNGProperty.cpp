@@ -21,11 +21,14 @@
 #include <ctype.h>
 #include <locale.h>
 
+#include <new>
 #include <sstream>
 #include <string>
 
 #include <librevenge/librevenge.h>
 
+#include "librevenge_internal.h"
+
 namespace librevenge
 {
 
@@ -103,6 +106,10 @@ public:
 	}
 	virtual RVNGString getStr() const;
 	virtual RVNGProperty *clone() const;
+	const RVNGBinaryData &getData() const
+	{
+		return m_data;
+	}
 
 private:
 	RVNGBinaryData m_data;
@@ -454,6 +461,47 @@ RVNGProperty *RVNGPropertyFactory::newTwipProp(const double val)
 	return new RVNGTwipProperty(val);
 }
 
+// the properties constructed in place must fit in the storage
+typedef char IntPropertyFits[sizeof(RVNGBoolProperty) <= sizeof(RVNGPropertyStorage) ? 1 : -1];
+typedef char DoublePropertyFits[sizeof(RVNGTwipProperty) <= sizeof(RVNGPropertyStorage) ? 1 : -1];
+
+RVNGProperty *newIntPropAt(RVNGPropertyStorage &storage, const int val)
+{
+	return new(storage.m_data) RVNGIntProperty(val);
+}
+
+RVNGProperty *newBoolPropAt(RVNGPropertyStorage &storage, const bool val)
+{
+	return new(storage.m_data) RVNGBoolProperty(val);
+}
+
+RVNGProperty *newDoublePropAt(RVNGPropertyStorage &storage, const double val, const RVNGUnit unit)
+{
+	switch (unit)
+	{
+	case RVNG_INCH:
+		return new(storage.m_data) RVNGInchProperty(val);
+	case RVNG_PERCENT:
+		return new(storage.m_data) RVNGPercentProperty(val);
+	case RVNG_POINT:
+		return new(storage.m_data) RVNGPointProperty(val);
+	case RVNG_TWIP:
+		return new(storage.m_data) RVNGTwipProperty(val);
+	case RVNG_GENERIC:
+		return new(storage.m_data) RVNGDoubleProperty(val);
+	default:
+		return 0;
+	}
+}
+
+const RVNGBinaryData *RVNGPropertyFactory::getBinaryData(const RVNGProperty *prop)
+{
+	const RVNGBinaryDataProperty *binaryProp = dynamic_cast<const RVNGBinaryDataProperty *>(prop);
+	if (!binaryProp)
+		return 0;
+	return &binaryProp->getData();
+}
+
 }
 
 /* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
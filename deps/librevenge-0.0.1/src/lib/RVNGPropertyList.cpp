@@ -19,12 +19,15 @@
  * applicable instead of those above.
  */
 
-#include <map>
-#include <string>
+#include <algorithm>
+#include <cstring>
+#include <new>
 #include <utility>
 #include <boost/spirit/include/classic.hpp>
 #include <librevenge/librevenge.h>
 
+#include "librevenge_internal.h"
+
 namespace
 {
 
@@ -103,130 +106,443 @@ bool findBool(const librevenge::RVNGString &str, bool &res)
 	             space_p).full;
 }
 
+/* Keys and values of the properties sent by the import libraries, sorted.
+ * The lists point to these rather than copy them. */
+const char *const knownStrings[] =
+{
+	"A", "C", "L", "M", "Q", "Z", "axial", "bold", "bottom", "butt",
+	"capitalize", "center", "dash", "double", "draw:angle",
+	"draw:border", "draw:distance", "draw:dots1", "draw:dots1-length",
+	"draw:dots2", "draw:dots2-length", "draw:end-color", "draw:fill",
+	"draw:fill-color", "draw:marker-end-path", "draw:marker-end-viewbox",
+	"draw:marker-end-width", "draw:marker-start-path",
+	"draw:marker-start-viewbox", "draw:marker-start-width",
+	"draw:mirror-horizontal", "draw:mirror-vertical", "draw:name",
+	"draw:opacity", "draw:shadow", "draw:shadow-color",
+	"draw:shadow-offset-x", "draw:shadow-offset-y",
+	"draw:shadow-opacity", "draw:start-color", "draw:stroke",
+	"draw:style", "draw:textarea-vertical-align", "end", "evenodd",
+	"fo:background-color", "fo:background-opacity", "fo:color",
+	"fo:font-size", "fo:font-style", "fo:font-variant", "fo:font-weight",
+	"fo:line-height", "fo:margin-bottom", "fo:margin-left",
+	"fo:margin-right", "fo:margin-top", "fo:padding-bottom",
+	"fo:padding-left", "fo:padding-right", "fo:padding-top",
+	"fo:text-align", "fo:text-indent", "fo:text-transform", "full",
+	"gradient", "image/bmp", "image/emf", "image/gif", "image/jpeg",
+	"image/png", "image/tiff", "image/wmf", "italic", "justify", "left",
+	"librevenge:end-opacity", "librevenge:large-arc",
+	"librevenge:mime-type", "librevenge:path-action",
+	"librevenge:rotate", "librevenge:start-opacity", "librevenge:sweep",
+	"linear", "middle", "miter", "none", "object/ole",
+	"office:binary-data", "radial", "rectangular", "round", "single",
+	"small-caps", "solid", "square", "style:font-name",
+	"style:text-line-through-type", "style:text-position",
+	"style:text-underline-type", "sub", "super", "svg:cx", "svg:cy",
+	"svg:d", "svg:fill-opacity", "svg:fill-rule", "svg:height", "svg:rx",
+	"svg:ry", "svg:stroke-color", "svg:stroke-linecap",
+	"svg:stroke-linejoin", "svg:stroke-opacity", "svg:stroke-width",
+	"svg:width", "svg:x", "svg:x1", "svg:x2", "svg:y", "svg:y1",
+	"svg:y2", "top", "uppercase", "visible"
+};
+
+bool lessString(const char *a, const char *b)
+{
+	return std::strcmp(a, b) < 0;
+}
+
+const char *findKnownString(const char *str)
+{
+	const char *const *end = knownStrings + RVNG_NUM_ELEMENTS(knownStrings);
+	const char *const *i = std::lower_bound(knownStrings, end, str, lessString);
+	if (i != end && !std::strcmp(*i, str))
+		return *i;
+	return 0;
+}
+
 } // anonymous namespace
 
 namespace librevenge
 {
 
-class RVNGPropertyListElement
+/* A string property whose value is one of the known strings, which is
+ * constructed in the storage of a list element rather than allocated. */
+class RVNGKnownStringProperty : public RVNGProperty
 {
 public:
-	RVNGPropertyListElement() : m_prop(0), m_vec(0) {}
-	RVNGPropertyListElement(const RVNGPropertyListElement &elem)
-		: m_prop(elem.m_prop ? elem.m_prop->clone() : 0),
-		  m_vec(elem.m_vec ? static_cast<RVNGPropertyListVector *>(elem.m_vec->clone()) : 0) {}
-	/*
-	 * Caution, following constructor does not allocate memory but takes as
-	 * arguments pre-allocated memory that this class takes ownership of.
-	 * Deallocating this memory outside this class can result in double free.
-	 */
-	RVNGPropertyListElement(RVNGProperty *prop, RVNGPropertyListVector *vec)
-		: m_prop(prop), m_vec(vec) {}
-	~RVNGPropertyListElement()
+	explicit RVNGKnownStringProperty(const char *str) : m_str(str) {}
+	~RVNGKnownStringProperty() {}
+	virtual int getInt() const
+	{
+		return 0;
+	}
+	virtual double getDouble() const
+	{
+		return 0;
+	}
+	virtual RVNGUnit getUnit() const
+	{
+		return RVNG_UNIT_ERROR;
+	}
+	virtual RVNGString getStr() const
+	{
+		return RVNGString(m_str);
+	}
+	virtual RVNGProperty *clone() const
 	{
-		delete m_prop;
-		delete m_vec;
+		return RVNGPropertyFactory::newStringProp(m_str);
 	}
-	RVNGPropertyListElement &operator=(const RVNGPropertyListElement &elem)
+	const char *getKnownStr() const
 	{
-		m_prop = elem.m_prop ? elem.m_prop->clone() : 0;
-		m_vec = elem.m_vec ? static_cast<RVNGPropertyListVector *>(elem.m_vec->clone()) : 0;
-		return *this;
+		return m_str;
 	}
+
+private:
+	const char *m_str;
+};
+
+typedef char KnownStringPropertyFits[sizeof(RVNGKnownStringProperty) <= sizeof(RVNGPropertyStorage) ? 1 : -1];
+
+/* A property of a list. The key points either to one of the known strings
+ * or to a copy owned by the element. The int, bool, double and known string
+ * values are constructed in m_storage, the others are allocated. The
+ * elements live in raw memory and are relocated with moveElement, which
+ * does not clone the allocated values. */
+struct RVNGPropertyListElement
+{
+	enum Type
+	{
+		ALLOCATED,
+		VECTOR,
+		PATH,
+		INT,
+		BOOL,
+		DOUBLE,
+		KNOWN_STRING
+	};
+
+	const char *m_key;
 	RVNGProperty *m_prop;
-	RVNGPropertyListVector *m_vec;
+	unsigned char m_type;
+	bool m_ownKey;
+	RVNGPropertyStorage m_storage;
 };
 
+namespace
+{
+
+bool isAllocated(const RVNGPropertyListElement &elem)
+{
+	return elem.m_type == RVNGPropertyListElement::ALLOCATED || elem.m_type == RVNGPropertyListElement::VECTOR
+	       || elem.m_type == RVNGPropertyListElement::PATH;
+}
+
+//! the vector of property lists of a VECTOR or PATH element, 0 otherwise
+const RVNGPropertyListVector *getChild(const RVNGPropertyListElement &elem)
+{
+	if (elem.m_type == RVNGPropertyListElement::VECTOR)
+		return static_cast<const RVNGPropertyListVector *>(elem.m_prop);
+	if (elem.m_type == RVNGPropertyListElement::PATH)
+		return &static_cast<const RVNGPath *>(elem.m_prop)->getPropListVector();
+	return 0;
+}
+
+void setKey(RVNGPropertyListElement &elem, const char *name)
+{
+	elem.m_key = findKnownString(name);
+	elem.m_ownKey = !elem.m_key;
+	if (elem.m_ownKey)
+	{
+		char *key = new char[std::strlen(name) + 1];
+		std::strcpy(key, name);
+		elem.m_key = key;
+	}
+}
+
+void copyKey(RVNGPropertyListElement &elem, const RVNGPropertyListElement &other)
+{
+	if (other.m_ownKey)
+		setKey(elem, other.m_key);
+	else
+	{
+		elem.m_key = other.m_key;
+		elem.m_ownKey = false;
+	}
+}
+
+void destroyKey(RVNGPropertyListElement &elem)
+{
+	if (elem.m_ownKey)
+		delete [] elem.m_key;
+}
+
+void copyInlineValue(RVNGPropertyListElement &elem, const RVNGPropertyListElement &other)
+{
+	const RVNGProperty *prop = other.m_prop;
+	switch (other.m_type)
+	{
+	case RVNGPropertyListElement::INT:
+		elem.m_prop = newIntPropAt(elem.m_storage, prop->getInt());
+		break;
+	case RVNGPropertyListElement::BOOL:
+		elem.m_prop = newBoolPropAt(elem.m_storage, prop->getInt() != 0);
+		break;
+	case RVNGPropertyListElement::DOUBLE:
+		elem.m_prop = newDoublePropAt(elem.m_storage, prop->getDouble(), prop->getUnit());
+		break;
+	default:
+		elem.m_prop = new(elem.m_storage.m_data) RVNGKnownStringProperty(static_cast<const RVNGKnownStringProperty *>(prop)->getKnownStr());
+		break;
+	}
+	elem.m_type = other.m_type;
+}
+
+void copyValue(RVNGPropertyListElement &elem, const RVNGPropertyListElement &other)
+{
+	if (isAllocated(other))
+	{
+		elem.m_prop = other.m_prop->clone();
+		elem.m_type = other.m_type;
+	}
+	else
+		copyInlineValue(elem, other);
+}
+
+void destroyValue(RVNGPropertyListElement &elem)
+{
+	if (isAllocated(elem))
+		delete elem.m_prop;
+	else
+		elem.m_prop->~RVNGProperty();
+}
+
+void moveElement(RVNGPropertyListElement &elem, RVNGPropertyListElement &other)
+{
+	elem.m_key = other.m_key;
+	elem.m_ownKey = other.m_ownKey;
+	if (isAllocated(other))
+	{
+		elem.m_prop = other.m_prop;
+		elem.m_type = other.m_type;
+	}
+	else
+	{
+		copyInlineValue(elem, other);
+		other.m_prop->~RVNGProperty();
+	}
+}
+
+RVNGPropertyListElement *allocateElements(unsigned count)
+{
+	return static_cast<RVNGPropertyListElement *>(::operator new(count * sizeof(RVNGPropertyListElement)));
+}
+
+} // anonymous namespace
+
+/* The properties are kept in an array sorted by key, rather than in a map:
+ * a list holds a handful of them, often numbers, so that most lists cost
+ * two allocations, however many properties they have. */
 class RVNGPropertyListImpl
 {
 public:
-	RVNGPropertyListImpl() : m_map() {}
-	RVNGPropertyListImpl(const RVNGPropertyListImpl &plist) : m_map(plist.m_map) {}
-	~RVNGPropertyListImpl() {}
-	RVNGPropertyListImpl &operator=(const RVNGPropertyListImpl &plist);
+	RVNGPropertyListImpl() : m_elements(0), m_size(0), m_capacity(0) {}
+	RVNGPropertyListImpl(const RVNGPropertyListImpl &plist);
+	~RVNGPropertyListImpl();
 	void insert(const char *name, RVNGProperty *prop);
 	void insert(const char *name, RVNGPropertyListVector *vec);
+	void insert(const char *name, RVNGPath *path);
+	void insertInt(const char *name, const int val);
+	void insertBool(const char *name, const bool val);
+	void insertDouble(const char *name, const double val, const RVNGUnit unit);
+	void insertKnownString(const char *name, const char *str);
 	const RVNGProperty *operator[](const char *name) const;
 	const RVNGPropertyListVector *child(const char *name) const;
+	const RVNGPath *path(const char *name) const;
 	void remove(const char *name);
 	void clear();
 	bool empty() const;
 
-	mutable std::map<std::string, RVNGPropertyListElement> m_map;
+	RVNGPropertyListElement *m_elements;
+	unsigned m_size;
+	unsigned m_capacity;
+
+private:
+	// not implemented
+	RVNGPropertyListImpl &operator=(const RVNGPropertyListImpl &plist);
+
+	unsigned lowerBound(const char *name) const;
+	const RVNGPropertyListElement *find(const char *name) const;
+	/* the element of name, inserted if needed; its previous value is
+	 * destroyed, the caller constructs the new one */
+	RVNGPropertyListElement &element(const char *name);
 };
 
-RVNGPropertyListImpl &RVNGPropertyListImpl::operator=(const RVNGPropertyListImpl &plist)
+RVNGPropertyListImpl::RVNGPropertyListImpl(const RVNGPropertyListImpl &plist) :
+	m_elements(plist.m_size ? allocateElements(plist.m_size) : 0),
+	m_size(0),
+	m_capacity(plist.m_size)
 {
-	m_map = plist.m_map;
-	return *this;
+	for (; m_size < plist.m_size; ++m_size)
+	{
+		copyKey(m_elements[m_size], plist.m_elements[m_size]);
+		copyValue(m_elements[m_size], plist.m_elements[m_size]);
+	}
 }
 
-const RVNGProperty *RVNGPropertyListImpl::operator[](const char *name) const
+RVNGPropertyListImpl::~RVNGPropertyListImpl()
 {
-	std::map<std::string, RVNGPropertyListElement>::iterator i = m_map.find(name);
-	if (i != m_map.end())
-		return i->second.m_prop;
-	return 0;
+	clear();
+	::operator delete(m_elements);
 }
 
-const RVNGPropertyListVector *RVNGPropertyListImpl::child(const char *name) const
+unsigned RVNGPropertyListImpl::lowerBound(const char *name) const
 {
-	std::map<std::string, RVNGPropertyListElement>::iterator i = m_map.find(name);
-	if (i != m_map.end())
+	unsigned first = 0;
+	unsigned count = m_size;
+	while (count > 0)
 	{
-		return i->second.m_vec;
+		const unsigned step = count / 2;
+		if (std::strcmp(m_elements[first + step].m_key, name) < 0)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+			count = step;
 	}
+	return first;
+}
 
+const RVNGPropertyListElement *RVNGPropertyListImpl::find(const char *name) const
+{
+	const unsigned i = lowerBound(name);
+	if (i < m_size && !std::strcmp(m_elements[i].m_key, name))
+		return &m_elements[i];
 	return 0;
 }
 
-void RVNGPropertyListImpl::insert(const char *name, RVNGProperty *prop)
+RVNGPropertyListElement &RVNGPropertyListImpl::element(const char *name)
 {
-	std::map<std::string, RVNGPropertyListElement>::iterator i = m_map.lower_bound(name);
-	if (i != m_map.end() && !(m_map.key_comp()(name, i->first)))
+	const unsigned i = lowerBound(name);
+	if (i < m_size && !std::strcmp(m_elements[i].m_key, name))
 	{
-		delete i->second.m_vec;
-		i->second.m_vec = 0;
-		RVNGProperty *tmpProp = i->second.m_prop;
-		i->second.m_prop = prop;
-		delete tmpProp;
-		return;
+		destroyValue(m_elements[i]);
+		return m_elements[i];
 	}
-	m_map.insert(i, std::map<std::string, RVNGPropertyListElement>::value_type(name, RVNGPropertyListElement(prop, 0)));
+	if (m_size == m_capacity)
+	{
+		const unsigned capacity = m_capacity ? 2 * m_capacity : 4;
+		RVNGPropertyListElement *elements = allocateElements(capacity);
+		for (unsigned j = 0; j < m_size; ++j)
+			moveElement(elements[j], m_elements[j]);
+		::operator delete(m_elements);
+		m_elements = elements;
+		m_capacity = capacity;
+	}
+	for (unsigned j = m_size; j > i; --j)
+		moveElement(m_elements[j], m_elements[j - 1]);
+	setKey(m_elements[i], name);
+	++m_size;
+	return m_elements[i];
+}
+
+const RVNGProperty *RVNGPropertyListImpl::operator[](const char *name) const
+{
+	const RVNGPropertyListElement *elem = find(name);
+	if (elem && !getChild(*elem))
+		return elem->m_prop;
+	return 0;
+}
+
+const RVNGPropertyListVector *RVNGPropertyListImpl::child(const char *name) const
+{
+	const RVNGPropertyListElement *elem = find(name);
+	if (elem)
+		return getChild(*elem);
+	return 0;
+}
+
+const RVNGPath *RVNGPropertyListImpl::path(const char *name) const
+{
+	const RVNGPropertyListElement *elem = find(name);
+	if (elem && elem->m_type == RVNGPropertyListElement::PATH)
+		return static_cast<const RVNGPath *>(elem->m_prop);
+	return 0;
+}
+
+void RVNGPropertyListImpl::insert(const char *name, RVNGProperty *prop)
+{
+	RVNGPropertyListElement &elem = element(name);
+	elem.m_prop = prop;
+	elem.m_type = RVNGPropertyListElement::ALLOCATED;
 }
 
 void RVNGPropertyListImpl::insert(const char *name, RVNGPropertyListVector *vec)
 {
-	std::map<std::string, RVNGPropertyListElement>::iterator i = m_map.lower_bound(name);
-	if (i != m_map.end() && !(m_map.key_comp()(name, i->first)))
-	{
-		delete i->second.m_prop;
-		i->second.m_prop = 0;
-		RVNGPropertyListVector *tmpProp = i->second.m_vec;
-		i->second.m_vec = vec;
-		delete tmpProp;
-		return;
-	}
-	m_map.insert(i, std::map<std::string, RVNGPropertyListElement>::value_type(name, RVNGPropertyListElement(0, vec)));
+	RVNGPropertyListElement &elem = element(name);
+	elem.m_prop = vec;
+	elem.m_type = RVNGPropertyListElement::VECTOR;
+}
+
+void RVNGPropertyListImpl::insert(const char *name, RVNGPath *path)
+{
+	RVNGPropertyListElement &elem = element(name);
+	elem.m_prop = path;
+	elem.m_type = RVNGPropertyListElement::PATH;
+}
+
+void RVNGPropertyListImpl::insertInt(const char *name, const int val)
+{
+	RVNGPropertyListElement &elem = element(name);
+	elem.m_prop = newIntPropAt(elem.m_storage, val);
+	elem.m_type = RVNGPropertyListElement::INT;
+}
+
+void RVNGPropertyListImpl::insertBool(const char *name, const bool val)
+{
+	RVNGPropertyListElement &elem = element(name);
+	elem.m_prop = newBoolPropAt(elem.m_storage, val);
+	elem.m_type = RVNGPropertyListElement::BOOL;
+}
+
+void RVNGPropertyListImpl::insertDouble(const char *name, const double val, const RVNGUnit unit)
+{
+	RVNGPropertyListElement &elem = element(name);
+	elem.m_prop = newDoublePropAt(elem.m_storage, val, unit);
+	elem.m_type = RVNGPropertyListElement::DOUBLE;
+}
+
+void RVNGPropertyListImpl::insertKnownString(const char *name, const char *str)
+{
+	RVNGPropertyListElement &elem = element(name);
+	elem.m_prop = new(elem.m_storage.m_data) RVNGKnownStringProperty(str);
+	elem.m_type = RVNGPropertyListElement::KNOWN_STRING;
 }
 
 void RVNGPropertyListImpl::remove(const char *name)
 {
-	std::map<std::string, RVNGPropertyListElement>::iterator i = m_map.find(name);
-	if (i != m_map.end())
-	{
-		m_map.erase(i);
-	}
+	const unsigned i = lowerBound(name);
+	if (i >= m_size || std::strcmp(m_elements[i].m_key, name))
+		return;
+	destroyValue(m_elements[i]);
+	destroyKey(m_elements[i]);
+	--m_size;
+	for (unsigned j = i; j < m_size; ++j)
+		moveElement(m_elements[j], m_elements[j + 1]);
 }
 
 void RVNGPropertyListImpl::clear()
 {
-	m_map.clear();
+	for (unsigned i = 0; i < m_size; ++i)
+	{
+		destroyValue(m_elements[i]);
+		destroyKey(m_elements[i]);
+	}
+	m_size = 0;
 }
 
 bool RVNGPropertyListImpl::empty() const
 {
-	return m_map.empty();
+	return !m_size;
 }
 
 RVNGPropertyList::RVNGPropertyList() :
@@ -251,12 +567,12 @@ void RVNGPropertyList::insert(const char *name, RVNGProperty *prop)
 
 void RVNGPropertyList::insert(const char *name, const int val)
 {
-	m_impl->insert(name, RVNGPropertyFactory::newIntProp(val));
+	m_impl->insertInt(name, val);
 }
 
 void RVNGPropertyList::insert(const char *name, const bool val)
 {
-	m_impl->insert(name, RVNGPropertyFactory::newBoolProp(val));
+	m_impl->insertBool(name, val);
 }
 
 void RVNGPropertyList::insert(const char *name, const char *val)
@@ -285,7 +601,11 @@ void RVNGPropertyList::insert(const char *name, const RVNGString &val)
 		insert(name, valBool);
 		return;
 	}
-	m_impl->insert(name, RVNGPropertyFactory::newStringProp(val));
+	const char *known = findKnownString(val.cstr());
+	if (known)
+		m_impl->insertKnownString(name, known);
+	else
+		m_impl->insert(name, RVNGPropertyFactory::newStringProp(val));
 }
 
 void RVNGPropertyList::insert(const char *name, const unsigned char *buffer, const unsigned long bufferSize)
@@ -300,16 +620,8 @@ void RVNGPropertyList::insert(const char *name, const RVNGBinaryData &data)
 
 void RVNGPropertyList::insert(const char *name, const double val, const RVNGUnit units)
 {
-	if (units == RVNG_INCH)
-		m_impl->insert(name, RVNGPropertyFactory::newInchProp(val));
-	else if (units == RVNG_PERCENT)
-		m_impl->insert(name, RVNGPropertyFactory::newPercentProp(val));
-	else if (units == RVNG_POINT)
-		m_impl->insert(name, RVNGPropertyFactory::newPointProp(val));
-	else if (units == RVNG_TWIP)
-		m_impl->insert(name, RVNGPropertyFactory::newTwipProp(val));
-	else if (units == RVNG_GENERIC)
-		m_impl->insert(name, RVNGPropertyFactory::newDoubleProp(val));
+	if (units == RVNG_INCH || units == RVNG_PERCENT || units == RVNG_POINT || units == RVNG_TWIP || units == RVNG_GENERIC)
+		m_impl->insertDouble(name, val, units);
 }
 
 void RVNGPropertyList::insert(const char *name, const RVNGPropertyListVector &vec)
@@ -317,6 +629,11 @@ void RVNGPropertyList::insert(const char *name, const RVNGPropertyListVector &ve
 	m_impl->insert(name, static_cast<RVNGPropertyListVector *>(vec.clone()));
 }
 
+void RVNGPropertyList::insert(const char *name, const RVNGPath &path)
+{
+	m_impl->insert(name, new RVNGPath(path));
+}
+
 void RVNGPropertyList::remove(const char *name)
 {
 	m_impl->remove(name);
@@ -339,6 +656,11 @@ const RVNGPropertyListVector *RVNGPropertyList::child(const char *name) const
 	return m_impl->child(name);
 }
 
+const RVNGPath *RVNGPropertyList::path(const char *name) const
+{
+	return m_impl->path(name);
+}
+
 void RVNGPropertyList::clear()
 {
 	m_impl->clear();
@@ -401,15 +723,15 @@ private:
 
 private:
 	bool m_imaginaryFirst;
-	std::map<std::string, RVNGPropertyListElement>::iterator m_iter;
-	std::map<std::string, RVNGPropertyListElement> *m_map;
+	unsigned m_index;
+	const RVNGPropertyListImpl *m_impl;
 };
 
 
 RVNGPropertyListIterImpl::RVNGPropertyListIterImpl(const RVNGPropertyListImpl *impl) :
 	m_imaginaryFirst(false),
-	m_iter(impl->m_map.begin()),
-	m_map(&impl->m_map)
+	m_index(0),
+	m_impl(impl)
 {
 }
 
@@ -417,14 +739,14 @@ void RVNGPropertyListIterImpl::rewind()
 {
 	// rewind to an imaginary element that preceeds the first one
 	m_imaginaryFirst = true;
-	m_iter = m_map->begin();
+	m_index = 0;
 }
 
 bool RVNGPropertyListIterImpl::next()
 {
-	if (!m_imaginaryFirst)
-		++m_iter;
-	if (m_iter==m_map->end())
+	if (!m_imaginaryFirst && m_index < m_impl->m_size)
+		++m_index;
+	if (m_index >= m_impl->m_size)
 		return false;
 	m_imaginaryFirst = false;
 
@@ -433,7 +755,7 @@ bool RVNGPropertyListIterImpl::next()
 
 bool RVNGPropertyListIterImpl::last()
 {
-	if (m_iter == m_map->end())
+	if (m_index >= m_impl->m_size)
 		return true;
 
 	return false;
@@ -441,23 +763,20 @@ bool RVNGPropertyListIterImpl::last()
 
 const RVNGProperty *RVNGPropertyListIterImpl::operator()() const
 {
-	if (m_iter->second.m_prop)
-		return m_iter->second.m_prop;
-	if (m_iter->second.m_vec)
-		return m_iter->second.m_vec;
-	return 0;
+	const RVNGPropertyListElement &elem = m_impl->m_elements[m_index];
+	if (elem.m_type == RVNGPropertyListElement::PATH)
+		return getChild(elem);
+	return elem.m_prop;
 }
 
 const RVNGPropertyListVector *RVNGPropertyListIterImpl::child() const
 {
-	if (m_iter->second.m_vec)
-		return m_iter->second.m_vec;
-	return 0;
+	return getChild(m_impl->m_elements[m_index]);
 }
 
 const char *RVNGPropertyListIterImpl::key() const
 {
-	return m_iter->first.c_str();
+	return m_impl->m_elements[m_index].m_key;
 }
 
 RVNGPropertyList::Iter::Iter(const RVNGPropertyList &propList) :
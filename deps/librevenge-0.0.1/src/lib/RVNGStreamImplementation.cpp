@@ -26,6 +26,11 @@
 #include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include <librevenge-stream/librevenge-stream.h>
 #include "RVNGOLEStream.h"
@@ -52,6 +57,9 @@ public:
 	unsigned long readBufferPos;
 	RVNGStreamType streamType;
 	std::vector<std::string> streamNameList;
+	// the OLE2 directory and allocation tables, read once
+	Storage *oleStorage;
+	RVNGZipDirectory zipDirectory;
 private:
 	RVNGFileStreamPrivate(const RVNGFileStreamPrivate &);
 	RVNGFileStreamPrivate &operator=(const RVNGFileStreamPrivate &);
@@ -66,11 +74,36 @@ public:
 	volatile long offset;
 	RVNGStreamType streamType;
 	std::vector<std::string> streamNameList;
+	// the OLE2 directory and allocation tables, read once
+	Storage *oleStorage;
+	RVNGZipDirectory zipDirectory;
 private:
 	RVNGStringStreamPrivate(const RVNGStringStreamPrivate &);
 	RVNGStringStreamPrivate &operator=(const RVNGStringStreamPrivate &);
 };
 
+class RVNGMMapStreamPrivate
+{
+public:
+	RVNGMMapStreamPrivate();
+	~RVNGMMapStreamPrivate();
+	bool open(const char *filename);
+	const unsigned char *data;
+	unsigned long size;
+	long offset;
+	bool mapped;
+	// used when the file cannot be mapped
+	std::vector<unsigned char> buffer;
+	RVNGStreamType streamType;
+	std::vector<std::string> streamNameList;
+	// the OLE2 directory and allocation tables, read once
+	Storage *oleStorage;
+	RVNGZipDirectory zipDirectory;
+private:
+	RVNGMMapStreamPrivate(const RVNGMMapStreamPrivate &);
+	RVNGMMapStreamPrivate &operator=(const RVNGMMapStreamPrivate &);
+};
+
 RVNGFileStreamPrivate::RVNGFileStreamPrivate() :
 	file(0),
 	streamSize(0),
@@ -78,12 +111,15 @@ RVNGFileStreamPrivate::RVNGFileStreamPrivate() :
 	readBufferLength(0),
 	readBufferPos(0),
 	streamType(UNKNOWN),
-	streamNameList()
+	streamNameList(),
+	oleStorage(0),
+	zipDirectory()
 {
 }
 
 RVNGFileStreamPrivate::~RVNGFileStreamPrivate()
 {
+	delete oleStorage;
 	if (file)
 		fclose(file);
 	if (readBuffer)
@@ -94,7 +130,9 @@ RVNGStringStreamPrivate::RVNGStringStreamPrivate(const unsigned char *data, unsi
 	buffer(dataSize),
 	offset(0),
 	streamType(UNKNOWN),
-	streamNameList()
+	streamNameList(),
+	oleStorage(0),
+	zipDirectory()
 
 {
 	memcpy(&buffer[0], data, dataSize);
@@ -102,6 +140,7 @@ RVNGStringStreamPrivate::RVNGStringStreamPrivate(const unsigned char *data, unsi
 
 RVNGStringStreamPrivate::~RVNGStringStreamPrivate()
 {
+	delete oleStorage;
 }
 
 RVNGFileStream::RVNGFileStream(const char *filename) :
@@ -278,19 +317,21 @@ bool RVNGFileStream::isStructured()
 		seek(0, RVNG_SEEK_SET);
 
 		// Check whether it is OLE2 storage
-		Storage tmpStorage(this);
-		if (tmpStorage.isStructured())
+		d->oleStorage = new Storage(this);
+		if (d->oleStorage->isStructured())
 		{
 			d->streamType = OLE2;
-			d->streamNameList = tmpStorage.getSubStreamNamesList();
+			d->streamNameList = d->oleStorage->getSubStreamNamesList();
 			seek(0, RVNG_SEEK_SET);
 			return true;
 		}
+		delete d->oleStorage;
+		d->oleStorage = 0;
 		seek(0, RVNG_SEEK_SET);
-		if (RVNGZipStream::isZipFile(this))
+		if (d->zipDirectory.read(this))
 		{
 			d->streamType = ZIP;
-			d->streamNameList = RVNGZipStream::getSubStreamNamesList(this);
+			d->streamNameList = d->zipDirectory.getSubStreamNamesList();
 			seek(0, RVNG_SEEK_SET);
 			return true;
 		}
@@ -349,10 +390,8 @@ RVNGInputStream *RVNGFileStream::getSubStreamByName(const char *name)
 		return 0;
 	if (d->streamType == OLE2)
 	{
-		seek(0, RVNG_SEEK_SET);
-		Storage tmpStorage(this);
-		Stream tmpStream(&tmpStorage, name);
-		if (tmpStorage.result() != Storage::Ok  || !tmpStream.size())
+		Stream tmpStream(d->oleStorage, name);
+		if (d->oleStorage->result() != Storage::Ok  || !tmpStream.size())
 			return (RVNGInputStream *)0;
 
 		std::vector<unsigned char> buf(tmpStream.size());
@@ -370,7 +409,7 @@ RVNGInputStream *RVNGFileStream::getSubStreamByName(const char *name)
 	else if (d->streamType == ZIP)
 	{
 		seek(0, RVNG_SEEK_SET);
-		return RVNGZipStream::getSubstream(this, name);
+		return d->zipDirectory.getSubstream(this, name);
 	}
 	return 0;
 }
@@ -458,18 +497,20 @@ bool RVNGStringStream::isStructured()
 		seek(0, RVNG_SEEK_SET);
 
 		// Check whether it is OLE2 storage
-		Storage tmpStorage(this);
-		if (tmpStorage.isStructured())
+		d->oleStorage = new Storage(this);
+		if (d->oleStorage->isStructured())
 		{
 			d->streamType = OLE2;
-			d->streamNameList = tmpStorage.getSubStreamNamesList();
+			d->streamNameList = d->oleStorage->getSubStreamNamesList();
 			return true;
 		}
+		delete d->oleStorage;
+		d->oleStorage = 0;
 		seek(0, RVNG_SEEK_SET);
-		if (RVNGZipStream::isZipFile(this))
+		if (d->zipDirectory.read(this))
 		{
 			d->streamType = ZIP;
-			d->streamNameList = RVNGZipStream::getSubStreamNamesList(this);
+			d->streamNameList = d->zipDirectory.getSubStreamNamesList();
 			return true;
 		}
 		d->streamType = FLAT;
@@ -526,10 +567,246 @@ RVNGInputStream *RVNGStringStream::getSubStreamByName(const char *name)
 
 	if (d->streamType == OLE2)
 	{
+		Stream tmpStream(d->oleStorage, name);
+		if (d->oleStorage->result() != Storage::Ok  || !tmpStream.size())
+			return (RVNGInputStream *)0;
+
+		std::vector<unsigned char> buf(tmpStream.size());
+		unsigned long tmpLength;
+		tmpLength = tmpStream.read(&buf[0], tmpStream.size());
+
+		// sanity check
+		if (tmpLength != tmpStream.size())
+			/* something went wrong here and we do not trust the
+			   resulting buffer */
+			return (RVNGInputStream *)0;
+
+		return new RVNGStringStream(&buf[0], (unsigned)tmpLength);
+	}
+	else if (d->streamType == ZIP)
+		return d->zipDirectory.getSubstream(this, name);
+	return 0;
+}
+
+
+RVNGMMapStreamPrivate::RVNGMMapStreamPrivate() :
+	data(0),
+	size(0),
+	offset(0),
+	mapped(false),
+	buffer(),
+	streamType(UNKNOWN),
+	streamNameList(),
+	oleStorage(0),
+	zipDirectory()
+{
+}
+
+RVNGMMapStreamPrivate::~RVNGMMapStreamPrivate()
+{
+	delete oleStorage;
+#ifndef _WIN32
+	if (mapped)
+		munmap(const_cast<unsigned char *>(data), size);
+#endif
+}
+
+bool RVNGMMapStreamPrivate::open(const char *filename)
+{
+	struct stat status;
+	if (!filename || stat(filename, &status) != 0 || !S_ISREG(status.st_mode))
+		return false;
+	// preventing possible unsigned/signed issues later by truncating the file
+	unsigned long fileSize = (unsigned long) status.st_size;
+	if (fileSize > (unsigned long)(std::numeric_limits<long>::max)())
+		fileSize = (unsigned long)(std::numeric_limits<long>::max)();
+
+#ifndef _WIN32
+	int fd = ::open(filename, O_RDONLY);
+	if (fd < 0)
+		return false;
+	if (fileSize == 0)
+	{
+		// empty files cannot be mapped
+		close(fd);
+		return true;
+	}
+	void *mapping = mmap(0, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapping != MAP_FAILED)
+	{
+		data = static_cast<const unsigned char *>(mapping);
+		size = fileSize;
+		mapped = true;
+		return true;
+	}
+#endif
+
+	// no mapping: read the whole file instead
+	FILE *file = fopen(filename, "rb");
+	if (!file)
+		return false;
+	buffer.resize(fileSize);
+	if (fileSize)
+		fileSize = (unsigned long) fread(&buffer[0], 1, fileSize, file);
+	fclose(file);
+	buffer.resize(fileSize);
+	data = buffer.empty() ? 0 : &buffer[0];
+	size = fileSize;
+	return true;
+}
+
+RVNGMMapStream::RVNGMMapStream(const char *filename) :
+	RVNGInputStream(),
+	d(new RVNGMMapStreamPrivate())
+{
+	if (!d->open(filename))
+	{
+		delete d;
+		d = 0;
+	}
+}
+
+RVNGMMapStream::~RVNGMMapStream()
+{
+	if (d)
+		delete d;
+}
+
+bool RVNGMMapStream::isOpen() const
+{
+	return d != 0;
+}
+
+const unsigned char *RVNGMMapStream::read(unsigned long numBytes, unsigned long &numBytesRead)
+{
+	numBytesRead = 0;
+
+	if (!d || numBytes == 0)
+		return 0;
+
+	unsigned long available = d->size - (unsigned long) d->offset;
+	if (numBytes > available)
+		numBytes = available;
+	if (numBytes == 0)
+		return 0;
+
+	const unsigned char *const pTmp = d->data + d->offset;
+	d->offset += (long) numBytes;
+	numBytesRead = numBytes;
+	return pTmp;
+}
+
+long RVNGMMapStream::tell()
+{
+	if (!d)
+		return -1L;
+	return d->offset;
+}
+
+int RVNGMMapStream::seek(long offset, RVNG_SEEK_TYPE seekType)
+{
+	if (!d)
+		return -1;
+	if (seekType == RVNG_SEEK_CUR)
+		offset += d->offset;
+	else if (seekType == RVNG_SEEK_END)
+		offset += (long) d->size;
+
+	if (offset < 0)
+	{
+		d->offset = 0;
+		return 1;
+	}
+	if (offset > (long) d->size)
+	{
+		d->offset = (long) d->size;
+		return 1;
+	}
+	d->offset = offset;
+	return 0;
+}
+
+bool RVNGMMapStream::isEnd()
+{
+	if (!d)
+		return true;
+	return d->offset >= (long) d->size;
+}
+
+bool RVNGMMapStream::isStructured()
+{
+	if (!d || !d->size)
+		return false;
+	if (d->streamType == UNKNOWN)
+	{
+		const long oldOffset = d->offset;
 		seek(0, RVNG_SEEK_SET);
-		Storage tmpStorage(this);
-		Stream tmpStream(&tmpStorage, name);
-		if (tmpStorage.result() != Storage::Ok  || !tmpStream.size())
+
+		// Check whether it is OLE2 storage
+		d->oleStorage = new Storage(this);
+		if (d->oleStorage->isStructured())
+		{
+			d->streamType = OLE2;
+			d->streamNameList = d->oleStorage->getSubStreamNamesList();
+		}
+		else
+		{
+			delete d->oleStorage;
+			d->oleStorage = 0;
+			seek(0, RVNG_SEEK_SET);
+			if (d->zipDirectory.read(this))
+			{
+				d->streamType = ZIP;
+				d->streamNameList = d->zipDirectory.getSubStreamNamesList();
+			}
+			else
+				d->streamType = FLAT;
+		}
+		seek(oldOffset, RVNG_SEEK_SET);
+	}
+	return d->streamType != FLAT;
+}
+
+unsigned RVNGMMapStream::subStreamCount()
+{
+	if (!isStructured())
+		return 0;
+	return (unsigned) d->streamNameList.size();
+}
+
+const char *RVNGMMapStream::subStreamName(unsigned id)
+{
+	if (!isStructured() || id >= (unsigned) d->streamNameList.size())
+		return 0;
+	return d->streamNameList[size_t(id)].c_str();
+}
+
+bool RVNGMMapStream::existsSubStream(const char *name)
+{
+	if (!name || !isStructured())
+		return false;
+	for (std::vector<std::string>::size_type i = 0; i < d->streamNameList.size(); ++i)
+	{
+		if (d->streamNameList[i] == name)
+			return true;
+	}
+	return false;
+}
+
+RVNGInputStream *RVNGMMapStream::getSubStreamById(unsigned id)
+{
+	return getSubStreamByName(subStreamName(id));
+}
+
+RVNGInputStream *RVNGMMapStream::getSubStreamByName(const char *name)
+{
+	if (!name || !isStructured())
+		return 0;
+	if (d->streamType == OLE2)
+	{
+		Stream tmpStream(d->oleStorage, name);
+		if (d->oleStorage->result() != Storage::Ok  || !tmpStream.size())
 			return (RVNGInputStream *)0;
 
 		std::vector<unsigned char> buf(tmpStream.size());
@@ -545,7 +822,10 @@ RVNGInputStream *RVNGStringStream::getSubStreamByName(const char *name)
 		return new RVNGStringStream(&buf[0], (unsigned)tmpLength);
 	}
 	else if (d->streamType == ZIP)
-		return RVNGZipStream::getSubstream(this, name);
+	{
+		seek(0, RVNG_SEEK_SET);
+		return d->zipDirectory.getSubstream(this, name);
+	}
 	return 0;
 }
 
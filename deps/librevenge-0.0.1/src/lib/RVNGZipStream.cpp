@@ -21,6 +21,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <zlib.h>
+#include <boost/unordered_map.hpp>
 #include "RVNGZipStream.h"
 #include <librevenge-stream/librevenge-stream.h>
 
@@ -341,6 +342,226 @@ static std::vector<std::string> getSubStreamNamesInZip(RVNGInputStream *input, b
 	}
 	return res;
 }
+#define INFLATE_WINDOW 65536
+
+/* Deflated entry inflated on demand: only the compressed data and a window
+ * of the inflated data are kept in memory. Reading forward is cheap,
+ * seeking backward inflates the entry again from its start. */
+class RVNGInflateStream : public RVNGInputStream
+{
+public:
+	RVNGInflateStream(const unsigned char *compressedData, unsigned long compressedSize, unsigned long size);
+	~RVNGInflateStream();
+
+	bool isValid() const
+	{
+		return m_valid;
+	}
+
+	const unsigned char *read(unsigned long numBytes, unsigned long &numBytesRead);
+	long tell();
+	int seek(long offset, RVNG_SEEK_TYPE seekType);
+	bool isEnd();
+
+	bool isStructured()
+	{
+		return false;
+	}
+	unsigned subStreamCount()
+	{
+		return 0;
+	}
+	const char *subStreamName(unsigned)
+	{
+		return 0;
+	}
+	bool existsSubStream(const char *)
+	{
+		return false;
+	}
+	RVNGInputStream *getSubStreamByName(const char *)
+	{
+		return 0;
+	}
+	RVNGInputStream *getSubStreamById(unsigned)
+	{
+		return 0;
+	}
+
+private:
+	RVNGInflateStream(const RVNGInflateStream &);
+	RVNGInflateStream &operator=(const RVNGInflateStream &);
+
+	void restart();
+	bool fill(unsigned long numBytes);
+	bool inflateMore(unsigned long numBytes);
+
+	std::vector<unsigned char> m_compressed;
+	z_stream m_strm;
+	bool m_valid;
+	// uncompressed size, reduced if the data turns out to be shorter
+	unsigned long m_size;
+	long m_offset;
+	// m_buffer[0, m_bufferLength) holds the data starting at m_bufferStart
+	std::vector<unsigned char> m_buffer;
+	unsigned long m_bufferStart;
+	unsigned long m_bufferLength;
+};
+
+RVNGInflateStream::RVNGInflateStream(const unsigned char *compressedData, unsigned long compressedSize, unsigned long size)
+	: RVNGInputStream(), m_compressed(compressedData, compressedData + compressedSize), m_strm(), m_valid(false),
+	  m_size(size), m_offset(0), m_buffer(), m_bufferStart(0), m_bufferLength(0)
+{
+	m_strm.zalloc = Z_NULL;
+	m_strm.zfree = Z_NULL;
+	m_strm.opaque = Z_NULL;
+	m_strm.avail_in = 0;
+	m_strm.next_in = Z_NULL;
+	if (inflateInit2(&m_strm,-MAX_WBITS) != Z_OK)
+		return;
+	m_valid = true;
+	restart();
+	// inflate the first window, to reject broken data straight away
+	if (m_size && !fill(1))
+	{
+		(void)inflateEnd(&m_strm);
+		m_valid = false;
+	}
+}
+
+RVNGInflateStream::~RVNGInflateStream()
+{
+	if (m_valid)
+		(void)inflateEnd(&m_strm);
+}
+
+void RVNGInflateStream::restart()
+{
+	(void)inflateReset(&m_strm);
+	m_strm.avail_in = (unsigned)m_compressed.size();
+	m_strm.next_in = m_compressed.empty() ? Z_NULL : reinterpret_cast<Bytef *>(&m_compressed[0]);
+	m_bufferStart = 0;
+	m_bufferLength = 0;
+}
+
+// makes the window hold numBytes bytes (less at the end) from m_offset
+bool RVNGInflateStream::fill(unsigned long numBytes)
+{
+	const unsigned long offset = (unsigned long) m_offset;
+	if (offset < m_bufferStart)
+		restart();
+
+	// inflate and drop the data before offset
+	while (m_bufferStart + m_bufferLength < offset)
+	{
+		m_bufferStart += m_bufferLength;
+		m_bufferLength = 0;
+		if (!inflateMore(offset - m_bufferStart < INFLATE_WINDOW ? offset - m_bufferStart : INFLATE_WINDOW))
+			return false;
+	}
+	if (offset > m_bufferStart)
+	{
+		m_bufferLength -= offset - m_bufferStart;
+		memmove(&m_buffer[0], &m_buffer[offset - m_bufferStart], m_bufferLength);
+		m_bufferStart = offset;
+	}
+
+	return inflateMore(numBytes < m_size - offset ? numBytes : m_size - offset);
+}
+
+// inflates until the window holds numBytes bytes, or the data ends
+bool RVNGInflateStream::inflateMore(unsigned long numBytes)
+{
+	if (m_buffer.size() < numBytes || m_buffer.size() < INFLATE_WINDOW)
+		m_buffer.resize(numBytes > INFLATE_WINDOW ? numBytes : INFLATE_WINDOW);
+	while (m_bufferLength < numBytes)
+	{
+		m_strm.avail_out = (unsigned)(m_buffer.size() - m_bufferLength);
+		m_strm.next_out = reinterpret_cast<Bytef *>(&m_buffer[m_bufferLength]);
+		const int ret = inflate(&m_strm, Z_NO_FLUSH);
+		m_bufferLength = m_buffer.size() - m_strm.avail_out;
+		if (ret != Z_OK && m_bufferLength < numBytes)
+		{
+			// the data is shorter than announced, or broken
+			m_size = m_bufferStart + m_bufferLength;
+			return false;
+		}
+	}
+	if (m_bufferStart + m_bufferLength > m_size)
+		m_bufferLength = m_size - m_bufferStart;
+	return true;
+}
+
+const unsigned char *RVNGInflateStream::read(unsigned long numBytes, unsigned long &numBytesRead)
+{
+	numBytesRead = 0;
+	if (!numBytes || isEnd())
+		return 0;
+	const unsigned long offset = (unsigned long) m_offset;
+	if (offset < m_bufferStart || offset + numBytes > m_bufferStart + m_bufferLength)
+	{
+		fill(numBytes);
+		if (offset >= m_size)
+			return 0;
+	}
+	numBytesRead = m_bufferStart + m_bufferLength - offset;
+	if (numBytesRead > numBytes)
+		numBytesRead = numBytes;
+	m_offset += (long) numBytesRead;
+	return &m_buffer[offset - m_bufferStart];
+}
+
+long RVNGInflateStream::tell()
+{
+	return m_offset;
+}
+
+int RVNGInflateStream::seek(long offset, RVNG_SEEK_TYPE seekType)
+{
+	if (seekType == RVNG_SEEK_CUR)
+		offset += m_offset;
+	else if (seekType == RVNG_SEEK_END)
+		offset += (long) m_size;
+
+	if (offset < 0)
+	{
+		m_offset = 0;
+		return 1;
+	}
+	if (offset > (long) m_size)
+	{
+		m_offset = (long) m_size;
+		return 1;
+	}
+	m_offset = offset;
+	return 0;
+}
+
+bool RVNGInflateStream::isEnd()
+{
+	return (unsigned long) m_offset >= m_size;
+}
+
+// reads the data of entry, input being just after its local file header
+static RVNGInputStream *readDataStream(RVNGInputStream *input, const CentralDirectoryEntry &entry)
+{
+	if (!entry.compressed_size)
+		return 0;
+	unsigned long numBytesRead = 0;
+	const unsigned char *compressedData = input->read(entry.compressed_size, numBytesRead);
+	if (numBytesRead != entry.compressed_size)
+		return 0;
+	if (!entry.compression)
+		return new RVNGStringStream(compressedData, (unsigned)numBytesRead);
+
+	RVNGInflateStream *stream = new RVNGInflateStream(compressedData, numBytesRead, entry.uncompressed_size);
+	if (!stream->isValid())
+	{
+		delete stream;
+		return 0;
+	}
+	return stream;
+}
 } // anonymous namespace
 
 bool RVNGZipStream::isZipFile(RVNGInputStream *input)
@@ -376,53 +597,91 @@ RVNGInputStream *RVNGZipStream::getSubstream(RVNGInputStream *input, const char
 	CentralDirectoryEntry entry;
 	if (!findDataStream(input, entry, name))
 		return 0;
-	if (!entry.compressed_size)
-		return 0;
-	unsigned long numBytesRead = 0;
-	unsigned char *compressedData = const_cast<unsigned char *>(input->read(entry.compressed_size, numBytesRead));
-	if (numBytesRead != entry.compressed_size)
-		return 0;
-	if (!entry.compression)
-		return new RVNGStringStream(compressedData, (unsigned)numBytesRead);
-	else
-	{
-		int ret;
-		z_stream strm;
-
-		/* allocate inflate state */
-		strm.zalloc = Z_NULL;
-		strm.zfree = Z_NULL;
-		strm.opaque = Z_NULL;
-		strm.avail_in = 0;
-		strm.next_in = Z_NULL;
-		ret = inflateInit2(&strm,-MAX_WBITS);
-		if (ret != Z_OK)
-			return 0;
+	return readDataStream(input, entry);
+}
 
-		strm.avail_in = (unsigned)numBytesRead;
-		strm.next_in = (Bytef *)compressedData;
+struct RVNGZipDirectoryImpl
+{
+	RVNGZipDirectoryImpl() : entries(), index(), names() {}
 
-		std::vector<unsigned char>data(entry.uncompressed_size);
+	std::vector<CentralDirectoryEntry> entries;
+	// the first entry of each name, as found by findDataStream
+	boost::unordered_map<std::string, size_t> index;
+	std::vector<std::string> names;
+};
 
-		strm.avail_out = entry.uncompressed_size;
-		strm.next_out = reinterpret_cast<Bytef *>(&data[0]);
-		ret = inflate(&strm, Z_FINISH);
-		switch (ret)
-		{
-		case Z_NEED_DICT:
-		case Z_DATA_ERROR:
-		case Z_MEM_ERROR:
-			(void)inflateEnd(&strm);
-			data.clear();
-			return 0;
-		default:
+RVNGZipDirectory::RVNGZipDirectory()
+	: m_impl(new RVNGZipDirectoryImpl())
+{
+}
+
+RVNGZipDirectory::~RVNGZipDirectory()
+{
+	delete m_impl;
+}
+
+bool RVNGZipDirectory::read(RVNGInputStream *input)
+{
+	m_impl->entries.clear();
+	m_impl->index.clear();
+	m_impl->names.clear();
+
+	if (!input || !findCentralDirectoryEnd(input))
+		return false;
+	CentralDirectoryEnd end;
+	if (!readCentralDirectoryEnd(input, end))
+		return false;
+	input->seek(long(end.cdir_offset), RVNG_SEEK_SET);
+	while (!input->isEnd() && (unsigned)input->tell() < end.cdir_offset + end.cdir_size)
+	{
+		CentralDirectoryEntry entry;
+		if (!readCentralDirectoryEntry(input, entry))
 			break;
-		}
-		(void)inflateEnd(&strm);
-		return new RVNGStringStream(&data[0], (unsigned)data.size());
+		m_impl->entries.push_back(entry);
 	}
+	if (m_impl->entries.empty())
+		return false;
+
+	// compare the first local file header with the central directory information
+	input->seek(long(m_impl->entries[0].offset), RVNG_SEEK_SET);
+	LocalFileHeader header;
+	if (!readLocalFileHeader(input, header) || !areHeadersConsistent(header, m_impl->entries[0]))
+	{
+		m_impl->entries.clear();
+		return false;
+	}
+
+	for (size_t i = 0; i < m_impl->entries.size(); ++i)
+	{
+		const std::string &filename = m_impl->entries[i].filename;
+		m_impl->index.insert(std::make_pair(filename, i));
+		if (!filename.empty() && filename[filename.size()-1] != '/')
+			m_impl->names.push_back(filename);
+	}
+	return true;
+}
+
+const std::vector<std::string> &RVNGZipDirectory::getSubStreamNamesList() const
+{
+	return m_impl->names;
 }
 
+RVNGInputStream *RVNGZipDirectory::getSubstream(RVNGInputStream *input, const char *name) const
+{
+	if (!input || !name)
+		return 0;
+	boost::unordered_map<std::string, size_t>::const_iterator it = m_impl->index.find(name);
+	if (it == m_impl->index.end())
+		return 0;
+	const CentralDirectoryEntry &entry = m_impl->entries[it->second];
+	input->seek(long(entry.offset), RVNG_SEEK_SET);
+	LocalFileHeader header;
+	if (!readLocalFileHeader(input, header))
+		return 0;
+	if (!areHeadersConsistent(header, entry))
+		return 0;
+	return readDataStream(input, entry);
+}
 }
 
 /* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -37,6 +37,32 @@ public:
 	static RVNGInputStream *getSubstream(RVNGInputStream *input, const char *name);
 };
 
+struct RVNGZipDirectoryImpl;
+
+/** Index of the central directory of a zip file.
+
+The directory is read once, then each sub-stream is found by a hash lookup
+instead of a scan of the whole directory.
+*/
+class RVNGZipDirectory
+{
+public:
+	RVNGZipDirectory();
+	~RVNGZipDirectory();
+
+	/// reads the central directory of input, returns false if it is not a zip file
+	bool read(RVNGInputStream *input);
+
+	const std::vector<std::string> &getSubStreamNamesList() const;
+	RVNGInputStream *getSubstream(RVNGInputStream *input, const char *name) const;
+
+private:
+	RVNGZipDirectory(const RVNGZipDirectory &); // copy is not allowed
+	RVNGZipDirectory &operator=(const RVNGZipDirectory &); // assignment is not allowed
+
+	RVNGZipDirectoryImpl *m_impl;
+};
+
 }
 
 #endif // RVNGZIPSTREAM_H
@@ -37,5 +37,25 @@ class GenericException
 {
 };
 
+namespace librevenge
+{
+
+/* Room for an int, bool or double property, which the property lists
+ * construct in place rather than allocate. */
+union RVNGPropertyStorage
+{
+	double m_double;
+	void *m_pointer;
+	unsigned char m_data[2 * sizeof(void *)];
+};
+
+RVNGProperty *newIntPropAt(RVNGPropertyStorage &storage, const int val);
+RVNGProperty *newBoolPropAt(RVNGPropertyStorage &storage, const bool val);
+/* returns 0 if unit is RVNG_UNIT_ERROR; the property is destroyed by
+ * calling its destructor, not by delete */
+RVNGProperty *newDoublePropAt(RVNGPropertyStorage &storage, const double val, const RVNGUnit unit);
+
+}
+
 #endif /* LIBREVENGE_INTERNAL_H */
 /* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
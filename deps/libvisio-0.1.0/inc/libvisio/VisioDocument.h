@@ -34,6 +34,16 @@ public:
   static VSDAPI bool parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *painter);
 
   static VSDAPI bool parseStencils(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *painter);
+
+  static VSDAPI void setNURBSTolerance(double tolerance);
+
+  static VSDAPI unsigned long getNURBSPointCount();
+
+  typedef void (*PassHook)(const char *pass, bool begin, void *data);
+
+  static VSDAPI void setPassHook(PassHook hook, void *data);
+
+  static VSDAPI void setSinglePass(bool singlePass);
 };
 
 } // namespace libvisio
@@ -16,6 +16,7 @@
 #include "libvisio_utils.h"
 #include "VSDContentCollector.h"
 #include "VSDStylesCollector.h"
+#include "VSDRecordingCollector.h"
 #include "VSDXMLHelper.h"
 #include "VSDXMLTokenMap.h"
 
@@ -41,18 +42,37 @@ bool libvisio::VDXParser::parseMain()
     std::vector<std::list<unsigned> > documentPageShapeOrders;
 
     VSDStylesCollector stylesCollector(groupXFormsSequence, groupMembershipsSequence, documentPageShapeOrders);
+    VSDRecordingCollector recorder(&stylesCollector);
+    bool replay = VSDRecordingCollector::isEnabled();
     m_collector = &stylesCollector;
+    if (replay)
+    {
+      m_collector = &recorder;
+      m_recorder = &recorder;
+    }
     m_input->seek(0, librevenge::RVNG_SEEK_SET);
-    if (!processXmlDocument(m_input))
+    bool success = false;
+    {
+      VSDPassScope pass("styles");
+      success = processXmlDocument(m_input);
+    }
+    m_recorder = 0;
+    if (!success)
       return false;
 
     VSDStyles styles = stylesCollector.getStyleSheets();
 
     VSDContentCollector contentCollector(m_painter, groupXFormsSequence, groupMembershipsSequence, documentPageShapeOrders, styles, m_stencils);
     m_collector = &contentCollector;
-    m_input->seek(0, librevenge::RVNG_SEEK_SET);
-    if (!processXmlDocument(m_input))
-      return false;
+    VSDPassScope pass("content");
+    if (replay)
+      recorder.replay(&contentCollector);
+    else
+    {
+      m_input->seek(0, librevenge::RVNG_SEEK_SET);
+      if (!processXmlDocument(m_input))
+        return false;
+    }
 
     return true;
   }
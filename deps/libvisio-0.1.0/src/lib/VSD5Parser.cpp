@@ -15,6 +15,7 @@
 #include "libvisio_utils.h"
 #include "VSD5Parser.h"
 #include "VSDInternalStream.h"
+#include "VSDCursor.h"
 #include "VSDDocumentStructure.h"
 #include "VSDContentCollector.h"
 #include "VSDStylesCollector.h"
@@ -71,16 +72,12 @@ void libvisio::VSD5Parser::readPointerInfo(librevenge::RVNGInputStream *input, u
   VSD_DEBUG_MSG(("VSD5Parser::readPointerInfo ptrType %u shift %u pointerCount %i\n", ptrType, shift, pointerCount));
 }
 
-bool libvisio::VSD5Parser::getChunkHeader(librevenge::RVNGInputStream *input)
+bool libvisio::VSD5Parser::getChunkHeader(VSDCursor *input)
 {
-  unsigned char tmpChar = 0;
-  while (!input->isEnd() && !tmpChar)
-    tmpChar = readU8(input);
-
-  if (input->isEnd())
+  // The chunks are separated by zeroes, and one can't start on the last byte
+  input->skipZeros();
+  if (input->remaining() < 2)
     return false;
-  else
-    input->seek(-1, librevenge::RVNG_SEEK_CUR);
 
   m_header.chunkType = getUInt(input);
   m_header.id = getUInt(input);
@@ -96,7 +93,7 @@ bool libvisio::VSD5Parser::getChunkHeader(librevenge::RVNGInputStream *input)
   return true;
 }
 
-void libvisio::VSD5Parser::handleChunkRecords(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::handleChunkRecords(VSDCursor *input)
 {
   long startPosition = input->tell();
   long endPosition = input->tell() + m_header.dataLength;
@@ -129,7 +126,7 @@ void libvisio::VSD5Parser::handleChunkRecords(librevenge::RVNGInputStream *input
   }
 }
 
-void libvisio::VSD5Parser::readGeomList(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readGeomList(VSDCursor *input)
 {
   VSD_DEBUG_MSG(("VSD5Parser::readGeomList\n"));
   if (!m_shape.m_geometries.empty() && m_currentGeometryList->empty())
@@ -141,50 +138,50 @@ void libvisio::VSD5Parser::readGeomList(librevenge::RVNGInputStream *input)
   handleChunkRecords(input);
 }
 
-void libvisio::VSD5Parser::readList(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readList(VSDCursor *input)
 {
   if (!m_isStencilStarted)
     m_collector->collectUnhandledChunk(m_header.id, m_header.level);
   handleChunkRecords(input);
 }
 
-void libvisio::VSD5Parser::readCharList(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readCharList(VSDCursor *input)
 {
   VSD_DEBUG_MSG(("VSD5Parser::readCharList\n"));
   readList(input);
 }
 
-void libvisio::VSD5Parser::readParaList(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readParaList(VSDCursor *input)
 {
   VSD_DEBUG_MSG(("VSD5Parser::readParaList\n"));
   readList(input);
 }
 
-void libvisio::VSD5Parser::readShapeList(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readShapeList(VSDCursor *input)
 {
   VSD_DEBUG_MSG(("VSD5Parser::readShapeList\n"));
   readList(input);
 }
 
-void libvisio::VSD5Parser::readPropList(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readPropList(VSDCursor *input)
 {
   VSD_DEBUG_MSG(("VSD5Parser::readPropList\n"));
   readList(input);
 }
 
-void libvisio::VSD5Parser::readFieldList(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readFieldList(VSDCursor *input)
 {
   VSD_DEBUG_MSG(("VSD5Parser::readFieldList\n"));
   readList(input);
 }
 
-void libvisio::VSD5Parser::readNameList2(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readNameList2(VSDCursor *input)
 {
   VSD_DEBUG_MSG(("VSD5Parser::readNameList2\n"));
   readList(input);
 }
 
-void libvisio::VSD5Parser::readLine(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readLine(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double strokeWidth = readDouble(input);
@@ -202,7 +199,7 @@ void libvisio::VSD5Parser::readLine(librevenge::RVNGInputStream *input)
     m_shape.m_lineStyle.override(VSDOptionalLineStyle(strokeWidth, c, linePattern, startMarker, endMarker, lineCap));
 }
 
-void libvisio::VSD5Parser::readCharIX(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readCharIX(VSDCursor *input)
 {
   unsigned charCount = readU16(input);
   unsigned fontID = readU16(input);
@@ -265,7 +262,7 @@ void libvisio::VSD5Parser::readCharIX(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSD5Parser::readFillAndShadow(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readFillAndShadow(VSDCursor *input)
 {
   Colour colourFG = _colourFromIndex(readU8(input));
   Colour colourBG = _colourFromIndex(readU8(input));
@@ -297,7 +294,7 @@ void libvisio::VSD5Parser::readFillAndShadow(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSD5Parser::readStyleSheet(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readStyleSheet(VSDCursor *input)
 {
   input->seek(10, librevenge::RVNG_SEEK_CUR);
   unsigned lineStyle = getUInt(input);
@@ -307,7 +304,7 @@ void libvisio::VSD5Parser::readStyleSheet(librevenge::RVNGInputStream *input)
   m_collector->collectStyleSheet(m_header.id, m_header.level, lineStyle, fillStyle, textStyle);
 }
 
-void libvisio::VSD5Parser::readShape(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readShape(VSDCursor *input)
 {
   m_currentGeomListCount = 0;
   m_isShapeStarted = true;
@@ -357,13 +354,13 @@ void libvisio::VSD5Parser::readShape(librevenge::RVNGInputStream *input)
   m_currentShapeID = MINUS_ONE;
 }
 
-void libvisio::VSD5Parser::readPage(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readPage(VSDCursor *input)
 {
   unsigned backgroundPageID = getUInt(input);
   m_collector->collectPage(m_header.id, m_header.level, backgroundPageID, m_isBackgroundPage, m_currentPageName);
 }
 
-void libvisio::VSD5Parser::readTextBlock(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readTextBlock(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double leftMargin = readDouble(input);
@@ -388,7 +385,7 @@ void libvisio::VSD5Parser::readTextBlock(librevenge::RVNGInputStream *input)
                                                                 verticalAlign, isBgFilled, c, 0.0, (unsigned char)0));
 }
 
-void libvisio::VSD5Parser::readTextField(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readTextField(VSDCursor *input)
 {
   input->seek(3, librevenge::RVNG_SEEK_CUR);
   if (0xe8 == readU8(input))
@@ -403,7 +400,7 @@ void libvisio::VSD5Parser::readTextField(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSD5Parser::readNameIDX(librevenge::RVNGInputStream *input)
+void libvisio::VSD5Parser::readNameIDX(VSDCursor *input)
 {
   VSD_DEBUG_MSG(("VSD5Parser::readNameIDX\n"));
   std::map<unsigned, VSDName> names;
@@ -420,13 +417,13 @@ void libvisio::VSD5Parser::readNameIDX(librevenge::RVNGInputStream *input)
 }
 
 
-unsigned libvisio::VSD5Parser::getUInt(librevenge::RVNGInputStream *input)
+unsigned libvisio::VSD5Parser::getUInt(VSDCursor *input)
 {
   int value = readS16(input);
   return (unsigned)value;
 }
 
-int libvisio::VSD5Parser::getInt(librevenge::RVNGInputStream *input)
+int libvisio::VSD5Parser::getInt(VSDCursor *input)
 {
   return readS16(input);
 }
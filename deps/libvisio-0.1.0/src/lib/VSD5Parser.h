@@ -27,41 +27,41 @@ public:
 
 protected:
   virtual void readPointer(librevenge::RVNGInputStream *input, Pointer &ptr);
-  virtual bool getChunkHeader(librevenge::RVNGInputStream *input);
+  virtual bool getChunkHeader(VSDCursor *input);
   virtual void readPointerInfo(librevenge::RVNGInputStream *input, unsigned ptrType, unsigned shift, unsigned &listSize, int &pointerCount);
 
-  virtual void readGeomList(librevenge::RVNGInputStream *input);
-  virtual void readCharList(librevenge::RVNGInputStream *input);
-  virtual void readParaList(librevenge::RVNGInputStream *input);
-  virtual void readShapeList(librevenge::RVNGInputStream *input);
-  virtual void readPropList(librevenge::RVNGInputStream *input);
-  virtual void readFieldList(librevenge::RVNGInputStream *input);
-  virtual void readNameList2(librevenge::RVNGInputStream *input);
+  virtual void readGeomList(VSDCursor *input);
+  virtual void readCharList(VSDCursor *input);
+  virtual void readParaList(VSDCursor *input);
+  virtual void readShapeList(VSDCursor *input);
+  virtual void readPropList(VSDCursor *input);
+  virtual void readFieldList(VSDCursor *input);
+  virtual void readNameList2(VSDCursor *input);
 
-  virtual void readLine(librevenge::RVNGInputStream *input);
-  virtual void readFillAndShadow(librevenge::RVNGInputStream *input);
-  virtual void readTextBlock(librevenge::RVNGInputStream *input);
-  virtual void readCharIX(librevenge::RVNGInputStream *input);
-  virtual void readTextField(librevenge::RVNGInputStream *input);
+  virtual void readLine(VSDCursor *input);
+  virtual void readFillAndShadow(VSDCursor *input);
+  virtual void readTextBlock(VSDCursor *input);
+  virtual void readCharIX(VSDCursor *input);
+  virtual void readTextField(VSDCursor *input);
 
-  virtual void readShape(librevenge::RVNGInputStream *input);
-  virtual void readPage(librevenge::RVNGInputStream *input);
+  virtual void readShape(VSDCursor *input);
+  virtual void readPage(VSDCursor *input);
 
-  virtual void handleChunkRecords(librevenge::RVNGInputStream *input);
+  virtual void handleChunkRecords(VSDCursor *input);
 
-  virtual void readStyleSheet(librevenge::RVNGInputStream *input);
+  virtual void readStyleSheet(VSDCursor *input);
 
-  virtual void readNameIDX(librevenge::RVNGInputStream *input);
+  virtual void readNameIDX(VSDCursor *input);
 
-  virtual unsigned getUInt(librevenge::RVNGInputStream *input);
-  virtual int getInt(librevenge::RVNGInputStream *input);
+  virtual unsigned getUInt(VSDCursor *input);
+  virtual int getInt(VSDCursor *input);
 
 private:
   VSD5Parser();
   VSD5Parser(const VSDParser &);
   VSD5Parser &operator=(const VSDParser &);
 
-  void readList(librevenge::RVNGInputStream *input);
+  void readList(VSDCursor *input);
 };
 
 } // namespace libvisio
@@ -14,6 +14,7 @@
 #include "libvisio_utils.h"
 #include "VSD6Parser.h"
 #include "VSDInternalStream.h"
+#include "VSDCursor.h"
 #include "VSDDocumentStructure.h"
 #include "VSDContentCollector.h"
 #include "VSDStylesCollector.h"
@@ -25,16 +26,12 @@ libvisio::VSD6Parser::VSD6Parser(librevenge::RVNGInputStream *input, librevenge:
 libvisio::VSD6Parser::~VSD6Parser()
 {}
 
-bool libvisio::VSD6Parser::getChunkHeader(librevenge::RVNGInputStream *input)
+bool libvisio::VSD6Parser::getChunkHeader(VSDCursor *input)
 {
-  unsigned char tmpChar = 0;
-  while (!input->isEnd() && !tmpChar)
-    tmpChar = readU8(input);
-
-  if (input->isEnd())
+  // The chunks are separated by zeroes, and one can't start on the last byte
+  input->skipZeros();
+  if (input->remaining() < 2)
     return false;
-  else
-    input->seek(-1, librevenge::RVNG_SEEK_CUR);
 
   m_header.chunkType = readU32(input);
   m_header.id = readU32(input);
@@ -63,7 +60,7 @@ bool libvisio::VSD6Parser::getChunkHeader(librevenge::RVNGInputStream *input)
   return true;
 }
 
-void libvisio::VSD6Parser::readText(librevenge::RVNGInputStream *input)
+void libvisio::VSD6Parser::readText(VSDCursor *input)
 {
   input->seek(8, librevenge::RVNG_SEEK_CUR);
   librevenge::RVNGBinaryData  textStream;
@@ -82,7 +79,7 @@ void libvisio::VSD6Parser::readText(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSD6Parser::readCharIX(librevenge::RVNGInputStream *input)
+void libvisio::VSD6Parser::readCharIX(VSDCursor *input)
 {
   unsigned charCount = readU32(input);
   unsigned fontID = readU16(input);
@@ -148,7 +145,7 @@ void libvisio::VSD6Parser::readCharIX(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSD6Parser::readParaIX(librevenge::RVNGInputStream *input)
+void libvisio::VSD6Parser::readParaIX(VSDCursor *input)
 {
   unsigned charCount = getUInt(input);
   input->seek(1, librevenge::RVNG_SEEK_CUR);
@@ -183,7 +180,7 @@ void libvisio::VSD6Parser::readParaIX(librevenge::RVNGInputStream *input)
 }
 
 
-void libvisio::VSD6Parser::readFillAndShadow(librevenge::RVNGInputStream *input)
+void libvisio::VSD6Parser::readFillAndShadow(VSDCursor *input)
 {
   unsigned char colourFGIndex = readU8(input);
   Colour colourFG;
@@ -250,7 +247,7 @@ void libvisio::VSD6Parser::readFillAndShadow(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSD6Parser::readName(librevenge::RVNGInputStream *input)
+void libvisio::VSD6Parser::readName(VSDCursor *input)
 {
   unsigned long numBytesRead = 0;
   const unsigned char *tmpBuffer = input->read(m_header.dataLength, numBytesRead);
@@ -261,7 +258,7 @@ void libvisio::VSD6Parser::readName(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSD6Parser::readName2(librevenge::RVNGInputStream *input)
+void libvisio::VSD6Parser::readName2(VSDCursor *input)
 {
   unsigned char character = 0;
   librevenge::RVNGBinaryData name;
@@ -272,7 +269,7 @@ void libvisio::VSD6Parser::readName2(librevenge::RVNGInputStream *input)
   m_names[m_header.id] = VSDName(name, libvisio::VSD_TEXT_ANSI);
 }
 
-void libvisio::VSD6Parser::readTextField(librevenge::RVNGInputStream *input)
+void libvisio::VSD6Parser::readTextField(VSDCursor *input)
 {
   unsigned long initialPosition = input->tell();
   input->seek(7, librevenge::RVNG_SEEK_CUR);
@@ -25,15 +25,15 @@ public:
   explicit VSD6Parser(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *painter);
   ~VSD6Parser();
 protected:
-  virtual bool getChunkHeader(librevenge::RVNGInputStream *input);
+  virtual bool getChunkHeader(VSDCursor *input);
 private:
-  void readText(librevenge::RVNGInputStream *input);
-  virtual void readCharIX(librevenge::RVNGInputStream *input);
-  virtual void readParaIX(librevenge::RVNGInputStream *input);
-  virtual void readFillAndShadow(librevenge::RVNGInputStream *input);
-  virtual void readName(librevenge::RVNGInputStream *input);
-  virtual void readName2(librevenge::RVNGInputStream *input);
-  virtual void readTextField(librevenge::RVNGInputStream *input);
+  void readText(VSDCursor *input);
+  virtual void readCharIX(VSDCursor *input);
+  virtual void readParaIX(VSDCursor *input);
+  virtual void readFillAndShadow(VSDCursor *input);
+  virtual void readName(VSDCursor *input);
+  virtual void readName2(VSDCursor *input);
+  virtual void readTextField(VSDCursor *input);
 
   VSD6Parser();
   VSD6Parser(const VSDParser &);
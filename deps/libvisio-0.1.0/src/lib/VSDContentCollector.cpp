@@ -8,6 +8,7 @@
  */
 
 #include <string.h> // for memcpy
+#include <algorithm>
 #include <stack>
 #include <boost/spirit/include/classic.hpp>
 #include <unicode/ucnv.h>
@@ -51,6 +52,11 @@ static void _appendUCS4(librevenge::RVNGString &text, UChar32 ucs4Character)
   text.append((char *)outbuf);
 }
 
+unsigned char _lastAction(const librevenge::RVNGPath &path)
+{
+  return path.getActions()[path.count() - 1];
+}
+
 } // anonymous namespace
 
 
@@ -72,7 +78,7 @@ libvisio::VSDContentCollector::VSDContentCollector(
   m_groupXFormsSequence(groupXFormsSequence), m_groupMembershipsSequence(groupMembershipsSequence),
   m_groupMemberships(m_groupMembershipsSequence.begin()),
   m_currentPageNumber(0), m_shapeOutputDrawing(0), m_shapeOutputText(0),
-  m_pageOutputDrawing(), m_pageOutputText(), m_documentPageShapeOrders(documentPageShapeOrders),
+  m_pageOutputDrawing(), m_pageOutputText(), m_pageArena(), m_documentPageShapeOrders(documentPageShapeOrders),
   m_pageShapeOrder(m_documentPageShapeOrders.begin()), m_isFirstGeometry(true), m_NURBSData(), m_polylineData(),
   m_textStream(), m_names(), m_stencilNames(), m_fields(), m_stencilFields(), m_fieldIndex(0),
   m_textFormat(VSD_TEXT_ANSI), m_charFormats(), m_paraFormats(), m_lineStyle(), m_fillStyle(), m_textBlockStyle(),
@@ -235,64 +241,56 @@ void libvisio::VSDContentCollector::_flushCurrentPath()
   librevenge::RVNGPropertyList linePathProps(styleProps);
   linePathProps.insert("draw:fill", "none");
 
-  std::vector<librevenge::RVNGPropertyList> tmpPath;
+  librevenge::RVNGPath tmpPath;
   if (m_fillStyle.pattern && !m_currentFillGeometry.empty())
   {
     bool firstPoint = true;
     bool wasMove = false;
-    for (unsigned i = 0; i < m_currentFillGeometry.size(); i++)
+    const unsigned char *actions = m_currentFillGeometry.getActions();
+    const double *coordinates = m_currentFillGeometry.getCoordinates();
+    for (unsigned long i = 0; i < m_currentFillGeometry.count(); i++)
     {
       if (firstPoint)
       {
         firstPoint = false;
         wasMove = true;
       }
-      else if (m_currentFillGeometry[i]["librevenge:path-action"]->getStr() == "M")
+      else if (actions[i] == librevenge::RVNGPath::MOVE_TO)
       {
         if (!tmpPath.empty())
         {
           if (!wasMove)
           {
-            if (tmpPath.back()["librevenge:path-action"]->getStr() != "Z")
-            {
-              librevenge::RVNGPropertyList closedPath;
-              closedPath.insert("librevenge:path-action", "Z");
-              tmpPath.push_back(closedPath);
-            }
+            if (_lastAction(tmpPath) != librevenge::RVNGPath::CLOSE)
+              tmpPath.close();
           }
           else
           {
-            tmpPath.pop_back();
+            tmpPath.removeLast();
           }
         }
         wasMove = true;
       }
       else
         wasMove = false;
-      tmpPath.push_back(m_currentFillGeometry[i]);
+      tmpPath.append((librevenge::RVNGPath::Action)actions[i], coordinates);
+      coordinates += librevenge::RVNGPath::coordinateCount(actions[i]);
     }
     if (!tmpPath.empty())
     {
       if (!wasMove)
       {
-        if (tmpPath.back()["librevenge:path-action"]->getStr() != "Z")
-        {
-          librevenge::RVNGPropertyList closedPath;
-          closedPath.insert("librevenge:path-action", "Z");
-          tmpPath.push_back(closedPath);
-        }
+        if (_lastAction(tmpPath) != librevenge::RVNGPath::CLOSE)
+          tmpPath.close();
       }
       else
-        tmpPath.pop_back();
+        tmpPath.removeLast();
     }
     if (!tmpPath.empty())
     {
-      librevenge::RVNGPropertyListVector path;
-      for (unsigned i = 0; i < tmpPath.size(); ++i)
-        path.append(tmpPath[i]);
       m_shapeOutputDrawing->addStyle(fillPathProps);
       librevenge::RVNGPropertyList propList;
-      propList.insert("svg:d", path);
+      propList.insert("svg:d", tmpPath);
       m_shapeOutputDrawing->addPath(propList);
     }
   }
@@ -307,16 +305,23 @@ void libvisio::VSDContentCollector::_flushCurrentPath()
     double y = 0.0;
     double prevX = 0.0;
     double prevY = 0.0;
-    for (unsigned i = 0; i < m_currentLineGeometry.size(); i++)
+    const unsigned char *actions = m_currentLineGeometry.getActions();
+    const double *coordinates = m_currentLineGeometry.getCoordinates();
+    for (unsigned long i = 0; i < m_currentLineGeometry.count(); i++)
     {
+      // the end point of the segment comes last
+      const unsigned count = librevenge::RVNGPath::coordinateCount(actions[i]);
       if (firstPoint)
       {
         firstPoint = false;
         wasMove = true;
-        x = m_currentLineGeometry[i]["svg:x"]->getDouble();
-        y = m_currentLineGeometry[i]["svg:y"]->getDouble();
+        if (count)
+        {
+          x = coordinates[count - 2];
+          y = coordinates[count - 1];
+        }
       }
-      else if (m_currentLineGeometry[i]["librevenge:path-action"]->getStr() == "M")
+      else if (actions[i] == librevenge::RVNGPath::MOVE_TO)
       {
         if (!tmpPath.empty())
         {
@@ -324,30 +329,28 @@ void libvisio::VSDContentCollector::_flushCurrentPath()
           {
             if ((x == prevX) && (y == prevY))
             {
-              if (tmpPath.back()["librevenge:path-action"]->getStr() != "Z")
-              {
-                librevenge::RVNGPropertyList closedPath;
-                closedPath.insert("librevenge:path-action", "Z");
-                tmpPath.push_back(closedPath);
-              }
+              if (_lastAction(tmpPath) != librevenge::RVNGPath::CLOSE)
+                tmpPath.close();
             }
           }
           else
           {
-            tmpPath.pop_back();
+            tmpPath.removeLast();
           }
         }
-        x = m_currentLineGeometry[i]["svg:x"]->getDouble();
-        y = m_currentLineGeometry[i]["svg:y"]->getDouble();
+        x = coordinates[count - 2];
+        y = coordinates[count - 1];
         wasMove = true;
       }
       else
         wasMove = false;
-      tmpPath.push_back(m_currentLineGeometry[i]);
-      if (m_currentLineGeometry[i]["svg:x"])
-        prevX = m_currentLineGeometry[i]["svg:x"]->getDouble();
-      if (m_currentLineGeometry[i]["svg:y"])
-        prevY = m_currentLineGeometry[i]["svg:y"]->getDouble();
+      tmpPath.append((librevenge::RVNGPath::Action)actions[i], coordinates);
+      if (count)
+      {
+        prevX = coordinates[count - 2];
+        prevY = coordinates[count - 1];
+      }
+      coordinates += count;
     }
     if (!tmpPath.empty())
     {
@@ -355,27 +358,20 @@ void libvisio::VSDContentCollector::_flushCurrentPath()
       {
         if ((x == prevX) && (y == prevY))
         {
-          if (tmpPath.back()["librevenge:path-action"]->getStr() != "Z")
-          {
-            librevenge::RVNGPropertyList closedPath;
-            closedPath.insert("librevenge:path-action", "Z");
-            tmpPath.push_back(closedPath);
-          }
+          if (_lastAction(tmpPath) != librevenge::RVNGPath::CLOSE)
+            tmpPath.close();
         }
       }
       else
       {
-        tmpPath.pop_back();
+        tmpPath.removeLast();
       }
     }
     if (!tmpPath.empty())
     {
-      librevenge::RVNGPropertyListVector path;
-      for (unsigned i = 0; i < tmpPath.size(); ++i)
-        path.append(tmpPath[i]);
       m_shapeOutputDrawing->addStyle(linePathProps);
       librevenge::RVNGPropertyList propList;
-      propList.insert("svg:d", path);
+      propList.insert("svg:d", tmpPath);
       m_shapeOutputDrawing->addPath(propList);
     }
   }
@@ -767,14 +763,7 @@ void libvisio::VSDContentCollector::collectEllipticalArcTo(unsigned /* id */, un
   if (fabs(((x1-x2n)*(y2n-y3n) - (x2n-x3n)*(y1-y2n))) <= LIBVISIO_EPSILON || fabs(((x2n-x3n)*(y1-y2n) - (x1-x2n)*(y2n-y3n))) <= LIBVISIO_EPSILON)
     // most probably all of the points lie on the same line, so use lineTo instead
   {
-    librevenge::RVNGPropertyList end;
-    end.insert("svg:x", m_scale*m_x);
-    end.insert("svg:y", m_scale*m_y);
-    end.insert("librevenge:path-action", "L");
-    if (!m_noFill && !m_noShow)
-      m_currentFillGeometry.push_back(end);
-    if (!m_noLine && !m_noShow)
-      m_currentLineGeometry.push_back(end);
+    _lineTo(m_x, m_y);
     return;
   }
 
@@ -789,7 +778,6 @@ void libvisio::VSDContentCollector::collectEllipticalArcTo(unsigned /* id */, un
 
   double rx = sqrt(pow(x1-x0, 2) + pow(y1-y0, 2));
   double ry = rx / ecc;
-  librevenge::RVNGPropertyList arc;
   int largeArc = 0;
   int sweep = 1;
 
@@ -803,24 +791,12 @@ void libvisio::VSDContentCollector::collectEllipticalArcTo(unsigned /* id */, un
   if (midSide > 0)
     sweep = 0;
 
-  arc.insert("svg:rx", m_scale*rx);
-  arc.insert("svg:ry", m_scale*ry);
-  arc.insert("librevenge:rotate", angle * 180 / M_PI, librevenge::RVNG_GENERIC);
-  arc.insert("librevenge:large-arc", largeArc);
-  arc.insert("librevenge:sweep", sweep);
-  arc.insert("svg:x", m_scale*m_x);
-  arc.insert("svg:y", m_scale*m_y);
-  arc.insert("librevenge:path-action", "A");
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(arc);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(arc);
+  _arcTo(rx, ry, angle * 180 / M_PI, largeArc, sweep, m_x, m_y);
 }
 
 void libvisio::VSDContentCollector::collectEllipse(unsigned /* id */, unsigned level, double cx, double cy, double xleft, double yleft, double xtop, double ytop)
 {
   _handleLevelChange(level);
-  librevenge::RVNGPropertyList ellipse;
   double angle = fmod(2.0*M_PI + (cy > yleft ? 1.0 : -1.0)*acos((cx-xleft) / sqrt((xleft - cx)*(xleft - cx) + (yleft - cy)*(yleft - cy))), 2.0*M_PI);
   transformPoint(cx, cy);
   transformPoint(xleft, yleft);
@@ -836,37 +812,10 @@ void libvisio::VSDContentCollector::collectEllipse(unsigned /* id */, unsigned l
   {
     largeArc = 1;
   }
-  ellipse.insert("svg:x",m_scale*xleft);
-  ellipse.insert("svg:y",m_scale*yleft);
-  ellipse.insert("librevenge:path-action", "M");
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(ellipse);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(ellipse);
-  ellipse.insert("svg:rx",m_scale*rx);
-  ellipse.insert("svg:ry",m_scale*ry);
-  ellipse.insert("svg:x",m_scale*xtop);
-  ellipse.insert("svg:y",m_scale*ytop);
-  ellipse.insert("librevenge:large-arc", largeArc?1:0);
-  ellipse.insert("librevenge:path-action", "A");
-  ellipse.insert("librevenge:rotate", angle * 180/M_PI, librevenge::RVNG_GENERIC);
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(ellipse);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(ellipse);
-  ellipse.insert("svg:x",m_scale*xleft);
-  ellipse.insert("svg:y",m_scale*yleft);
-  ellipse.insert("librevenge:large-arc", largeArc?0:1);
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(ellipse);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(ellipse);
-  ellipse.clear();
-  ellipse.insert("librevenge:path-action", "Z");
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(ellipse);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(ellipse);
+  _moveTo(xleft, yleft);
+  _arcTo(rx, ry, angle * 180/M_PI, largeArc, true, xtop, ytop);
+  _arcTo(rx, ry, angle * 180/M_PI, !largeArc, true, xleft, yleft);
+  _closePath();
 }
 
 void libvisio::VSDContentCollector::collectInfiniteLine(unsigned /* id */, unsigned level, double x1, double y1, double x2, double y2)
@@ -941,21 +890,8 @@ void libvisio::VSDContentCollector::collectInfiniteLine(unsigned /* id */, unsig
     }
   }
 
-  librevenge::RVNGPropertyList infLine;
-  infLine.insert("svg:x",m_scale*xmove);
-  infLine.insert("svg:y",m_scale*ymove);
-  infLine.insert("librevenge:path-action", "M");
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(infLine);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(infLine);
-  infLine.insert("svg:x",m_scale*xline);
-  infLine.insert("svg:y",m_scale*yline);
-  infLine.insert("librevenge:path-action", "L");
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(infLine);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(infLine);
+  _moveTo(xmove, ymove);
+  _lineTo(xline, yline);
 }
 
 void libvisio::VSDContentCollector::collectRelCubBezTo(unsigned /* id */, unsigned level, double x, double y, double x1, double y1, double x2, double y2)
@@ -974,18 +910,7 @@ void libvisio::VSDContentCollector::collectRelCubBezTo(unsigned /* id */, unsign
   transformPoint(x, y);
   m_x = x;
   m_y = y;
-  librevenge::RVNGPropertyList node;
-  node.insert("librevenge:path-action", "C");
-  node.insert("svg:x",m_scale*x);
-  node.insert("svg:y",m_scale*y);
-  node.insert("svg:x1",m_scale*x1);
-  node.insert("svg:y1",m_scale*y1);
-  node.insert("svg:x2",m_scale*x2);
-  node.insert("svg:y2",m_scale*y2);
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(node);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(node);
+  _curveTo(x1, y1, x2, y2, x, y);
 }
 
 void libvisio::VSDContentCollector::collectRelEllipticalArcTo(unsigned id, unsigned level, double x, double y, double a, double b, double c, double d)
@@ -1024,16 +949,7 @@ void libvisio::VSDContentCollector::collectRelQuadBezTo(unsigned /* id */, unsig
   transformPoint(x, y);
   m_x = x;
   m_y = y;
-  librevenge::RVNGPropertyList node;
-  node.insert("librevenge:path-action", "Q");
-  node.insert("svg:x",m_scale*x);
-  node.insert("svg:y",m_scale*y);
-  node.insert("svg:x1",m_scale*x1);
-  node.insert("svg:y1",m_scale*y1);
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(node);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(node);
+  _quadTo(x1, y1, x, y);
 }
 
 void libvisio::VSDContentCollector::collectLine(unsigned level, const boost::optional<double> &strokeWidth, const boost::optional<Colour> &c, const boost::optional<unsigned char> &linePattern,
@@ -1228,14 +1144,7 @@ void libvisio::VSDContentCollector::collectMoveTo(unsigned /* id */, unsigned le
   transformPoint(x, y);
   m_x = x;
   m_y = y;
-  librevenge::RVNGPropertyList end;
-  end.insert("svg:x", m_scale*m_x);
-  end.insert("svg:y", m_scale*m_y);
-  end.insert("librevenge:path-action", "M");
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(end);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(end);
+  _moveTo(m_x, m_y);
 }
 
 void libvisio::VSDContentCollector::collectLineTo(unsigned /* id */, unsigned level, double x, double y)
@@ -1246,14 +1155,7 @@ void libvisio::VSDContentCollector::collectLineTo(unsigned /* id */, unsigned le
   transformPoint(x, y);
   m_x = x;
   m_y = y;
-  librevenge::RVNGPropertyList end;
-  end.insert("svg:x", m_scale*m_x);
-  end.insert("svg:y", m_scale*m_y);
-  end.insert("librevenge:path-action", "L");
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(end);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(end);
+  _lineTo(m_x, m_y);
 }
 
 void libvisio::VSDContentCollector::collectArcTo(unsigned /* id */, unsigned level, double x2, double y2, double bow)
@@ -1269,18 +1171,10 @@ void libvisio::VSDContentCollector::collectArcTo(unsigned /* id */, unsigned lev
   {
     m_x = x2;
     m_y = y2;
-    librevenge::RVNGPropertyList end;
-    end.insert("svg:x", m_scale*m_x);
-    end.insert("svg:y", m_scale*m_y);
-    end.insert("librevenge:path-action", "L");
-    if (!m_noFill && !m_noShow)
-      m_currentFillGeometry.push_back(end);
-    if (!m_noLine && !m_noShow)
-      m_currentLineGeometry.push_back(end);
+    _lineTo(m_x, m_y);
   }
   else
   {
-    librevenge::RVNGPropertyList arc;
     double chord = sqrt(pow((y2 - m_y),2) + pow((x2 - m_x),2));
     double radius = (4 * bow * bow + chord * chord) / (8 * fabs(bow));
     int largeArc = fabs(bow) > radius ? 1 : 0;
@@ -1289,18 +1183,7 @@ void libvisio::VSDContentCollector::collectArcTo(unsigned /* id */, unsigned lev
 
     m_x = x2;
     m_y = y2;
-    arc.insert("svg:rx", m_scale*radius);
-    arc.insert("svg:ry", m_scale*radius);
-    arc.insert("librevenge:rotate", angle*180/M_PI, librevenge::RVNG_GENERIC);
-    arc.insert("librevenge:large-arc", largeArc);
-    arc.insert("librevenge:sweep", sweep);
-    arc.insert("svg:x", m_scale*m_x);
-    arc.insert("svg:y", m_scale*m_y);
-    arc.insert("librevenge:path-action", "A");
-    if (!m_noFill && !m_noShow)
-      m_currentFillGeometry.push_back(arc);
-    if (!m_noLine && !m_noShow)
-      m_currentLineGeometry.push_back(arc);
+    _arcTo(radius, radius, angle*180/M_PI, largeArc, sweep, m_x, m_y);
   }
 }
 
@@ -1309,69 +1192,82 @@ void libvisio::VSDContentCollector::_outputCubicBezierSegment(const std::vector<
 {
   if (points.size() < 4)
     return;
-  librevenge::RVNGPropertyList node;
-  node.insert("librevenge:path-action", "C");
-  double x = points[1].first;
-  double y = points[1].second;
-  transformPoint(x, y);
-  node.insert("svg:x1", m_scale*x);
-  node.insert("svg:y1", m_scale*y);
-  x = points[2].first;
-  y = points[2].second;
-  transformPoint(x, y);
-  node.insert("svg:x2", m_scale*x);
-  node.insert("svg:y2", m_scale*y);
-  x = points[3].first;
-  y = points[3].second;
+  double x1 = points[1].first;
+  double y1 = points[1].second;
+  transformPoint(x1, y1);
+  double x2 = points[2].first;
+  double y2 = points[2].second;
+  transformPoint(x2, y2);
+  double x = points[3].first;
+  double y = points[3].second;
   transformPoint(x, y);
-  node.insert("svg:x", m_scale*x);
-  node.insert("svg:y", m_scale*y);
-
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(node);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(node);
+  _curveTo(x1, y1, x2, y2, x, y);
 }
 
 void libvisio::VSDContentCollector::_outputQuadraticBezierSegment(const std::vector<std::pair<double, double> > &points)
 {
   if (points.size() < 3)
     return;
-  librevenge::RVNGPropertyList node;
-  node.insert("librevenge:path-action", "Q");
-  double x = points[1].first;
-  double y = points[1].second;
-  transformPoint(x, y);
-  node.insert("svg:x1", m_scale*x);
-  node.insert("svg:y1", m_scale*y);
-  x = points[2].first;
-  y = points[2].second;
+  double x1 = points[1].first;
+  double y1 = points[1].second;
+  transformPoint(x1, y1);
+  double x = points[2].first;
+  double y = points[2].second;
   transformPoint(x, y);
-  node.insert("svg:x", m_scale*x);
-  node.insert("svg:y", m_scale*y);
-
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(node);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(node);
+  _quadTo(x1, y1, x, y);
 }
 
 void libvisio::VSDContentCollector::_outputLinearBezierSegment(const std::vector<std::pair<double, double> > &points)
 {
   if (points.size() < 2)
     return;
-  librevenge::RVNGPropertyList node;
-  node.insert("librevenge:path-action", "L");
   double x = points[1].first;
   double y = points[1].second;
   transformPoint(x, y);
-  node.insert("svg:x", m_scale*x);
-  node.insert("svg:y", m_scale*y);
+  _lineTo(x, y);
+}
 
+void libvisio::VSDContentCollector::_appendSegment(librevenge::RVNGPath::Action action, const double *coordinates)
+{
   if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(node);
+    m_currentFillGeometry.append(action, coordinates);
   if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(node);
+    m_currentLineGeometry.append(action, coordinates);
+}
+
+void libvisio::VSDContentCollector::_moveTo(double x, double y)
+{
+  const double coordinates[] = { m_scale*x, m_scale*y };
+  _appendSegment(librevenge::RVNGPath::MOVE_TO, coordinates);
+}
+
+void libvisio::VSDContentCollector::_lineTo(double x, double y)
+{
+  const double coordinates[] = { m_scale*x, m_scale*y };
+  _appendSegment(librevenge::RVNGPath::LINE_TO, coordinates);
+}
+
+void libvisio::VSDContentCollector::_curveTo(double x1, double y1, double x2, double y2, double x, double y)
+{
+  const double coordinates[] = { m_scale*x1, m_scale*y1, m_scale*x2, m_scale*y2, m_scale*x, m_scale*y };
+  _appendSegment(librevenge::RVNGPath::CURVE_TO, coordinates);
+}
+
+void libvisio::VSDContentCollector::_quadTo(double x1, double y1, double x, double y)
+{
+  const double coordinates[] = { m_scale*x1, m_scale*y1, m_scale*x, m_scale*y };
+  _appendSegment(librevenge::RVNGPath::QUAD_TO, coordinates);
+}
+
+void libvisio::VSDContentCollector::_arcTo(double rx, double ry, double rotate, bool largeArc, bool sweep, double x, double y)
+{
+  const double coordinates[] = { m_scale*rx, m_scale*ry, rotate, largeArc ? 1.0 : 0.0, sweep ? 1.0 : 0.0, m_scale*x, m_scale*y };
+  _appendSegment(librevenge::RVNGPath::ARC_TO, coordinates);
+}
+
+void libvisio::VSDContentCollector::_closePath()
+{
+  _appendSegment(librevenge::RVNGPath::CLOSE, 0);
 }
 
 void libvisio::VSDContentCollector::_generateBezierSegmentsFromNURBS(unsigned degree,
@@ -1454,28 +1350,111 @@ void libvisio::VSDContentCollector::_generateBezierSegmentsFromNURBS(unsigned de
   }
 }
 
-double libvisio::VSDContentCollector::_NURBSBasis(unsigned knot, unsigned degree, double point, const std::vector<double> &knotVector)
+namespace
+{
+
+// Largest distance, in drawing units, between a NURBS and its polyline
+#define VSD_NURBS_DEFAULT_TOLERANCE 0.0002
+// Every knot span is split in at least 2^VSD_NURBS_MIN_DEPTH segments
+#define VSD_NURBS_MIN_DEPTH 2
+#define VSD_NURBS_MAX_DEPTH 10
+
+static double g_NURBSTolerance = VSD_NURBS_DEFAULT_TOLERANCE;
+
+// Points of the polylines replacing NURBS, counted per thread so that the
+// documents parsed concurrently don't mix their counts
+static VSD_THREAD_LOCAL unsigned long g_NURBSPointCount = 0;
+
+/* Rational de Boor algorithm: the control points are weighted, lifted to
+ * homogeneous co-ordinates and blended degree times, which only involves
+ * the degree+1 control points of the knot span. */
+class NURBSEvaluator
 {
-  double basis = 0;
-  if (knotVector.empty())
-    return basis;
-  if (degree == 0)
+public:
+  NURBSEvaluator(unsigned degree, const std::vector<std::pair<double, double> > &controlPoints,
+                 const std::vector<double> &knotVector, const std::vector<double> &weights)
+    : m_degree(degree), m_controlPoints(controlPoints), m_knotVector(knotVector), m_weights(weights),
+      m_x(degree + 1), m_y(degree + 1), m_w(degree + 1) {}
+
+  // Point at t, with knot[span] <= t <= knot[span+1]
+  std::pair<double, double> evaluate(unsigned span, double t)
   {
-    if (knotVector[knot] <= point && point < knotVector[knot+1])
-      return 1;
-    else
-      return 0;
+    for (unsigned j = 0; j <= m_degree; ++j)
+    {
+      unsigned i = span - m_degree + j;
+      m_w[j] = m_weights[i];
+      m_x[j] = m_controlPoints[i].first * m_weights[i];
+      m_y[j] = m_controlPoints[i].second * m_weights[i];
+    }
+    for (unsigned r = 1; r <= m_degree; ++r)
+    {
+      for (unsigned j = m_degree; j >= r; --j)
+      {
+        unsigned i = span - m_degree + j;
+        double denominator = m_knotVector[i + m_degree - r + 1] - m_knotVector[i];
+        double alpha = denominator > LIBVISIO_EPSILON ? (t - m_knotVector[i]) / denominator : 0.0;
+        m_x[j] = (1.0 - alpha) * m_x[j-1] + alpha * m_x[j];
+        m_y[j] = (1.0 - alpha) * m_y[j-1] + alpha * m_y[j];
+        m_w[j] = (1.0 - alpha) * m_w[j-1] + alpha * m_w[j];
+      }
+    }
+    double w = fabs(m_w[m_degree]) > LIBVISIO_EPSILON ? m_w[m_degree] : LIBVISIO_EPSILON;
+    return std::pair<double, double>(m_x[m_degree] / w, m_y[m_degree] / w);
+  }
+
+private:
+  unsigned m_degree;
+  const std::vector<std::pair<double, double> > &m_controlPoints;
+  const std::vector<double> &m_knotVector;
+  const std::vector<double> &m_weights;
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  std::vector<double> m_w;
+};
+
+static double _distanceToChord(const std::pair<double, double> &point,
+                               const std::pair<double, double> &start, const std::pair<double, double> &end)
+{
+  double dx = end.first - start.first;
+  double dy = end.second - start.second;
+  double length = sqrt(dx * dx + dy * dy);
+  if (length <= LIBVISIO_EPSILON)
+    return sqrt((point.first - start.first) * (point.first - start.first) + (point.second - start.second) * (point.second - start.second));
+  return fabs(dx * (point.second - start.second) - dy * (point.first - start.first)) / length;
+}
+
+/* Appends the points of the polyline approximating the curve between t0
+ * and t1, excluding p0 and including p1. The interval is halved until its
+ * midpoint lies within the tolerance from the chord. A few subdivisions
+ * are always done, so that an inflection whose midpoint happens to be on
+ * the chord is not missed. */
+static void _flattenNURBSSpan(NURBSEvaluator &curve, unsigned span,
+                              double t0, const std::pair<double, double> &p0,
+                              double t1, const std::pair<double, double> &p1,
+                              unsigned depth, std::vector<std::pair<double, double> > &points)
+{
+  double tm = (t0 + t1) / 2;
+  std::pair<double, double> pm = curve.evaluate(span, tm);
+  if (depth < VSD_NURBS_MAX_DEPTH && (depth < VSD_NURBS_MIN_DEPTH || _distanceToChord(pm, p0, p1) > g_NURBSTolerance))
+  {
+    _flattenNURBSSpan(curve, span, t0, p0, tm, pm, depth + 1, points);
+    _flattenNURBSSpan(curve, span, tm, pm, t1, p1, depth + 1, points);
   }
-  if (knotVector.size() > knot+degree && fabs(knotVector[knot+degree]-knotVector[knot]) > LIBVISIO_EPSILON)
-    basis = (point-knotVector[knot])/(knotVector[knot+degree]-knotVector[knot]) * _NURBSBasis(knot, degree-1, point, knotVector);
+  else
+    points.push_back(p1);
+}
 
-  if (knotVector.size() > knot+degree+1 && fabs(knotVector[knot+degree+1] - knotVector[knot+1]) > LIBVISIO_EPSILON)
-    basis += (knotVector[knot+degree+1]-point)/(knotVector[knot+degree+1]-knotVector[knot+1]) * _NURBSBasis(knot+1, degree-1, point, knotVector);
+} // anonymous namespace
 
-  return basis;
+void libvisio::VSDContentCollector::setNURBSTolerance(double tolerance)
+{
+  g_NURBSTolerance = tolerance > LIBVISIO_EPSILON ? tolerance : VSD_NURBS_DEFAULT_TOLERANCE;
 }
 
-#define VSD_NUM_POLYLINES_PER_KNOT 100
+unsigned long libvisio::VSDContentCollector::getNURBSPointCount()
+{
+  return g_NURBSPointCount;
+}
 
 void libvisio::VSDContentCollector::_generatePolylineFromNURBS(unsigned degree, const std::vector<std::pair<double, double> > &controlPoints,
                                                                const std::vector<double> &knotVector, const std::vector<double> &weights)
@@ -1483,33 +1462,40 @@ void libvisio::VSDContentCollector::_generatePolylineFromNURBS(unsigned degree,
   if (m_noShow)
     return;
 
-  librevenge::RVNGPropertyList node;
-
-  for (unsigned i = 0; i < VSD_NUM_POLYLINES_PER_KNOT * knotVector.size(); i++)
-  {
-    node.clear();
-    node.insert("librevenge:path-action", "L");
-    double x = 0;
-    double y = 0;
-    double denominator = LIBVISIO_EPSILON;
+  const unsigned numPoints = (unsigned)std::min(controlPoints.size(), weights.size());
+  if (numPoints <= degree || knotVector.size() < numPoints + degree + 1)
+    return;
 
-    for (unsigned p = 0; p < controlPoints.size() && p < weights.size(); p++)
+  NURBSEvaluator curve(degree, controlPoints, knotVector, weights);
+  std::vector<std::pair<double, double> > points;
+
+  /* The curve is defined on [knot[degree], knot[numPoints]]. Every non-empty
+   * knot span is a polynomial piece, flattened on its own so that the
+   * tessellation follows the knots. */
+  for (unsigned span = degree; span < numPoints; ++span)
+  {
+    double t0 = knotVector[span];
+    double t1 = knotVector[span+1];
+    if (t1 - t0 <= LIBVISIO_EPSILON)
+      continue;
+    std::pair<double, double> p0 = curve.evaluate(span, t0);
+    std::pair<double, double> p1 = curve.evaluate(span, t1);
+    if (points.empty())
     {
-      double basis = _NURBSBasis(p, degree, (double)i / (VSD_NUM_POLYLINES_PER_KNOT * knotVector.size()), knotVector);
-      x += basis * controlPoints[p].first * weights[p];
-      y += basis * controlPoints[p].second * weights[p];
-      denominator += weights[p] * basis;
+      // A clamped curve starts on the current point, which needs no new segment
+      if (fabs(p0.first - m_originalX) > g_NURBSTolerance || fabs(p0.second - m_originalY) > g_NURBSTolerance)
+        points.push_back(p0);
     }
-    x /= denominator;
-    y /= denominator;
-    transformPoint(x, y);
-    node.insert("svg:x", m_scale*x);
-    node.insert("svg:y", m_scale*y);
+    _flattenNURBSSpan(curve, span, t0, p0, t1, p1, 0, points);
+  }
+  g_NURBSPointCount += points.size();
 
-    if (!m_noFill && !m_noShow)
-      m_currentFillGeometry.push_back(node);
-    if (!m_noLine && !m_noShow)
-      m_currentLineGeometry.push_back(node);
+  for (std::vector<std::pair<double, double> >::const_iterator iter = points.begin(); iter != points.end(); ++iter)
+  {
+    double x = iter->first;
+    double y = iter->second;
+    transformPoint(x, y);
+    _lineTo(x, y);
   }
 }
 
@@ -1581,14 +1567,7 @@ void libvisio::VSDContentCollector::collectNURBSTo(unsigned /* id */, unsigned l
   m_y = y2;
   transformPoint(m_x, m_y);
 #if 1
-  librevenge::RVNGPropertyList node;
-  node.insert("librevenge:path-action", "L");
-  node.insert("svg:x", m_scale*m_x);
-  node.insert("svg:y", m_scale*m_y);
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(node);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(node);
+  _lineTo(m_x, m_y);
 #endif
 }
 
@@ -1645,24 +1624,16 @@ void libvisio::VSDContentCollector::collectPolylineTo(unsigned /* id */ , unsign
 {
   _handleLevelChange(level);
 
-  librevenge::RVNGPropertyList polyline;
   std::vector<std::pair<double, double> > tmpPoints(points);
   for (unsigned i = 0; i< points.size(); i++)
   {
-    polyline.clear();
     if (xType == 0)
       tmpPoints[i].first *= m_xform.width;
     if (yType == 0)
       tmpPoints[i].second *= m_xform.height;
 
     transformPoint(tmpPoints[i].first, tmpPoints[i].second);
-    polyline.insert("librevenge:path-action", "L");
-    polyline.insert("svg:x", m_scale*tmpPoints[i].first);
-    polyline.insert("svg:y", m_scale*tmpPoints[i].second);
-    if (!m_noFill && !m_noShow)
-      m_currentFillGeometry.push_back(polyline);
-    if (!m_noLine && !m_noShow)
-      m_currentLineGeometry.push_back(polyline);
+    _lineTo(tmpPoints[i].first, tmpPoints[i].second);
   }
 
   m_originalX = x;
@@ -1670,13 +1641,7 @@ void libvisio::VSDContentCollector::collectPolylineTo(unsigned /* id */ , unsign
   m_x = x;
   m_y = y;
   transformPoint(m_x, m_y);
-  polyline.insert("librevenge:path-action", "L");
-  polyline.insert("svg:x", m_scale*m_x);
-  polyline.insert("svg:y", m_scale*m_y);
-  if (!m_noFill && !m_noShow)
-    m_currentFillGeometry.push_back(polyline);
-  if (!m_noLine && !m_noShow)
-    m_currentLineGeometry.push_back(polyline);
+  _lineTo(m_x, m_y);
 }
 
 void libvisio::VSDContentCollector::collectPolylineTo(unsigned id, unsigned level, double x, double y, const PolylineData &data)
@@ -1948,8 +1913,8 @@ void libvisio::VSDContentCollector::collectShape(unsigned id, unsigned level, un
   m_paraFormats.clear();
 
   m_currentShapeId = id;
-  m_pageOutputDrawing[m_currentShapeId] = VSDOutputElementList();
-  m_pageOutputText[m_currentShapeId] = VSDOutputElementList();
+  m_pageOutputDrawing[m_currentShapeId] = VSDOutputElementList(m_pageArena);
+  m_pageOutputText[m_currentShapeId] = VSDOutputElementList(m_pageArena);
   m_shapeOutputDrawing = &m_pageOutputDrawing[m_currentShapeId];
   m_shapeOutputText = &m_pageOutputText[m_currentShapeId];
   m_isShapeStarted = true;
@@ -2751,6 +2716,7 @@ void libvisio::VSDContentCollector::startPage(unsigned pageId)
     m_pageShapeOrder = m_documentPageShapeOrders.begin() + (m_currentPageNumber-1);
   m_currentPage = libvisio::VSDPage();
   m_currentPage.m_currentPageID = pageId;
+  m_pageArena.reset(new VSDOutputArena());
   m_isPageStarted = true;
 }
 
@@ -2764,6 +2730,8 @@ void libvisio::VSDContentCollector::endPage()
       m_pages.addBackgroundPage(m_currentPage);
     else
       m_pages.addPage(m_currentPage);
+    // The arena is released with the last page referencing it
+    m_pageArena.reset();
     m_isPageStarted = false;
     m_isBackgroundPage = false;
   }
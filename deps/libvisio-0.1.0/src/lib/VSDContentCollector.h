@@ -165,6 +165,10 @@ public:
   void endPage();
   void endPages();
 
+  // Flatness tolerance of the NURBS converted to polylines, in drawing units
+  static void setNURBSTolerance(double tolerance);
+  // Points generated by the NURBS flattening in the calling thread so far
+  static unsigned long getNURBSPointCount();
 
 private:
   VSDContentCollector(const VSDContentCollector &);
@@ -177,8 +181,6 @@ private:
   void transformAngle(double &angle, XForm *txtxform = 0);
   void transformFlips(bool &flipX, bool &flipY);
 
-  double _NURBSBasis(unsigned knot, unsigned degree, double point, const std::vector<double> &knotVector);
-
   void _flushShape();
   void _flushCurrentPath();
   void _flushText();
@@ -213,6 +215,15 @@ private:
   void _outputQuadraticBezierSegment(const std::vector<std::pair<double, double> > &points);
   void _outputLinearBezierSegment(const std::vector<std::pair<double, double> > &points);
 
+  // Geometry output functions, the coordinates being scaled by m_scale
+  void _appendSegment(librevenge::RVNGPath::Action action, const double *coordinates);
+  void _moveTo(double x, double y);
+  void _lineTo(double x, double y);
+  void _curveTo(double x1, double y1, double x2, double y2, double x, double y);
+  void _quadTo(double x1, double y1, double x, double y);
+  void _arcTo(double rx, double ry, double rotate, bool largeArc, bool sweep, double x, double y);
+  void _closePath();
+
   bool m_isPageStarted;
   double m_pageWidth;
   double m_pageHeight;
@@ -226,8 +237,8 @@ private:
   XForm m_xform;
   XForm *m_txtxform;
   VSDMisc m_misc;
-  std::vector<librevenge::RVNGPropertyList> m_currentFillGeometry;
-  std::vector<librevenge::RVNGPropertyList> m_currentLineGeometry;
+  librevenge::RVNGPath m_currentFillGeometry;
+  librevenge::RVNGPath m_currentLineGeometry;
   std::map<unsigned, XForm> *m_groupXForms;
   librevenge::RVNGBinaryData m_currentForeignData;
   librevenge::RVNGBinaryData m_currentOLEData;
@@ -252,6 +263,8 @@ private:
   VSDOutputElementList *m_shapeOutputDrawing, *m_shapeOutputText;
   std::map<unsigned, VSDOutputElementList> m_pageOutputDrawing;
   std::map<unsigned, VSDOutputElementList> m_pageOutputText;
+  // Holds the output elements of all the shapes of the current page
+  boost::shared_ptr<VSDOutputArena> m_pageArena;
   std::vector<std::list<unsigned> > &m_documentPageShapeOrders;
   std::vector<std::list<unsigned> >::iterator m_pageShapeOrder;
   bool m_isFirstGeometry;
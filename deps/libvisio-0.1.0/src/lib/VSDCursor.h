@@ -0,0 +1,148 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libvisio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef __VSDCURSOR_H__
+#define __VSDCURSOR_H__
+
+#include "libvisio_utils.h"
+
+namespace libvisio
+{
+
+/* Reader over a stream already in memory, for the chunk handlers of the
+ * binary parsers. It has the read/seek/tell/isEnd semantics of
+ * VSDInternalStream, but nothing is virtual, so that the readU8 ... readDouble
+ * overloads below are inlined bounds checks and loads. */
+class VSDCursor
+{
+public:
+  VSDCursor(const unsigned char *data, unsigned long size)
+    : m_data(data), m_size((long)size), m_offset(0) {}
+
+  const unsigned char *read(unsigned long numBytes, unsigned long &numBytesRead)
+  {
+    numBytesRead = 0;
+    if (numBytes == 0 || m_offset >= m_size)
+      return 0;
+    if (numBytes > (unsigned long)(m_size - m_offset))
+      numBytes = (unsigned long)(m_size - m_offset);
+    numBytesRead = numBytes;
+    const unsigned char *p = m_data + m_offset;
+    m_offset += (long)numBytes;
+    return p;
+  }
+  int seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
+  {
+    if (seekType == librevenge::RVNG_SEEK_CUR)
+      m_offset += offset;
+    else if (seekType == librevenge::RVNG_SEEK_SET)
+      m_offset = offset;
+
+    if (m_offset < 0)
+    {
+      m_offset = 0;
+      return 1;
+    }
+    if (m_offset > m_size)
+    {
+      m_offset = m_size;
+      return 1;
+    }
+    return 0;
+  }
+  long tell() const
+  {
+    return m_offset;
+  }
+  bool isEnd() const
+  {
+    return m_offset >= m_size;
+  }
+  unsigned long remaining() const
+  {
+    return m_offset < m_size ? (unsigned long)(m_size - m_offset) : 0;
+  }
+  // Moves to the next non-zero byte, or to the end
+  void skipZeros()
+  {
+    while (m_offset < m_size && !m_data[m_offset])
+      ++m_offset;
+  }
+
+  // Pointer to the next size bytes, which are skipped. Throws if there are not as many.
+  const unsigned char *take(unsigned long size)
+  {
+    if (m_offset >= m_size)
+      throw EndOfStreamException();
+    if (size > (unsigned long)(m_size - m_offset))
+    {
+      m_offset = m_size;
+      throw EndOfStreamException();
+    }
+    const unsigned char *p = m_data + m_offset;
+    m_offset += (long)size;
+    return p;
+  }
+
+private:
+  const unsigned char *m_data;
+  long m_size;
+  long m_offset;
+};
+
+inline uint8_t readU8(VSDCursor *input)
+{
+  return *input->take(1);
+}
+
+inline uint16_t readU16(VSDCursor *input)
+{
+  const unsigned char *p = input->take(2);
+  return (uint16_t)p[0]|((uint16_t)p[1]<<8);
+}
+
+inline int16_t readS16(VSDCursor *input)
+{
+  return (int16_t)readU16(input);
+}
+
+inline uint32_t readU32(VSDCursor *input)
+{
+  const unsigned char *p = input->take(4);
+  return (uint32_t)p[0]|((uint32_t)p[1]<<8)|((uint32_t)p[2]<<16)|((uint32_t)p[3]<<24);
+}
+
+inline int32_t readS32(VSDCursor *input)
+{
+  return (int32_t)readU32(input);
+}
+
+inline uint64_t readU64(VSDCursor *input)
+{
+  const unsigned char *p = input->take(8);
+  return (uint64_t)p[0]|((uint64_t)p[1]<<8)|((uint64_t)p[2]<<16)|((uint64_t)p[3]<<24)|((uint64_t)p[4]<<32)|((uint64_t)p[5]<<40)|((uint64_t)p[6]<<48)|((uint64_t)p[7]<<56);
+}
+
+inline double readDouble(VSDCursor *input)
+{
+  union
+  {
+    uint64_t u;
+    double d;
+  } tmpUnion;
+
+  tmpUnion.u = readU64(input);
+
+  return tmpUnion.d;
+}
+
+} // namespace libvisio
+
+#endif // __VSDCURSOR_H__
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
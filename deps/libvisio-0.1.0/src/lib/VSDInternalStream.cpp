@@ -9,71 +9,124 @@
 
 #include <string.h>
 #include "VSDInternalStream.h"
+#include "libvisio_utils.h"
 
 
-VSDInternalStream::VSDInternalStream(librevenge::RVNGInputStream *input, unsigned long size, bool compressed) :
-  librevenge::RVNGInputStream(),
-  m_offset(0),
-  m_buffer()
+namespace
 {
-  unsigned long tmpNumBytesRead = 0;
-
-  const unsigned char *tmpBuffer = input->read(size, tmpNumBytesRead);
 
-  if (tmpNumBytesRead < 2)
-    return;
+/* Runs the decoder over size bytes of data and returns the length of the
+ * output, which is only written if out is not null, so that the output
+ * buffer can be sized before decoding. The 4096 bytes window of the format
+ * is the output itself: a back-reference to position pointer copies from
+ * the last output byte at that position modulo 4096, or zeroes if there
+ * was none yet. */
+unsigned long lzDecode(const unsigned char *data, unsigned long size, unsigned char *out)
+{
+  unsigned long pos = 0;
+  unsigned long offset = 0;
 
-  if (!compressed)
-  {
-    for (unsigned long i=0; i<tmpNumBytesRead; i++)
-      m_buffer.push_back(tmpBuffer[i]);
-  }
-  else
+  while (offset < size)
   {
-    unsigned char buffer[4096] = { 0 };
-    unsigned pos = 0;
-    unsigned offset = 0;
+    unsigned flag = data[offset++];
+    if (offset > size-1)
+      break;
 
-    while (offset < tmpNumBytesRead)
+    unsigned mask = 1;
+    for (unsigned bit = 0; bit < 8 && offset < size; ++bit)
     {
-      unsigned flag = tmpBuffer[offset++];
-      if (offset > tmpNumBytesRead-1)
-        break;
-
-      unsigned mask = 1;
-      for (unsigned bit = 0; bit < 8 && offset < tmpNumBytesRead; ++bit)
+      if (flag & mask)
       {
-        if (flag & mask)
-        {
-          buffer[pos&4095] = tmpBuffer[offset++];
-          m_buffer.push_back(buffer[pos&4095]);
-          pos++;
-        }
+        if (out)
+          out[pos] = data[offset];
+        offset++;
+        pos++;
+      }
+      else
+      {
+        if (offset > size-2)
+          break;
+        unsigned char addr1 = data[offset++];
+        unsigned char addr2 = data[offset++];
+
+        unsigned length = (addr2&15) + 3;
+        unsigned pointer = (((unsigned)addr2 & 0xF0) << 4) | addr1;
+        if (pointer > 4078)
+          pointer -= 4078;
         else
+          pointer += 18;
+
+        if (out)
         {
-          if (offset > tmpNumBytesRead-2)
-            break;
-          unsigned char addr1 = tmpBuffer[offset++];
-          unsigned char addr2 = tmpBuffer[offset++];
-
-          unsigned length = (addr2&15) + 3;
-          unsigned pointer = (((unsigned)addr2 & 0xF0) << 4) | addr1;
-          if (pointer > 4078)
-            pointer -= 4078;
+          // distance back to the window position, between 1 and 4096
+          unsigned long distance = ((pos - pointer - 1) & 4095) + 1;
+          unsigned j = 0;
+          // bytes before the start of the output are zero
+          for (; j < length && pos + j < distance; ++j)
+            out[pos+j] = 0;
+          if (distance >= length)
+            memcpy(out + pos + j, out + pos + j - distance, length - j);
           else
-            pointer += 18;
-
-          for (unsigned j = 0; j < length; ++j)
           {
-            buffer[(pos+j) & 4095] = buffer[(pointer+j) & 4095];
-            m_buffer.push_back(buffer[(pointer+j) & 4095]);
+            // overlapping run, the copied bytes are repeated
+            for (; j < length; ++j)
+              out[pos+j] = out[pos+j-distance];
           }
-          pos += length;
         }
-        mask = mask << 1;
+        pos += length;
       }
+      mask = mask << 1;
     }
   }
+  return pos;
+}
+
+} // anonymous namespace
+
+void VSDInternalStream::decompress(const unsigned char *data, unsigned long size, std::vector<unsigned char> &buffer)
+{
+  buffer.clear();
+  if (!data || size < 2)
+    return;
+  libvisio::VSDPassScope pass("decompression");
+  buffer.resize(lzDecode(data, size, 0));
+  if (!buffer.empty())
+    lzDecode(data, size, &buffer[0]);
+}
+
+VSDInternalStream::VSDInternalStream(librevenge::RVNGInputStream *input, unsigned long size, bool compressed) :
+  librevenge::RVNGInputStream(),
+  m_offset(0),
+  m_buffer(),
+  m_data(0),
+  m_size(0)
+{
+  unsigned long tmpNumBytesRead = 0;
+
+  const unsigned char *tmpBuffer = input->read(size, tmpNumBytesRead);
+
+  if (tmpNumBytesRead < 2)
+    return;
+
+  if (!compressed)
+    m_buffer.assign(tmpBuffer, tmpBuffer + tmpNumBytesRead);
+  else
+    decompress(tmpBuffer, tmpNumBytesRead, m_buffer);
+
+  if (!m_buffer.empty())
+  {
+    m_data = &m_buffer[0];
+    m_size = m_buffer.size();
+  }
+}
+
+VSDInternalStream::VSDInternalStream(const std::vector<unsigned char> &buffer) :
+  librevenge::RVNGInputStream(),
+  m_offset(0),
+  m_buffer(),
+  m_data(buffer.empty() ? 0 : &buffer[0]),
+  m_size(buffer.size())
+{
 }
 
 const unsigned char *VSDInternalStream::read(unsigned long numBytes, unsigned long &numBytesRead)
@@ -85,10 +138,10 @@ const unsigned char *VSDInternalStream::read(unsigned long numBytes, unsigned lo
 
   int numBytesToRead;
 
-  if ((m_offset+numBytes) < m_buffer.size())
+  if ((m_offset+numBytes) < m_size)
     numBytesToRead = numBytes;
   else
-    numBytesToRead = m_buffer.size() - m_offset;
+    numBytesToRead = m_size - m_offset;
 
   numBytesRead = numBytesToRead; // about as paranoid as we can be..
 
@@ -98,7 +151,7 @@ const unsigned char *VSDInternalStream::read(unsigned long numBytes, unsigned lo
   long oldOffset = m_offset;
   m_offset += numBytesToRead;
 
-  return &m_buffer[oldOffset];
+  return m_data + oldOffset;
 }
 
 int VSDInternalStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
@@ -113,9 +166,9 @@ int VSDInternalStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
     m_offset = 0;
     return 1;
   }
-  if ((long)m_offset > (long)m_buffer.size())
+  if ((long)m_offset > (long)m_size)
   {
-    m_offset = m_buffer.size();
+    m_offset = m_size;
     return 1;
   }
 
@@ -129,7 +182,7 @@ long VSDInternalStream::tell()
 
 bool VSDInternalStream::isEnd()
 {
-  if ((long)m_offset >= (long)m_buffer.size())
+  if ((long)m_offset >= (long)m_size)
     return true;
 
   return false;
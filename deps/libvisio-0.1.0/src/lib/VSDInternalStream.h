@@ -19,6 +19,8 @@ class VSDInternalStream : public librevenge::RVNGInputStream
 {
 public:
   VSDInternalStream(librevenge::RVNGInputStream *input, unsigned long size, bool compressed=false);
+  // Stream on data decompressed earlier, which must outlive it
+  explicit VSDInternalStream(const std::vector<unsigned char> &buffer);
   ~VSDInternalStream() {}
 
   bool isStructured()
@@ -51,12 +53,21 @@ public:
   bool isEnd();
   unsigned long getSize() const
   {
-    return m_buffer.size();
+    return m_size;
   };
+  const unsigned char *getDataBuffer() const
+  {
+    return m_data;
+  }
+
+  // Decompresses size bytes of Visio's LZ77 variant into buffer
+  static void decompress(const unsigned char *data, unsigned long size, std::vector<unsigned char> &buffer);
 
 private:
   volatile long m_offset;
   std::vector<unsigned char> m_buffer;
+  const unsigned char *m_data;
+  unsigned long m_size;
   VSDInternalStream(const VSDInternalStream &);
   VSDInternalStream &operator=(const VSDInternalStream &);
 };
@@ -96,406 +96,196 @@ static void separateSpacesAndInsertText(librevenge::RVNGDrawingInterface *iface,
 
 } // anonymous namespace
 
-class VSDOutputElement
-{
-public:
-  VSDOutputElement() {}
-  virtual ~VSDOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter) = 0;
-  virtual VSDOutputElement *clone() = 0;
-};
-
-
-class VSDStyleOutputElement : public VSDOutputElement
-{
-public:
-  VSDStyleOutputElement(const librevenge::RVNGPropertyList &propList);
-  virtual ~VSDStyleOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDStyleOutputElement(m_propList);
-  }
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-
-class VSDPathOutputElement : public VSDOutputElement
-{
-public:
-  VSDPathOutputElement(const librevenge::RVNGPropertyList &propList);
-  virtual ~VSDPathOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDPathOutputElement(m_propList);
-  }
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-
-class VSDGraphicObjectOutputElement : public VSDOutputElement
-{
-public:
-  VSDGraphicObjectOutputElement(const librevenge::RVNGPropertyList &propList);
-  virtual ~VSDGraphicObjectOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDGraphicObjectOutputElement(m_propList);
-  }
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-
-class VSDStartTextObjectOutputElement : public VSDOutputElement
-{
-public:
-  VSDStartTextObjectOutputElement(const librevenge::RVNGPropertyList &propList);
-  virtual ~VSDStartTextObjectOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDStartTextObjectOutputElement(m_propList);
-  }
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-
-class VSDOpenParagraphOutputElement : public VSDOutputElement
-{
-public:
-  VSDOpenParagraphOutputElement(const librevenge::RVNGPropertyList &propList);
-  virtual ~VSDOpenParagraphOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDOpenParagraphOutputElement(m_propList);
-  }
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-
-class VSDStartLayerOutputElement : public VSDOutputElement
-{
-public:
-  VSDStartLayerOutputElement(const librevenge::RVNGPropertyList &propList);
-  virtual ~VSDStartLayerOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDStartLayerOutputElement(m_propList);
-  }
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-
-class VSDEndLayerOutputElement : public VSDOutputElement
-{
-public:
-  VSDEndLayerOutputElement();
-  virtual ~VSDEndLayerOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDEndLayerOutputElement();
-  }
-};
-
-
-class VSDOpenSpanOutputElement : public VSDOutputElement
-{
-public:
-  VSDOpenSpanOutputElement(const librevenge::RVNGPropertyList &propList);
-  virtual ~VSDOpenSpanOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDOpenSpanOutputElement(m_propList);
-  }
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-
-class VSDInsertTextOutputElement : public VSDOutputElement
-{
-public:
-  VSDInsertTextOutputElement(const librevenge::RVNGString &text);
-  virtual ~VSDInsertTextOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDInsertTextOutputElement(m_text);
-  }
-private:
-  librevenge::RVNGString m_text;
-};
-
-
-class VSDCloseSpanOutputElement : public VSDOutputElement
-{
-public:
-  VSDCloseSpanOutputElement();
-  virtual ~VSDCloseSpanOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDCloseSpanOutputElement();
-  }
-};
-
-
-class VSDCloseParagraphOutputElement : public VSDOutputElement
-{
-public:
-  VSDCloseParagraphOutputElement();
-  virtual ~VSDCloseParagraphOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDCloseParagraphOutputElement();
-  }
-};
-
-
-class VSDEndTextObjectOutputElement : public VSDOutputElement
-{
-public:
-  VSDEndTextObjectOutputElement();
-  virtual ~VSDEndTextObjectOutputElement() {}
-  virtual void draw(librevenge::RVNGDrawingInterface *painter);
-  virtual VSDOutputElement *clone()
-  {
-    return new VSDEndTextObjectOutputElement();
-  }
-};
-
 } // namespace libvisio
 
-libvisio::VSDStyleOutputElement::VSDStyleOutputElement(const librevenge::RVNGPropertyList &propList) :
-  m_propList(propList) {}
-
-void libvisio::VSDStyleOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
+libvisio::VSDOutputArena::VSDOutputArena()
+  : m_propLists(), m_texts()
 {
-  if (painter)
-    painter->setStyle(m_propList);
 }
 
-
-libvisio::VSDPathOutputElement::VSDPathOutputElement(const librevenge::RVNGPropertyList &propList) :
-  m_propList(propList) {}
-
-void libvisio::VSDPathOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
-{
-  if (painter)
-    painter->drawPath(m_propList);
-}
-
-
-libvisio::VSDGraphicObjectOutputElement::VSDGraphicObjectOutputElement(const librevenge::RVNGPropertyList &propList) :
-  m_propList(propList) {}
-
-void libvisio::VSDGraphicObjectOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
-{
-  if (painter)
-    painter->drawGraphicObject(m_propList);
-}
-
-
-libvisio::VSDStartTextObjectOutputElement::VSDStartTextObjectOutputElement(const librevenge::RVNGPropertyList &propList) :
-  m_propList(propList) {}
-
-void libvisio::VSDStartTextObjectOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
-{
-  if (painter)
-    painter->startTextObject(m_propList);
-}
-
-libvisio::VSDOpenSpanOutputElement::VSDOpenSpanOutputElement(const librevenge::RVNGPropertyList &propList) :
-  m_propList(propList) {}
-
-void libvisio::VSDOpenSpanOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
-{
-  if (painter)
-    painter->openSpan(m_propList);
-}
-
-
-libvisio::VSDStartLayerOutputElement::VSDStartLayerOutputElement(const librevenge::RVNGPropertyList &propList) :
-  m_propList(propList) {}
-
-void libvisio::VSDStartLayerOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
-{
-  if (painter)
-    painter->startLayer(m_propList);
-}
-
-
-libvisio::VSDEndLayerOutputElement::VSDEndLayerOutputElement() {}
-
-void libvisio::VSDEndLayerOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
+libvisio::VSDOutputArena::~VSDOutputArena()
 {
-  if (painter)
-    painter->endLayer();
 }
 
-
-libvisio::VSDOpenParagraphOutputElement::VSDOpenParagraphOutputElement(const librevenge::RVNGPropertyList &propList) :
-  m_propList(propList) {}
-
-void libvisio::VSDOpenParagraphOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
+const librevenge::RVNGPropertyList *libvisio::VSDOutputArena::store(const librevenge::RVNGPropertyList &propList)
 {
-  if (painter)
-    painter->openParagraph(m_propList);
+  m_propLists.push_back(propList);
+  return &m_propLists.back();
 }
 
-
-libvisio::VSDInsertTextOutputElement::VSDInsertTextOutputElement(const librevenge::RVNGString &text) :
-  m_text(text) {}
-
-void libvisio::VSDInsertTextOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
+const librevenge::RVNGString *libvisio::VSDOutputArena::store(const librevenge::RVNGString &text)
 {
-  if (painter)
-    separateSpacesAndInsertText(painter, m_text);
+  m_texts.push_back(text);
+  return &m_texts.back();
 }
 
-libvisio::VSDCloseSpanOutputElement::VSDCloseSpanOutputElement() {}
-
-void libvisio::VSDCloseSpanOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
+libvisio::VSDOutputElementList::VSDOutputElementList()
+  : m_commands(), m_arena(), m_arenas()
 {
-  if (painter)
-    painter->closeSpan();
 }
 
-
-libvisio::VSDCloseParagraphOutputElement::VSDCloseParagraphOutputElement() {}
-
-void libvisio::VSDCloseParagraphOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
+libvisio::VSDOutputElementList::VSDOutputElementList(const boost::shared_ptr<VSDOutputArena> &arena)
+  : m_commands(), m_arena(arena), m_arenas()
 {
-  if (painter)
-    painter->closeParagraph();
+  if (m_arena)
+    m_arenas.push_back(m_arena);
 }
 
-
-libvisio::VSDEndTextObjectOutputElement::VSDEndTextObjectOutputElement() {}
-
-void libvisio::VSDEndTextObjectOutputElement::draw(librevenge::RVNGDrawingInterface *painter)
+libvisio::VSDOutputArena &libvisio::VSDOutputElementList::_arena()
 {
-  if (painter)
-    painter->endTextObject();
+  if (!m_arena)
+  {
+    m_arena.reset(new VSDOutputArena());
+    _reference(m_arena);
+  }
+  return *m_arena;
 }
 
-
-libvisio::VSDOutputElementList::VSDOutputElementList()
-  : m_elements()
+void libvisio::VSDOutputElementList::_reference(const boost::shared_ptr<VSDOutputArena> &arena)
 {
+  // a handful of arenas at most, one per page usually
+  for (std::vector<boost::shared_ptr<VSDOutputArena> >::const_iterator iter = m_arenas.begin(); iter != m_arenas.end(); ++iter)
+  {
+    if (*iter == arena)
+      return;
+  }
+  m_arenas.push_back(arena);
 }
 
-libvisio::VSDOutputElementList::VSDOutputElementList(const libvisio::VSDOutputElementList &elementList)
-  : m_elements()
+void libvisio::VSDOutputElementList::_add(VSDOutputCommand::Type type, const librevenge::RVNGPropertyList &propList)
 {
-  std::vector<libvisio::VSDOutputElement *>::const_iterator iter;
-  for (iter = elementList.m_elements.begin(); iter != elementList.m_elements.end(); ++iter)
-    m_elements.push_back((*iter)->clone());
+  VSDOutputCommand command;
+  command.m_type = type;
+  command.m_propList = _arena().store(propList);
+  m_commands.push_back(command);
 }
 
-libvisio::VSDOutputElementList &libvisio::VSDOutputElementList::operator=(const libvisio::VSDOutputElementList &elementList)
+void libvisio::VSDOutputElementList::_add(VSDOutputCommand::Type type)
 {
-  for (std::vector<VSDOutputElement *>::iterator iter = m_elements.begin(); iter != m_elements.end(); ++iter)
-    delete(*iter);
-
-  m_elements.clear();
-
-  for (std::vector<VSDOutputElement *>::const_iterator cstiter = elementList.m_elements.begin(); cstiter != elementList.m_elements.end(); ++cstiter)
-    m_elements.push_back((*cstiter)->clone());
-
-  return *this;
+  VSDOutputCommand command;
+  command.m_type = type;
+  command.m_propList = 0;
+  m_commands.push_back(command);
 }
 
 void libvisio::VSDOutputElementList::append(const libvisio::VSDOutputElementList &elementList)
 {
-  for (std::vector<VSDOutputElement *>::const_iterator cstiter = elementList.m_elements.begin(); cstiter != elementList.m_elements.end(); ++cstiter)
-    m_elements.push_back((*cstiter)->clone());
-}
-
-libvisio::VSDOutputElementList::~VSDOutputElementList()
-{
-  for (std::vector<VSDOutputElement *>::iterator iter = m_elements.begin(); iter != m_elements.end(); ++iter)
-    delete(*iter);
-  m_elements.clear();
+  if (&elementList == this || elementList.m_commands.empty())
+    return;
+  for (std::vector<boost::shared_ptr<VSDOutputArena> >::const_iterator iter = elementList.m_arenas.begin(); iter != elementList.m_arenas.end(); ++iter)
+    _reference(*iter);
+  m_commands.insert(m_commands.end(), elementList.m_commands.begin(), elementList.m_commands.end());
 }
 
 void libvisio::VSDOutputElementList::draw(librevenge::RVNGDrawingInterface *painter) const
 {
-  for (std::vector<VSDOutputElement *>::const_iterator iter = m_elements.begin(); iter != m_elements.end(); ++iter)
-    (*iter)->draw(painter);
+  if (!painter)
+    return;
+  for (std::vector<VSDOutputCommand>::const_iterator iter = m_commands.begin(); iter != m_commands.end(); ++iter)
+  {
+    switch (iter->m_type)
+    {
+    case VSDOutputCommand::STYLE:
+      painter->setStyle(*iter->m_propList);
+      break;
+    case VSDOutputCommand::PATH:
+      painter->drawPath(*iter->m_propList);
+      break;
+    case VSDOutputCommand::GRAPHIC_OBJECT:
+      painter->drawGraphicObject(*iter->m_propList);
+      break;
+    case VSDOutputCommand::START_TEXT_OBJECT:
+      painter->startTextObject(*iter->m_propList);
+      break;
+    case VSDOutputCommand::OPEN_PARAGRAPH:
+      painter->openParagraph(*iter->m_propList);
+      break;
+    case VSDOutputCommand::OPEN_SPAN:
+      painter->openSpan(*iter->m_propList);
+      break;
+    case VSDOutputCommand::INSERT_TEXT:
+      separateSpacesAndInsertText(painter, *iter->m_text);
+      break;
+    case VSDOutputCommand::CLOSE_SPAN:
+      painter->closeSpan();
+      break;
+    case VSDOutputCommand::CLOSE_PARAGRAPH:
+      painter->closeParagraph();
+      break;
+    case VSDOutputCommand::END_TEXT_OBJECT:
+      painter->endTextObject();
+      break;
+    case VSDOutputCommand::START_LAYER:
+      painter->startLayer(*iter->m_propList);
+      break;
+    case VSDOutputCommand::END_LAYER:
+      painter->endLayer();
+      break;
+    }
+  }
 }
 
 void libvisio::VSDOutputElementList::addStyle(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(new VSDStyleOutputElement(propList));
+  _add(VSDOutputCommand::STYLE, propList);
 }
 
 void libvisio::VSDOutputElementList::addPath(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(new VSDPathOutputElement(propList));
+  _add(VSDOutputCommand::PATH, propList);
 }
 
 void libvisio::VSDOutputElementList::addGraphicObject(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(new VSDGraphicObjectOutputElement(propList));
+  _add(VSDOutputCommand::GRAPHIC_OBJECT, propList);
 }
 
 void libvisio::VSDOutputElementList::addStartTextObject(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(new VSDStartTextObjectOutputElement(propList));
+  _add(VSDOutputCommand::START_TEXT_OBJECT, propList);
 }
 
 void libvisio::VSDOutputElementList::addOpenParagraph(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(new VSDOpenParagraphOutputElement(propList));
+  _add(VSDOutputCommand::OPEN_PARAGRAPH, propList);
 }
 
 void libvisio::VSDOutputElementList::addOpenSpan(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(new VSDOpenSpanOutputElement(propList));
+  _add(VSDOutputCommand::OPEN_SPAN, propList);
 }
 
 void libvisio::VSDOutputElementList::addInsertText(const librevenge::RVNGString &text)
 {
-  m_elements.push_back(new VSDInsertTextOutputElement(text));
+  VSDOutputCommand command;
+  command.m_type = VSDOutputCommand::INSERT_TEXT;
+  command.m_text = _arena().store(text);
+  m_commands.push_back(command);
 }
 
 void libvisio::VSDOutputElementList::addCloseSpan()
 {
-  m_elements.push_back(new VSDCloseSpanOutputElement());
+  _add(VSDOutputCommand::CLOSE_SPAN);
 }
 
 void libvisio::VSDOutputElementList::addCloseParagraph()
 {
-  m_elements.push_back(new VSDCloseParagraphOutputElement());
+  _add(VSDOutputCommand::CLOSE_PARAGRAPH);
 }
 
 void libvisio::VSDOutputElementList::addEndTextObject()
 {
-  m_elements.push_back(new VSDEndTextObjectOutputElement());
+  _add(VSDOutputCommand::END_TEXT_OBJECT);
 }
 
 void libvisio::VSDOutputElementList::addStartLayer(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(new VSDStartLayerOutputElement(propList));
+  _add(VSDOutputCommand::START_LAYER, propList);
 }
 
 void libvisio::VSDOutputElementList::addEndLayer()
 {
-  m_elements.push_back(new VSDEndLayerOutputElement());
+  _add(VSDOutputCommand::END_LAYER);
 }
 
 /* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -10,23 +10,59 @@
 #ifndef __VSDOUTPUTELEMENTLIST_H__
 #define __VSDOUTPUTELEMENTLIST_H__
 
+#include <deque>
 #include <map>
 #include <list>
 #include <vector>
+#include <boost/shared_ptr.hpp>
 #include <librevenge/librevenge.h>
 
 namespace libvisio
 {
 
-class VSDOutputElement;
+// Storage of the properties and texts of the output elements of a page,
+// released all at once with the last list referencing it
+class VSDOutputArena
+{
+public:
+  VSDOutputArena();
+  ~VSDOutputArena();
+  const librevenge::RVNGPropertyList *store(const librevenge::RVNGPropertyList &propList);
+  const librevenge::RVNGString *store(const librevenge::RVNGString &text);
+private:
+  VSDOutputArena(const VSDOutputArena &);
+  VSDOutputArena &operator=(const VSDOutputArena &);
+  // deques never move their elements, the commands point to them
+  std::deque<librevenge::RVNGPropertyList> m_propLists;
+  std::deque<librevenge::RVNGString> m_texts;
+};
+
+// A painter call and its argument, stored in an arena
+struct VSDOutputCommand
+{
+  enum Type
+  {
+    STYLE, PATH, GRAPHIC_OBJECT, START_TEXT_OBJECT, OPEN_PARAGRAPH, OPEN_SPAN,
+    INSERT_TEXT, CLOSE_SPAN, CLOSE_PARAGRAPH, END_TEXT_OBJECT, START_LAYER, END_LAYER
+  };
+  Type m_type;
+  union
+  {
+    const librevenge::RVNGPropertyList *m_propList;
+    const librevenge::RVNGString *m_text;
+  };
+};
 
+/* The commands are plain values and the arenas holding their arguments are
+ * shared: copying or appending a list copies the commands and references
+ * the arenas, the arguments are never copied again. */
 class VSDOutputElementList
 {
 public:
   VSDOutputElementList();
-  VSDOutputElementList(const VSDOutputElementList &elementList);
-  VSDOutputElementList &operator=(const VSDOutputElementList &elementList);
-  virtual ~VSDOutputElementList();
+  // The elements added are stored in arena, which may be shared with the
+  // other lists of the page
+  explicit VSDOutputElementList(const boost::shared_ptr<VSDOutputArena> &arena);
   void append(const VSDOutputElementList &elementList);
   void draw(librevenge::RVNGDrawingInterface *painter) const;
   void addStyle(const librevenge::RVNGPropertyList &propList);
@@ -43,10 +79,19 @@ public:
   void addEndLayer();
   bool empty() const
   {
-    return m_elements.empty();
+    return m_commands.empty();
   }
 private:
-  std::vector<VSDOutputElement *> m_elements;
+  void _add(VSDOutputCommand::Type type, const librevenge::RVNGPropertyList &propList);
+  void _add(VSDOutputCommand::Type type);
+  VSDOutputArena &_arena();
+  void _reference(const boost::shared_ptr<VSDOutputArena> &arena);
+
+  std::vector<VSDOutputCommand> m_commands;
+  // where the elements added go, created on the first one if not given
+  boost::shared_ptr<VSDOutputArena> m_arena;
+  // the arenas of the commands, m_arena included
+  std::vector<boost::shared_ptr<VSDOutputArena> > m_arenas;
 };
 
 
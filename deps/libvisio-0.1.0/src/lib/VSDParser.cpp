@@ -16,17 +16,19 @@
 #include "libvisio_utils.h"
 #include "VSDParser.h"
 #include "VSDInternalStream.h"
+#include "VSDCursor.h"
+#include "VSDRecordingCollector.h"
 #include "VSDDocumentStructure.h"
 #include "VSDContentCollector.h"
 #include "VSDStylesCollector.h"
 
 libvisio::VSDParser::VSDParser(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *painter)
-  : m_input(input), m_painter(painter), m_header(), m_collector(0), m_shapeList(), m_currentLevel(0),
+  : m_input(input), m_painter(painter), m_header(), m_collector(0), m_recorder(0), m_shapeList(), m_currentLevel(0),
     m_stencils(), m_currentStencil(0), m_shape(), m_isStencilStarted(false), m_isInStyles(false),
     m_currentShapeLevel(0), m_currentShapeID(MINUS_ONE), m_extractStencils(false), m_colours(),
     m_isBackgroundPage(false), m_isShapeStarted(false), m_shadowOffsetX(0.0), m_shadowOffsetY(0.0),
     m_currentGeometryList(0), m_currentGeomListCount(0), m_fonts(), m_names(), m_namesMapMap(),
-    m_currentPageName()
+    m_currentPageName(), m_streamCache()
 {}
 
 libvisio::VSDParser::~VSDParser()
@@ -45,16 +47,12 @@ void libvisio::VSDParser::_nameFromId(VSDName &name, unsigned id, unsigned level
   }
 }
 
-bool libvisio::VSDParser::getChunkHeader(librevenge::RVNGInputStream *input)
+bool libvisio::VSDParser::getChunkHeader(VSDCursor *input)
 {
-  unsigned char tmpChar = 0;
-  while (!input->isEnd() && !tmpChar)
-    tmpChar = readU8(input);
-
-  if (input->isEnd())
+  // The chunks are separated by zeroes, and one can't start on the last byte
+  input->skipZeros();
+  if (input->remaining() < 2)
     return false;
-  else
-    input->seek(-1, librevenge::RVNG_SEEK_CUR);
 
   m_header.chunkType = readU32(input);
   m_header.id = readU32(input);
@@ -125,22 +123,45 @@ bool libvisio::VSDParser::parseMain()
   std::vector<std::list<unsigned> > documentPageShapeOrders;
 
   VSDStylesCollector stylesCollector(groupXFormsSequence, groupMembershipsSequence, documentPageShapeOrders);
+  VSDRecordingCollector recorder(&stylesCollector);
+  bool replay = VSDRecordingCollector::isEnabled();
   m_collector = &stylesCollector;
+  if (replay)
+  {
+    m_collector = &recorder;
+    m_recorder = &recorder;
+  }
   VSD_DEBUG_MSG(("VSDParser::parseMain 1st pass\n"));
-  if (!parseDocument(&trailerStream, shift))
+  bool success;
+  {
+    VSDPassScope pass("styles");
+    success = parseDocument(&trailerStream, shift);
+    if (success)
+    {
+      // The content collector doesn't get the end of the first pass
+      recorder.setPaused(true);
+      _handleLevelChange(0);
+    }
+  }
+  m_recorder = 0;
+  if (!success)
+  {
+    m_streamCache.clear();
     return false;
-
-  _handleLevelChange(0);
+  }
 
   VSDStyles styles = stylesCollector.getStyleSheets();
 
   VSDContentCollector contentCollector(m_painter, groupXFormsSequence, groupMembershipsSequence, documentPageShapeOrders, styles, m_stencils);
   m_collector = &contentCollector;
   VSD_DEBUG_MSG(("VSDParser::parseMain 2nd pass\n"));
-  if (!parseDocument(&trailerStream, shift))
-    return false;
-
-  return true;
+  VSDPassScope pass("content");
+  if (replay)
+    recorder.replay(&contentCollector);
+  else
+    success = parseDocument(&trailerStream, shift);
+  m_streamCache.clear();
+  return success;
 }
 
 bool libvisio::VSDParser::parseDocument(librevenge::RVNGInputStream *input, unsigned shift)
@@ -259,8 +280,7 @@ void libvisio::VSDParser::handleStream(const Pointer &ptr, unsigned idx, unsigne
   _handleLevelChange(level);
   VSDStencil tmpStencil;
   bool compressed = ((ptr.Format & 2) == 2);
-  m_input->seek(ptr.Offset, librevenge::RVNG_SEEK_SET);
-  VSDInternalStream tmpInput(m_input, ptr.Length, compressed);
+  VSDInternalStream tmpInput(_getStreamData(ptr));
   m_header.dataLength = tmpInput.getSize();
   unsigned shift = compressed ? 4 : 0;
   switch (ptr.Type)
@@ -288,6 +308,9 @@ void libvisio::VSDParser::handleStream(const Pointer &ptr, unsigned idx, unsigne
     if (m_stencils.count())
       return;
     m_isStencilStarted = true;
+    // The second pass skips the stencils, which are only parsed once
+    if (m_recorder)
+      m_recorder->setPaused(true);
     break;
   case VSD_STENCIL_PAGE:
     if (m_extractStencils)
@@ -341,7 +364,15 @@ void libvisio::VSDParser::handleStream(const Pointer &ptr, unsigned idx, unsigne
     if (m_extractStencils)
       m_collector->endPages();
     else
+    {
       m_isStencilStarted = false;
+      if (m_recorder)
+      {
+        m_recorder->setPaused(false);
+        // where the second pass would have left the stencils
+        m_currentLevel = level;
+      }
+    }
     break;
   case VSD_STENCIL_PAGE:
     _handleLevelChange(0);
@@ -369,15 +400,16 @@ void libvisio::VSDParser::handleStream(const Pointer &ptr, unsigned idx, unsigne
 
 }
 
-void libvisio::VSDParser::handleBlob(librevenge::RVNGInputStream *input, unsigned shift, unsigned level)
+void libvisio::VSDParser::handleBlob(VSDInternalStream *input, unsigned shift, unsigned level)
 {
   try
   {
+    VSDCursor cursor(input->getDataBuffer(), input->getSize());
     m_header.level = level;
-    input->seek(shift, librevenge::RVNG_SEEK_SET);
+    cursor.seek(shift, librevenge::RVNG_SEEK_SET);
     m_header.dataLength -= shift;
     _handleLevelChange(m_header.level);
-    handleChunk(input);
+    handleChunk(&cursor);
   }
   catch (EndOfStreamException &)
   {
@@ -385,25 +417,47 @@ void libvisio::VSDParser::handleBlob(librevenge::RVNGInputStream *input, unsigne
   }
 }
 
-void libvisio::VSDParser::handleChunks(librevenge::RVNGInputStream *input, unsigned level)
+const std::vector<unsigned char> &libvisio::VSDParser::_getStreamData(const Pointer &ptr)
+{
+  std::pair<unsigned, unsigned> key(ptr.Offset, ptr.Length);
+  std::map<std::pair<unsigned, unsigned>, std::vector<unsigned char> >::iterator iter = m_streamCache.find(key);
+  if (iter != m_streamCache.end())
+    return iter->second;
+
+  std::vector<unsigned char> &buffer = m_streamCache[key];
+  m_input->seek(ptr.Offset, librevenge::RVNG_SEEK_SET);
+  unsigned long numBytesRead = 0;
+  const unsigned char *data = m_input->read(ptr.Length, numBytesRead);
+  if (numBytesRead < 2)
+    return buffer;
+  if ((ptr.Format & 2) == 2)
+    VSDInternalStream::decompress(data, numBytesRead, buffer);
+  else
+    buffer.assign(data, data + numBytesRead);
+  return buffer;
+}
+
+void libvisio::VSDParser::handleChunks(VSDInternalStream *input, unsigned level)
 {
   long endPos = 0;
+  VSDCursor cursor(input->getDataBuffer(), input->getSize());
+  cursor.seek(input->tell(), librevenge::RVNG_SEEK_SET);
 
-  while (!input->isEnd())
+  while (!cursor.isEnd())
   {
-    if (!getChunkHeader(input))
+    if (!getChunkHeader(&cursor))
       return;
     m_header.level += level;
-    endPos = m_header.dataLength+m_header.trailer+input->tell();
+    endPos = m_header.dataLength+m_header.trailer+cursor.tell();
 
     _handleLevelChange(m_header.level);
     VSD_DEBUG_MSG(("VSDParser::handleChunks - parsing chunk type 0x%x\n", m_header.chunkType));
-    handleChunk(input);
-    input->seek(endPos, librevenge::RVNG_SEEK_SET);
+    handleChunk(&cursor);
+    cursor.seek(endPos, librevenge::RVNG_SEEK_SET);
   }
 }
 
-void libvisio::VSDParser::handleChunk(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::handleChunk(VSDCursor *input)
 {
   switch (m_header.chunkType)
   {
@@ -658,7 +712,7 @@ void libvisio::VSDParser::_handleLevelChange(unsigned level)
 
 // --- READERS ---
 
-void libvisio::VSDParser::readEllipticalArcTo(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readEllipticalArcTo(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double x3 = readDouble(input); // End x
@@ -678,7 +732,7 @@ void libvisio::VSDParser::readEllipticalArcTo(librevenge::RVNGInputStream *input
 }
 
 
-void libvisio::VSDParser::readForeignData(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readForeignData(VSDCursor *input)
 {
   unsigned long tmpBytesRead = 0;
   const unsigned char *buffer = input->read(m_header.dataLength, tmpBytesRead);
@@ -692,11 +746,11 @@ void libvisio::VSDParser::readForeignData(librevenge::RVNGInputStream *input)
   m_shape.m_foreign->data = binaryData;
 }
 
-void libvisio::VSDParser::readOLEList(librevenge::RVNGInputStream * /* input */)
+void libvisio::VSDParser::readOLEList(VSDCursor * /* input */)
 {
 }
 
-void libvisio::VSDParser::readOLEData(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readOLEData(VSDCursor *input)
 {
   unsigned long tmpBytesRead = 0;
   const unsigned char *buffer = input->read(m_header.dataLength, tmpBytesRead);
@@ -711,7 +765,7 @@ void libvisio::VSDParser::readOLEData(librevenge::RVNGInputStream *input)
 
 }
 
-void libvisio::VSDParser::readNameIDX(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readNameIDX(VSDCursor *input)
 {
   std::map<unsigned, VSDName> names;
   unsigned recordCount = readU32(input);
@@ -732,7 +786,7 @@ void libvisio::VSDParser::readNameIDX(librevenge::RVNGInputStream *input)
   m_namesMapMap[m_header.level] = names;
 }
 
-void libvisio::VSDParser::readNameIDX123(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readNameIDX123(VSDCursor *input)
 {
   std::map<unsigned, VSDName> names;
   long endPosition = input->tell() + m_header.dataLength;
@@ -748,7 +802,7 @@ void libvisio::VSDParser::readNameIDX123(librevenge::RVNGInputStream *input)
 
 }
 
-void libvisio::VSDParser::readEllipse(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readEllipse(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double cx = readDouble(input);
@@ -767,7 +821,7 @@ void libvisio::VSDParser::readEllipse(librevenge::RVNGInputStream *input)
     m_currentGeometryList->addEllipse(m_header.id, m_header.level, cx, cy, xleft, yleft, xtop, ytop);
 }
 
-void libvisio::VSDParser::readLine(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readLine(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double strokeWidth = readDouble(input);
@@ -789,7 +843,7 @@ void libvisio::VSDParser::readLine(librevenge::RVNGInputStream *input)
     m_shape.m_lineStyle.override(VSDOptionalLineStyle(strokeWidth, c, linePattern, startMarker, endMarker, lineCap));
 }
 
-void libvisio::VSDParser::readTextBlock(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readTextBlock(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double leftMargin = readDouble(input);
@@ -819,7 +873,7 @@ void libvisio::VSDParser::readTextBlock(librevenge::RVNGInputStream *input)
                                                                 verticalAlign, isBgFilled, c, defaultTabStop, textDirection));
 }
 
-void libvisio::VSDParser::readGeomList(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readGeomList(VSDCursor *input)
 {
   if (!m_shape.m_geometries.empty() && m_currentGeometryList->empty())
     m_shape.m_geometries.erase(--m_currentGeomListCount);
@@ -847,7 +901,7 @@ void libvisio::VSDParser::readGeomList(librevenge::RVNGInputStream *input)
     m_collector->collectUnhandledChunk(m_header.id, m_header.level);
 }
 
-void libvisio::VSDParser::readCharList(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readCharList(VSDCursor *input)
 {
   // We want the collectors to still get the level information
   if (!m_isStencilStarted)
@@ -868,7 +922,7 @@ void libvisio::VSDParser::readCharList(librevenge::RVNGInputStream *input)
 
 }
 
-void libvisio::VSDParser::readParaList(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readParaList(VSDCursor *input)
 {
   // We want the collectors to still get the level information
   if (!m_isStencilStarted)
@@ -888,18 +942,18 @@ void libvisio::VSDParser::readParaList(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readPropList(librevenge::RVNGInputStream * /* input */)
+void libvisio::VSDParser::readPropList(VSDCursor * /* input */)
 {
 }
 
-void libvisio::VSDParser::readPage(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readPage(VSDCursor *input)
 {
   input->seek(8, librevenge::RVNG_SEEK_CUR); //sub header length and children list length
   unsigned backgroundPageID = readU32(input);
   m_collector->collectPage(m_header.id, m_header.level, backgroundPageID, m_isBackgroundPage, m_currentPageName);
 }
 
-void libvisio::VSDParser::readGeometry(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readGeometry(VSDCursor *input)
 {
   unsigned char geomFlags = readU8(input);
   bool noFill = (!!(geomFlags & 1));
@@ -910,7 +964,7 @@ void libvisio::VSDParser::readGeometry(librevenge::RVNGInputStream *input)
     m_currentGeometryList->addGeometry(m_header.id, m_header.level, noFill, noLine, noShow);
 }
 
-void libvisio::VSDParser::readMoveTo(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readMoveTo(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double x = readDouble(input);
@@ -921,7 +975,7 @@ void libvisio::VSDParser::readMoveTo(librevenge::RVNGInputStream *input)
     m_currentGeometryList->addMoveTo(m_header.id, m_header.level, x, y);
 }
 
-void libvisio::VSDParser::readLineTo(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readLineTo(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double x = readDouble(input);
@@ -932,7 +986,7 @@ void libvisio::VSDParser::readLineTo(librevenge::RVNGInputStream *input)
     m_currentGeometryList->addLineTo(m_header.id, m_header.level, x, y);
 }
 
-void libvisio::VSDParser::readArcTo(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readArcTo(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double x2 = readDouble(input);
@@ -945,7 +999,7 @@ void libvisio::VSDParser::readArcTo(librevenge::RVNGInputStream *input)
     m_currentGeometryList->addArcTo(m_header.id, m_header.level, x2, y2, bow);
 }
 
-void libvisio::VSDParser::readXFormData(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readXFormData(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   m_shape.m_xform.pinX = readDouble(input);
@@ -965,7 +1019,7 @@ void libvisio::VSDParser::readXFormData(librevenge::RVNGInputStream *input)
   m_shape.m_xform.flipY = !!readU8(input);
 }
 
-void libvisio::VSDParser::readTxtXForm(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readTxtXForm(VSDCursor *input)
 {
   if (m_shape.m_txtxform)
     delete(m_shape.m_txtxform);
@@ -986,7 +1040,7 @@ void libvisio::VSDParser::readTxtXForm(librevenge::RVNGInputStream *input)
   m_shape.m_txtxform->angle = readDouble(input);
 }
 
-void libvisio::VSDParser::readShapeId(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readShapeId(VSDCursor *input)
 {
   if (!m_isShapeStarted)
     m_shapeList.addShapeId(m_header.id, getUInt(input));
@@ -994,7 +1048,7 @@ void libvisio::VSDParser::readShapeId(librevenge::RVNGInputStream *input)
     m_shape.m_shapeList.addShapeId(m_header.id, getUInt(input));
 }
 
-void libvisio::VSDParser::readShapeList(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readShapeList(VSDCursor *input)
 {
   // We want the collectors to still get the level information
   m_collector->collectUnhandledChunk(m_header.id, m_header.level);
@@ -1016,7 +1070,7 @@ void libvisio::VSDParser::readShapeList(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readForeignDataType(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readForeignDataType(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double imgOffsetX = readDouble(input);
@@ -1044,7 +1098,7 @@ void libvisio::VSDParser::readForeignDataType(librevenge::RVNGInputStream *input
   m_shape.m_foreign->height = imgHeight;
 }
 
-void libvisio::VSDParser::readPageProps(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readPageProps(VSDCursor *input)
 {
   // Skip bytes representing unit to *display* (value is always inches)
   input->seek(1, librevenge::RVNG_SEEK_CUR);
@@ -1068,7 +1122,7 @@ void libvisio::VSDParser::readPageProps(librevenge::RVNGInputStream *input)
   m_collector->collectPageProps(m_header.id, m_header.level, pageWidth, pageHeight, m_shadowOffsetX, m_shadowOffsetY, scale);
 }
 
-void libvisio::VSDParser::readShape(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readShape(VSDCursor *input)
 {
   m_currentGeomListCount = 0;
   m_isShapeStarted = true;
@@ -1124,7 +1178,7 @@ void libvisio::VSDParser::readShape(librevenge::RVNGInputStream *input)
   m_currentShapeID = MINUS_ONE;
 }
 
-void libvisio::VSDParser::readNURBSTo(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readNURBSTo(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double x = readDouble(input);
@@ -1283,7 +1337,7 @@ void libvisio::VSDParser::readNURBSTo(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readPolylineTo(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readPolylineTo(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double x = readDouble(input);
@@ -1382,7 +1436,7 @@ void libvisio::VSDParser::readPolylineTo(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readInfiniteLine(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readInfiniteLine(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double x1 = readDouble(input);
@@ -1396,7 +1450,7 @@ void libvisio::VSDParser::readInfiniteLine(librevenge::RVNGInputStream *input)
     m_currentGeometryList->addInfiniteLine(m_header.id, m_header.level, x1, y1, x2, y2);
 }
 
-void libvisio::VSDParser::readShapeData(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readShapeData(VSDCursor *input)
 {
   unsigned char dataType = readU8(input);
 
@@ -1461,7 +1515,7 @@ void libvisio::VSDParser::readShapeData(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readSplineStart(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readSplineStart(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double x = readDouble(input);
@@ -1476,7 +1530,7 @@ void libvisio::VSDParser::readSplineStart(librevenge::RVNGInputStream *input)
     m_currentGeometryList->addSplineStart(m_header.id, m_header.level, x, y, secondKnot, firstKnot, lastKnot, degree);
 }
 
-void libvisio::VSDParser::readSplineKnot(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readSplineKnot(VSDCursor *input)
 {
   input->seek(1, librevenge::RVNG_SEEK_CUR);
   double x = readDouble(input);
@@ -1488,17 +1542,17 @@ void libvisio::VSDParser::readSplineKnot(librevenge::RVNGInputStream *input)
     m_currentGeometryList->addSplineKnot(m_header.id, m_header.level, x, y, knot);
 }
 
-void libvisio::VSDParser::readNameList(librevenge::RVNGInputStream * /* input */)
+void libvisio::VSDParser::readNameList(VSDCursor * /* input */)
 {
   m_shape.m_names.clear();
 }
 
-void libvisio::VSDParser::readNameList2(librevenge::RVNGInputStream * /* input */)
+void libvisio::VSDParser::readNameList2(VSDCursor * /* input */)
 {
   m_names.clear();
 }
 
-void libvisio::VSDParser::readFieldList(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readFieldList(VSDCursor *input)
 {
   if (m_header.trailer)
   {
@@ -1515,7 +1569,7 @@ void libvisio::VSDParser::readFieldList(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readColours(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readColours(VSDCursor *input)
 {
   input->seek(2, librevenge::RVNG_SEEK_CUR);
   unsigned numColours = readU8(input);
@@ -1534,7 +1588,7 @@ void libvisio::VSDParser::readColours(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readFont(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readFont(VSDCursor *input)
 {
   input->seek(4, librevenge::RVNG_SEEK_CUR);
   librevenge::RVNGBinaryData textStream;
@@ -1551,7 +1605,7 @@ void libvisio::VSDParser::readFont(librevenge::RVNGInputStream *input)
   m_fonts[m_header.id] = VSDName(textStream, libvisio::VSD_TEXT_UTF16);
 }
 
-void libvisio::VSDParser::readFontIX(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readFontIX(VSDCursor *input)
 {
   long tmpAdjust = input->tell();
   input->seek(2, librevenge::RVNG_SEEK_CUR);
@@ -1623,7 +1677,7 @@ void libvisio::VSDParser::readFontIX(librevenge::RVNGInputStream *input)
 
 /* StyleSheet readers */
 
-void libvisio::VSDParser::readStyleSheet(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readStyleSheet(VSDCursor *input)
 {
   input->seek(0x22, librevenge::RVNG_SEEK_CUR);
   unsigned lineStyle = readU32(input);
@@ -1635,13 +1689,13 @@ void libvisio::VSDParser::readStyleSheet(librevenge::RVNGInputStream *input)
   m_collector->collectStyleSheet(m_header.id, m_header.level, lineStyle, fillStyle, textStyle);
 }
 
-void libvisio::VSDParser::readPageSheet(librevenge::RVNGInputStream * /* input */)
+void libvisio::VSDParser::readPageSheet(VSDCursor * /* input */)
 {
   m_currentShapeLevel = m_header.level;
   m_collector->collectPageSheet(m_header.id, m_header.level);
 }
 
-void libvisio::VSDParser::readText(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readText(VSDCursor *input)
 {
   input->seek(8, librevenge::RVNG_SEEK_CUR);
   librevenge::RVNGBinaryData textStream;
@@ -1663,7 +1717,7 @@ void libvisio::VSDParser::readText(librevenge::RVNGInputStream *input)
   m_shape.m_textFormat = libvisio::VSD_TEXT_UTF16;
 }
 
-void libvisio::VSDParser::readCharIX(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readCharIX(VSDCursor *input)
 {
   VSDFont fontFace;
   unsigned charCount = readU32(input);
@@ -1730,7 +1784,7 @@ void libvisio::VSDParser::readCharIX(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readParaIX(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readParaIX(VSDCursor *input)
 {
   unsigned charCount = readU32(input);
   input->seek(1, librevenge::RVNG_SEEK_CUR);
@@ -1767,7 +1821,7 @@ void libvisio::VSDParser::readParaIX(librevenge::RVNGInputStream *input)
 }
 
 
-void libvisio::VSDParser::readFillAndShadow(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readFillAndShadow(VSDCursor *input)
 {
   unsigned char colourFGIndex = readU8(input);
   Colour colourFG;
@@ -1834,7 +1888,7 @@ void libvisio::VSDParser::readFillAndShadow(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readName(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readName(VSDCursor *input)
 {
   unsigned long numBytesRead = 0;
   const unsigned char *tmpBuffer = input->read(m_header.dataLength, numBytesRead);
@@ -1845,7 +1899,7 @@ void libvisio::VSDParser::readName(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readName2(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readName2(VSDCursor *input)
 {
   unsigned short unicharacter = 0;
   librevenge::RVNGBinaryData name;
@@ -1860,7 +1914,7 @@ void libvisio::VSDParser::readName2(librevenge::RVNGInputStream *input)
   m_names[m_header.id] = VSDName(name, libvisio::VSD_TEXT_UTF16);
 }
 
-void libvisio::VSDParser::readTextField(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readTextField(VSDCursor *input)
 {
   unsigned long initialPosition = input->tell();
   input->seek(7, librevenge::RVNG_SEEK_CUR);
@@ -1929,7 +1983,7 @@ void libvisio::VSDParser::readTextField(librevenge::RVNGInputStream *input)
   }
 }
 
-void libvisio::VSDParser::readMisc(librevenge::RVNGInputStream *input)
+void libvisio::VSDParser::readMisc(VSDCursor *input)
 {
   unsigned char flags = readU8(input);
   if (flags & 0x20)
@@ -1945,12 +1999,12 @@ libvisio::Colour libvisio::VSDParser::_colourFromIndex(unsigned idx)
   return libvisio::Colour();
 }
 
-unsigned libvisio::VSDParser::getUInt(librevenge::RVNGInputStream *input)
+unsigned libvisio::VSDParser::getUInt(VSDCursor *input)
 {
   return readU32(input);
 }
 
-int libvisio::VSDParser::getInt(librevenge::RVNGInputStream *input)
+int libvisio::VSDParser::getInt(VSDCursor *input)
 {
   return readS32(input);
 }
@@ -24,10 +24,14 @@
 #include "VSDShapeList.h"
 #include "VSDStencils.h"
 
+class VSDInternalStream;
+
 namespace libvisio
 {
 
 class VSDCollector;
+class VSDCursor;
+class VSDRecordingCollector;
 
 struct Pointer
 {
@@ -52,63 +56,63 @@ public:
 
 protected:
   // reader functions
-  void readEllipticalArcTo(librevenge::RVNGInputStream *input);
-  void readForeignData(librevenge::RVNGInputStream *input);
-  void readEllipse(librevenge::RVNGInputStream *input);
-  virtual void readLine(librevenge::RVNGInputStream *input);
-  virtual void readFillAndShadow(librevenge::RVNGInputStream *input);
-  virtual void readGeomList(librevenge::RVNGInputStream *input);
-  void readGeometry(librevenge::RVNGInputStream *input);
-  void readMoveTo(librevenge::RVNGInputStream *input);
-  void readLineTo(librevenge::RVNGInputStream *input);
-  void readArcTo(librevenge::RVNGInputStream *input);
-  void readNURBSTo(librevenge::RVNGInputStream *input);
-  void readPolylineTo(librevenge::RVNGInputStream *input);
-  void readInfiniteLine(librevenge::RVNGInputStream *input);
-  void readShapeData(librevenge::RVNGInputStream *input);
-  void readXFormData(librevenge::RVNGInputStream *input);
-  void readTxtXForm(librevenge::RVNGInputStream *input);
-  void readShapeId(librevenge::RVNGInputStream *input);
-  virtual void readShapeList(librevenge::RVNGInputStream *input);
-  void readForeignDataType(librevenge::RVNGInputStream *input);
-  void readPageProps(librevenge::RVNGInputStream *input);
-  virtual void readShape(librevenge::RVNGInputStream *input);
-  void readColours(librevenge::RVNGInputStream *input);
-  void readFont(librevenge::RVNGInputStream *input);
-  void readFontIX(librevenge::RVNGInputStream *input);
-  virtual void readCharList(librevenge::RVNGInputStream *input);
-  virtual void readParaList(librevenge::RVNGInputStream *input);
-  virtual void readPropList(librevenge::RVNGInputStream *input);
-  virtual void readPage(librevenge::RVNGInputStream *input);
-  virtual void readText(librevenge::RVNGInputStream *input);
-  virtual void readCharIX(librevenge::RVNGInputStream *input);
-  virtual void readParaIX(librevenge::RVNGInputStream *input);
-  virtual void readTextBlock(librevenge::RVNGInputStream *input);
-
-  void readNameList(librevenge::RVNGInputStream *input);
-  virtual void readName(librevenge::RVNGInputStream *input);
-
-  virtual void readNameList2(librevenge::RVNGInputStream *input);
-  virtual void readName2(librevenge::RVNGInputStream *input);
-
-  virtual void readFieldList(librevenge::RVNGInputStream *input);
-  virtual void readTextField(librevenge::RVNGInputStream *input);
-
-  virtual void readStyleSheet(librevenge::RVNGInputStream *input);
-  void readPageSheet(librevenge::RVNGInputStream *input);
-
-  void readSplineStart(librevenge::RVNGInputStream *input);
-  void readSplineKnot(librevenge::RVNGInputStream *input);
-
-  void readStencilShape(librevenge::RVNGInputStream *input);
-
-  void readOLEList(librevenge::RVNGInputStream *input);
-  void readOLEData(librevenge::RVNGInputStream *input);
-
-  virtual void readNameIDX(librevenge::RVNGInputStream *input);
-  virtual void readNameIDX123(librevenge::RVNGInputStream *input);
-
-  void readMisc(librevenge::RVNGInputStream *input);
+  void readEllipticalArcTo(VSDCursor *input);
+  void readForeignData(VSDCursor *input);
+  void readEllipse(VSDCursor *input);
+  virtual void readLine(VSDCursor *input);
+  virtual void readFillAndShadow(VSDCursor *input);
+  virtual void readGeomList(VSDCursor *input);
+  void readGeometry(VSDCursor *input);
+  void readMoveTo(VSDCursor *input);
+  void readLineTo(VSDCursor *input);
+  void readArcTo(VSDCursor *input);
+  void readNURBSTo(VSDCursor *input);
+  void readPolylineTo(VSDCursor *input);
+  void readInfiniteLine(VSDCursor *input);
+  void readShapeData(VSDCursor *input);
+  void readXFormData(VSDCursor *input);
+  void readTxtXForm(VSDCursor *input);
+  void readShapeId(VSDCursor *input);
+  virtual void readShapeList(VSDCursor *input);
+  void readForeignDataType(VSDCursor *input);
+  void readPageProps(VSDCursor *input);
+  virtual void readShape(VSDCursor *input);
+  void readColours(VSDCursor *input);
+  void readFont(VSDCursor *input);
+  void readFontIX(VSDCursor *input);
+  virtual void readCharList(VSDCursor *input);
+  virtual void readParaList(VSDCursor *input);
+  virtual void readPropList(VSDCursor *input);
+  virtual void readPage(VSDCursor *input);
+  virtual void readText(VSDCursor *input);
+  virtual void readCharIX(VSDCursor *input);
+  virtual void readParaIX(VSDCursor *input);
+  virtual void readTextBlock(VSDCursor *input);
+
+  void readNameList(VSDCursor *input);
+  virtual void readName(VSDCursor *input);
+
+  virtual void readNameList2(VSDCursor *input);
+  virtual void readName2(VSDCursor *input);
+
+  virtual void readFieldList(VSDCursor *input);
+  virtual void readTextField(VSDCursor *input);
+
+  virtual void readStyleSheet(VSDCursor *input);
+  void readPageSheet(VSDCursor *input);
+
+  void readSplineStart(VSDCursor *input);
+  void readSplineKnot(VSDCursor *input);
+
+  void readStencilShape(VSDCursor *input);
+
+  void readOLEList(VSDCursor *input);
+  void readOLEData(VSDCursor *input);
+
+  virtual void readNameIDX(VSDCursor *input);
+  virtual void readNameIDX123(VSDCursor *input);
+
+  void readMisc(VSDCursor *input);
 
   // parser of one pass
   bool parseDocument(librevenge::RVNGInputStream *input, unsigned shift);
@@ -116,25 +120,27 @@ protected:
   // Stream handlers
   void handleStreams(librevenge::RVNGInputStream *input, unsigned ptrType, unsigned shift, unsigned level);
   void handleStream(const Pointer &ptr, unsigned idx, unsigned level);
-  void handleChunks(librevenge::RVNGInputStream *input, unsigned level);
-  void handleChunk(librevenge::RVNGInputStream *input);
-  void handleBlob(librevenge::RVNGInputStream *input, unsigned shift, unsigned level);
+  void handleChunks(VSDInternalStream *input, unsigned level);
+  void handleChunk(VSDCursor *input);
+  void handleBlob(VSDInternalStream *input, unsigned shift, unsigned level);
 
   virtual void readPointer(librevenge::RVNGInputStream *input, Pointer &ptr);
   virtual void readPointerInfo(librevenge::RVNGInputStream *input, unsigned ptrType, unsigned shift, unsigned &listSize, int &pointerCount);
-  virtual bool getChunkHeader(librevenge::RVNGInputStream *input);
+  virtual bool getChunkHeader(VSDCursor *input);
   void _handleLevelChange(unsigned level);
   Colour _colourFromIndex(unsigned idx);
   void _flushShape();
   void _nameFromId(VSDName &name, unsigned id, unsigned level);
+  const std::vector<unsigned char> &_getStreamData(const Pointer &ptr);
 
-  virtual unsigned getUInt(librevenge::RVNGInputStream *input);
-  virtual int getInt(librevenge::RVNGInputStream *input);
+  virtual unsigned getUInt(VSDCursor *input);
+  virtual int getInt(VSDCursor *input);
 
   librevenge::RVNGInputStream *m_input;
   librevenge::RVNGDrawingInterface *m_painter;
   ChunkHeader m_header;
   VSDCollector *m_collector;
+  VSDRecordingCollector *m_recorder;
   VSDShapeList m_shapeList;
   unsigned m_currentLevel;
 
@@ -163,6 +169,9 @@ protected:
   std::map<unsigned, std::map<unsigned, VSDName> > m_namesMapMap;
   VSDName m_currentPageName;
 
+  // Streams read (and decompressed) by offset and length, reused by the second pass
+  std::map<std::pair<unsigned, unsigned>, std::vector<unsigned char> > m_streamCache;
+
 private:
   VSDParser();
   VSDParser(const VSDParser &);
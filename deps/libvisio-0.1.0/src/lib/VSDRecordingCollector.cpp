@@ -0,0 +1,1855 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libvisio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "VSDRecordingCollector.h"
+
+namespace libvisio
+{
+
+// One call of a collector method, with copies of its arguments
+class VSDCollectorEvent
+{
+public:
+  VSDCollectorEvent() {}
+  virtual ~VSDCollectorEvent() {}
+  virtual void replay(VSDCollector *collector) const = 0;
+};
+
+namespace
+{
+
+class EllipticalArcToEvent : public VSDCollectorEvent
+{
+public:
+  EllipticalArcToEvent(unsigned id, unsigned level, double x3, double y3, double x2, double y2, double angle, double ecc)
+    : m_id(id), m_level(level), m_x3(x3), m_y3(y3), m_x2(x2), m_y2(y2), m_angle(angle), m_ecc(ecc) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectEllipticalArcTo(m_id, m_level, m_x3, m_y3, m_x2, m_y2, m_angle, m_ecc);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x3;
+  double m_y3;
+  double m_x2;
+  double m_y2;
+  double m_angle;
+  double m_ecc;
+};
+
+class ForeignDataEvent : public VSDCollectorEvent
+{
+public:
+  ForeignDataEvent(unsigned level, const librevenge::RVNGBinaryData &binaryData)
+    : m_level(level), m_binaryData(binaryData) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectForeignData(m_level, m_binaryData);
+  }
+
+private:
+  unsigned m_level;
+  librevenge::RVNGBinaryData m_binaryData;
+};
+
+class OLEListEvent : public VSDCollectorEvent
+{
+public:
+  OLEListEvent(unsigned id, unsigned level)
+    : m_id(id), m_level(level) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectOLEList(m_id, m_level);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+};
+
+class OLEDataEvent : public VSDCollectorEvent
+{
+public:
+  OLEDataEvent(unsigned id, unsigned level, const librevenge::RVNGBinaryData &oleData)
+    : m_id(id), m_level(level), m_oleData(oleData) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectOLEData(m_id, m_level, m_oleData);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  librevenge::RVNGBinaryData m_oleData;
+};
+
+class EllipseEvent : public VSDCollectorEvent
+{
+public:
+  EllipseEvent(unsigned id, unsigned level, double cx, double cy, double xleft, double yleft, double xtop, double ytop)
+    : m_id(id), m_level(level), m_cx(cx), m_cy(cy), m_xleft(xleft), m_yleft(yleft), m_xtop(xtop), m_ytop(ytop) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectEllipse(m_id, m_level, m_cx, m_cy, m_xleft, m_yleft, m_xtop, m_ytop);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_cx;
+  double m_cy;
+  double m_xleft;
+  double m_yleft;
+  double m_xtop;
+  double m_ytop;
+};
+
+class LineEvent : public VSDCollectorEvent
+{
+public:
+  LineEvent(unsigned level, const boost::optional<double> &strokeWidth, const boost::optional<Colour> &c,
+            const boost::optional<unsigned char> &linePattern, const boost::optional<unsigned char> &startMarker,
+            const boost::optional<unsigned char> &endMarker, const boost::optional<unsigned char> &lineCap)
+    : m_level(level), m_strokeWidth(strokeWidth), m_c(c), m_linePattern(linePattern), m_startMarker(startMarker), m_endMarker(endMarker),
+      m_lineCap(lineCap) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectLine(m_level, m_strokeWidth, m_c, m_linePattern, m_startMarker, m_endMarker, m_lineCap);
+  }
+
+private:
+  unsigned m_level;
+  boost::optional<double> m_strokeWidth;
+  boost::optional<Colour> m_c;
+  boost::optional<unsigned char> m_linePattern;
+  boost::optional<unsigned char> m_startMarker;
+  boost::optional<unsigned char> m_endMarker;
+  boost::optional<unsigned char> m_lineCap;
+};
+
+class FillAndShadowEvent : public VSDCollectorEvent
+{
+public:
+  FillAndShadowEvent(unsigned level, const boost::optional<Colour> &colourFG, const boost::optional<Colour> &colourBG,
+                     const boost::optional<unsigned char> &fillPattern, const boost::optional<double> &fillFGTransparency,
+                     const boost::optional<double> &fillBGTransparency, const boost::optional<unsigned char> &shadowPattern,
+                     const boost::optional<Colour> &shfgc, const boost::optional<double> &shadowOffsetX, const boost::optional<double> &shadowOffsetY)
+    : m_level(level), m_colourFG(colourFG), m_colourBG(colourBG), m_fillPattern(fillPattern), m_fillFGTransparency(fillFGTransparency),
+      m_fillBGTransparency(fillBGTransparency), m_shadowPattern(shadowPattern), m_shfgc(shfgc), m_shadowOffsetX(shadowOffsetX),
+      m_shadowOffsetY(shadowOffsetY) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectFillAndShadow(m_level, m_colourFG, m_colourBG, m_fillPattern, m_fillFGTransparency, m_fillBGTransparency, m_shadowPattern,
+                                    m_shfgc, m_shadowOffsetX, m_shadowOffsetY);
+  }
+
+private:
+  unsigned m_level;
+  boost::optional<Colour> m_colourFG;
+  boost::optional<Colour> m_colourBG;
+  boost::optional<unsigned char> m_fillPattern;
+  boost::optional<double> m_fillFGTransparency;
+  boost::optional<double> m_fillBGTransparency;
+  boost::optional<unsigned char> m_shadowPattern;
+  boost::optional<Colour> m_shfgc;
+  boost::optional<double> m_shadowOffsetX;
+  boost::optional<double> m_shadowOffsetY;
+};
+
+class FillAndShadowWithoutOffsetEvent : public VSDCollectorEvent
+{
+public:
+  FillAndShadowWithoutOffsetEvent(unsigned level, const boost::optional<Colour> &colourFG, const boost::optional<Colour> &colourBG,
+                                  const boost::optional<unsigned char> &fillPattern, const boost::optional<double> &fillFGTransparency,
+                                  const boost::optional<double> &fillBGTransparency, const boost::optional<unsigned char> &shadowPattern,
+                                  const boost::optional<Colour> &shfgc)
+    : m_level(level), m_colourFG(colourFG), m_colourBG(colourBG), m_fillPattern(fillPattern), m_fillFGTransparency(fillFGTransparency),
+      m_fillBGTransparency(fillBGTransparency), m_shadowPattern(shadowPattern), m_shfgc(shfgc) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectFillAndShadow(m_level, m_colourFG, m_colourBG, m_fillPattern, m_fillFGTransparency, m_fillBGTransparency, m_shadowPattern,
+                                    m_shfgc);
+  }
+
+private:
+  unsigned m_level;
+  boost::optional<Colour> m_colourFG;
+  boost::optional<Colour> m_colourBG;
+  boost::optional<unsigned char> m_fillPattern;
+  boost::optional<double> m_fillFGTransparency;
+  boost::optional<double> m_fillBGTransparency;
+  boost::optional<unsigned char> m_shadowPattern;
+  boost::optional<Colour> m_shfgc;
+};
+
+class ThemeReferenceEvent : public VSDCollectorEvent
+{
+public:
+  ThemeReferenceEvent(unsigned level, const boost::optional<long> &lineColour, const boost::optional<long> &fillColour,
+                      const boost::optional<long> &shadowColour, const boost::optional<long> &fontColour)
+    : m_level(level), m_lineColour(lineColour), m_fillColour(fillColour), m_shadowColour(shadowColour), m_fontColour(fontColour) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectThemeReference(m_level, m_lineColour, m_fillColour, m_shadowColour, m_fontColour);
+  }
+
+private:
+  unsigned m_level;
+  boost::optional<long> m_lineColour;
+  boost::optional<long> m_fillColour;
+  boost::optional<long> m_shadowColour;
+  boost::optional<long> m_fontColour;
+};
+
+class GeometryEvent : public VSDCollectorEvent
+{
+public:
+  GeometryEvent(unsigned id, unsigned level, bool noFill, bool noLine, bool noShow)
+    : m_id(id), m_level(level), m_noFill(noFill), m_noLine(noLine), m_noShow(noShow) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectGeometry(m_id, m_level, m_noFill, m_noLine, m_noShow);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  bool m_noFill;
+  bool m_noLine;
+  bool m_noShow;
+};
+
+class MoveToEvent : public VSDCollectorEvent
+{
+public:
+  MoveToEvent(unsigned id, unsigned level, double x, double y)
+    : m_id(id), m_level(level), m_x(x), m_y(y) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectMoveTo(m_id, m_level, m_x, m_y);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+};
+
+class LineToEvent : public VSDCollectorEvent
+{
+public:
+  LineToEvent(unsigned id, unsigned level, double x, double y)
+    : m_id(id), m_level(level), m_x(x), m_y(y) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectLineTo(m_id, m_level, m_x, m_y);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+};
+
+class ArcToEvent : public VSDCollectorEvent
+{
+public:
+  ArcToEvent(unsigned id, unsigned level, double x2, double y2, double bow)
+    : m_id(id), m_level(level), m_x2(x2), m_y2(y2), m_bow(bow) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectArcTo(m_id, m_level, m_x2, m_y2, m_bow);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x2;
+  double m_y2;
+  double m_bow;
+};
+
+class NURBSToEvent : public VSDCollectorEvent
+{
+public:
+  NURBSToEvent(unsigned id, unsigned level, double x2, double y2, unsigned char xType, unsigned char yType, unsigned degree,
+               const std::vector<std::pair<double, double> > &ctrlPnts, const std::vector<double> &kntVec, const std::vector<double> &weights)
+    : m_id(id), m_level(level), m_x2(x2), m_y2(y2), m_xType(xType), m_yType(yType), m_degree(degree), m_ctrlPnts(ctrlPnts), m_kntVec(kntVec),
+      m_weights(weights) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectNURBSTo(m_id, m_level, m_x2, m_y2, m_xType, m_yType, m_degree, m_ctrlPnts, m_kntVec, m_weights);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x2;
+  double m_y2;
+  unsigned char m_xType;
+  unsigned char m_yType;
+  unsigned m_degree;
+  std::vector<std::pair<double, double> > m_ctrlPnts;
+  std::vector<double> m_kntVec;
+  std::vector<double> m_weights;
+};
+
+class NURBSToDataIDEvent : public VSDCollectorEvent
+{
+public:
+  NURBSToDataIDEvent(unsigned id, unsigned level, double x2, double y2, double knot, double knotPrev, double weight, double weightPrev,
+                     unsigned dataID)
+    : m_id(id), m_level(level), m_x2(x2), m_y2(y2), m_knot(knot), m_knotPrev(knotPrev), m_weight(weight), m_weightPrev(weightPrev), m_dataID(dataID) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectNURBSTo(m_id, m_level, m_x2, m_y2, m_knot, m_knotPrev, m_weight, m_weightPrev, m_dataID);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x2;
+  double m_y2;
+  double m_knot;
+  double m_knotPrev;
+  double m_weight;
+  double m_weightPrev;
+  unsigned m_dataID;
+};
+
+class NURBSToDataEvent : public VSDCollectorEvent
+{
+public:
+  NURBSToDataEvent(unsigned id, unsigned level, double x2, double y2, double knot, double knotPrev, double weight, double weightPrev,
+                   const NURBSData &data)
+    : m_id(id), m_level(level), m_x2(x2), m_y2(y2), m_knot(knot), m_knotPrev(knotPrev), m_weight(weight), m_weightPrev(weightPrev), m_data(data) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectNURBSTo(m_id, m_level, m_x2, m_y2, m_knot, m_knotPrev, m_weight, m_weightPrev, m_data);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x2;
+  double m_y2;
+  double m_knot;
+  double m_knotPrev;
+  double m_weight;
+  double m_weightPrev;
+  NURBSData m_data;
+};
+
+class PolylineToEvent : public VSDCollectorEvent
+{
+public:
+  PolylineToEvent(unsigned id, unsigned level, double x, double y, unsigned char xType, unsigned char yType,
+                  const std::vector<std::pair<double, double> > &points)
+    : m_id(id), m_level(level), m_x(x), m_y(y), m_xType(xType), m_yType(yType), m_points(points) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectPolylineTo(m_id, m_level, m_x, m_y, m_xType, m_yType, m_points);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+  unsigned char m_xType;
+  unsigned char m_yType;
+  std::vector<std::pair<double, double> > m_points;
+};
+
+class PolylineToDataIDEvent : public VSDCollectorEvent
+{
+public:
+  PolylineToDataIDEvent(unsigned id, unsigned level, double x, double y, unsigned dataID)
+    : m_id(id), m_level(level), m_x(x), m_y(y), m_dataID(dataID) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectPolylineTo(m_id, m_level, m_x, m_y, m_dataID);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+  unsigned m_dataID;
+};
+
+class PolylineToDataEvent : public VSDCollectorEvent
+{
+public:
+  PolylineToDataEvent(unsigned id, unsigned level, double x, double y, const PolylineData &data)
+    : m_id(id), m_level(level), m_x(x), m_y(y), m_data(data) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectPolylineTo(m_id, m_level, m_x, m_y, m_data);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+  PolylineData m_data;
+};
+
+class NURBSShapeDataEvent : public VSDCollectorEvent
+{
+public:
+  NURBSShapeDataEvent(unsigned id, unsigned level, unsigned char xType, unsigned char yType, unsigned degree, double lastKnot,
+                      std::vector<std::pair<double, double> > controlPoints, std::vector<double> knotVector, std::vector<double> weights)
+    : m_id(id), m_level(level), m_xType(xType), m_yType(yType), m_degree(degree), m_lastKnot(lastKnot), m_controlPoints(controlPoints),
+      m_knotVector(knotVector), m_weights(weights) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectShapeData(m_id, m_level, m_xType, m_yType, m_degree, m_lastKnot, m_controlPoints, m_knotVector, m_weights);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  unsigned char m_xType;
+  unsigned char m_yType;
+  unsigned m_degree;
+  double m_lastKnot;
+  std::vector<std::pair<double, double> > m_controlPoints;
+  std::vector<double> m_knotVector;
+  std::vector<double> m_weights;
+};
+
+class PolylineShapeDataEvent : public VSDCollectorEvent
+{
+public:
+  PolylineShapeDataEvent(unsigned id, unsigned level, unsigned char xType, unsigned char yType, std::vector<std::pair<double, double> > points)
+    : m_id(id), m_level(level), m_xType(xType), m_yType(yType), m_points(points) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectShapeData(m_id, m_level, m_xType, m_yType, m_points);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  unsigned char m_xType;
+  unsigned char m_yType;
+  std::vector<std::pair<double, double> > m_points;
+};
+
+class XFormDataEvent : public VSDCollectorEvent
+{
+public:
+  XFormDataEvent(unsigned level, const XForm &xform)
+    : m_level(level), m_xform(xform) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectXFormData(m_level, m_xform);
+  }
+
+private:
+  unsigned m_level;
+  XForm m_xform;
+};
+
+class TxtXFormEvent : public VSDCollectorEvent
+{
+public:
+  TxtXFormEvent(unsigned level, const XForm &txtxform)
+    : m_level(level), m_txtxform(txtxform) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectTxtXForm(m_level, m_txtxform);
+  }
+
+private:
+  unsigned m_level;
+  XForm m_txtxform;
+};
+
+class ShapesOrderEvent : public VSDCollectorEvent
+{
+public:
+  ShapesOrderEvent(unsigned id, unsigned level, const std::vector<unsigned> &shapeIds)
+    : m_id(id), m_level(level), m_shapeIds(shapeIds) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectShapesOrder(m_id, m_level, m_shapeIds);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  std::vector<unsigned> m_shapeIds;
+};
+
+class ForeignDataTypeEvent : public VSDCollectorEvent
+{
+public:
+  ForeignDataTypeEvent(unsigned level, unsigned foreignType, unsigned foreignFormat, double offsetX, double offsetY, double width, double height)
+    : m_level(level), m_foreignType(foreignType), m_foreignFormat(foreignFormat), m_offsetX(offsetX), m_offsetY(offsetY), m_width(width),
+      m_height(height) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectForeignDataType(m_level, m_foreignType, m_foreignFormat, m_offsetX, m_offsetY, m_width, m_height);
+  }
+
+private:
+  unsigned m_level;
+  unsigned m_foreignType;
+  unsigned m_foreignFormat;
+  double m_offsetX;
+  double m_offsetY;
+  double m_width;
+  double m_height;
+};
+
+class PagePropsEvent : public VSDCollectorEvent
+{
+public:
+  PagePropsEvent(unsigned id, unsigned level, double pageWidth, double pageHeight, double shadowOffsetX, double shadowOffsetY, double scale)
+    : m_id(id), m_level(level), m_pageWidth(pageWidth), m_pageHeight(pageHeight), m_shadowOffsetX(shadowOffsetX), m_shadowOffsetY(shadowOffsetY),
+      m_scale(scale) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectPageProps(m_id, m_level, m_pageWidth, m_pageHeight, m_shadowOffsetX, m_shadowOffsetY, m_scale);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_pageWidth;
+  double m_pageHeight;
+  double m_shadowOffsetX;
+  double m_shadowOffsetY;
+  double m_scale;
+};
+
+class PageEvent : public VSDCollectorEvent
+{
+public:
+  PageEvent(unsigned id, unsigned level, unsigned backgroundPageID, bool isBackgroundPage, const VSDName &pageName)
+    : m_id(id), m_level(level), m_backgroundPageID(backgroundPageID), m_isBackgroundPage(isBackgroundPage), m_pageName(pageName) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectPage(m_id, m_level, m_backgroundPageID, m_isBackgroundPage, m_pageName);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  unsigned m_backgroundPageID;
+  bool m_isBackgroundPage;
+  VSDName m_pageName;
+};
+
+class ShapeEvent : public VSDCollectorEvent
+{
+public:
+  ShapeEvent(unsigned id, unsigned level, unsigned parent, unsigned masterPage, unsigned masterShape, unsigned lineStyle, unsigned fillStyle,
+             unsigned textStyle)
+    : m_id(id), m_level(level), m_parent(parent), m_masterPage(masterPage), m_masterShape(masterShape), m_lineStyle(lineStyle),
+      m_fillStyle(fillStyle), m_textStyle(textStyle) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectShape(m_id, m_level, m_parent, m_masterPage, m_masterShape, m_lineStyle, m_fillStyle, m_textStyle);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  unsigned m_parent;
+  unsigned m_masterPage;
+  unsigned m_masterShape;
+  unsigned m_lineStyle;
+  unsigned m_fillStyle;
+  unsigned m_textStyle;
+};
+
+class SplineStartEvent : public VSDCollectorEvent
+{
+public:
+  SplineStartEvent(unsigned id, unsigned level, double x, double y, double secondKnot, double firstKnot, double lastKnot, unsigned degree)
+    : m_id(id), m_level(level), m_x(x), m_y(y), m_secondKnot(secondKnot), m_firstKnot(firstKnot), m_lastKnot(lastKnot), m_degree(degree) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectSplineStart(m_id, m_level, m_x, m_y, m_secondKnot, m_firstKnot, m_lastKnot, m_degree);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+  double m_secondKnot;
+  double m_firstKnot;
+  double m_lastKnot;
+  unsigned m_degree;
+};
+
+class SplineKnotEvent : public VSDCollectorEvent
+{
+public:
+  SplineKnotEvent(unsigned id, unsigned level, double x, double y, double knot)
+    : m_id(id), m_level(level), m_x(x), m_y(y), m_knot(knot) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectSplineKnot(m_id, m_level, m_x, m_y, m_knot);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+  double m_knot;
+};
+
+class SplineEndEvent : public VSDCollectorEvent
+{
+public:
+  SplineEndEvent() {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectSplineEnd();
+  }
+};
+
+class InfiniteLineEvent : public VSDCollectorEvent
+{
+public:
+  InfiniteLineEvent(unsigned id, unsigned level, double x1, double y1, double x2, double y2)
+    : m_id(id), m_level(level), m_x1(x1), m_y1(y1), m_x2(x2), m_y2(y2) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectInfiniteLine(m_id, m_level, m_x1, m_y1, m_x2, m_y2);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x1;
+  double m_y1;
+  double m_x2;
+  double m_y2;
+};
+
+class RelCubBezToEvent : public VSDCollectorEvent
+{
+public:
+  RelCubBezToEvent(unsigned id, unsigned level, double x, double y, double a, double b, double c, double d)
+    : m_id(id), m_level(level), m_x(x), m_y(y), m_a(a), m_b(b), m_c(c), m_d(d) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectRelCubBezTo(m_id, m_level, m_x, m_y, m_a, m_b, m_c, m_d);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+  double m_a;
+  double m_b;
+  double m_c;
+  double m_d;
+};
+
+class RelEllipticalArcToEvent : public VSDCollectorEvent
+{
+public:
+  RelEllipticalArcToEvent(unsigned id, unsigned level, double x, double y, double a, double b, double c, double d)
+    : m_id(id), m_level(level), m_x(x), m_y(y), m_a(a), m_b(b), m_c(c), m_d(d) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectRelEllipticalArcTo(m_id, m_level, m_x, m_y, m_a, m_b, m_c, m_d);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+  double m_a;
+  double m_b;
+  double m_c;
+  double m_d;
+};
+
+class RelLineToEvent : public VSDCollectorEvent
+{
+public:
+  RelLineToEvent(unsigned id, unsigned level, double x, double y)
+    : m_id(id), m_level(level), m_x(x), m_y(y) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectRelLineTo(m_id, m_level, m_x, m_y);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+};
+
+class RelMoveToEvent : public VSDCollectorEvent
+{
+public:
+  RelMoveToEvent(unsigned id, unsigned level, double x, double y)
+    : m_id(id), m_level(level), m_x(x), m_y(y) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectRelMoveTo(m_id, m_level, m_x, m_y);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+};
+
+class RelQuadBezToEvent : public VSDCollectorEvent
+{
+public:
+  RelQuadBezToEvent(unsigned id, unsigned level, double x, double y, double a, double b)
+    : m_id(id), m_level(level), m_x(x), m_y(y), m_a(a), m_b(b) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectRelQuadBezTo(m_id, m_level, m_x, m_y, m_a, m_b);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  double m_x;
+  double m_y;
+  double m_a;
+  double m_b;
+};
+
+class UnhandledChunkEvent : public VSDCollectorEvent
+{
+public:
+  UnhandledChunkEvent(unsigned id, unsigned level)
+    : m_id(id), m_level(level) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectUnhandledChunk(m_id, m_level);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+};
+
+class TextEvent : public VSDCollectorEvent
+{
+public:
+  TextEvent(unsigned level, const librevenge::RVNGBinaryData &textStream, TextFormat format)
+    : m_level(level), m_textStream(textStream), m_format(format) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectText(m_level, m_textStream, m_format);
+  }
+
+private:
+  unsigned m_level;
+  librevenge::RVNGBinaryData m_textStream;
+  TextFormat m_format;
+};
+
+class CharIXEvent : public VSDCollectorEvent
+{
+public:
+  CharIXEvent(unsigned id, unsigned level, unsigned charCount, const boost::optional<VSDName> &font, const boost::optional<Colour> &fontColour,
+              const boost::optional<double> &fontSize, const boost::optional<bool> &bold, const boost::optional<bool> &italic,
+              const boost::optional<bool> &underline, const boost::optional<bool> &doubleunderline, const boost::optional<bool> &strikeout,
+              const boost::optional<bool> &doublestrikeout, const boost::optional<bool> &allcaps, const boost::optional<bool> &initcaps,
+              const boost::optional<bool> &smallcaps, const boost::optional<bool> &superscript, const boost::optional<bool> &subscript)
+    : m_id(id), m_level(level), m_charCount(charCount), m_font(font), m_fontColour(fontColour), m_fontSize(fontSize), m_bold(bold), m_italic(italic),
+      m_underline(underline), m_doubleunderline(doubleunderline), m_strikeout(strikeout), m_doublestrikeout(doublestrikeout), m_allcaps(allcaps),
+      m_initcaps(initcaps), m_smallcaps(smallcaps), m_superscript(superscript), m_subscript(subscript) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectCharIX(m_id, m_level, m_charCount, m_font, m_fontColour, m_fontSize, m_bold, m_italic, m_underline, m_doubleunderline,
+                             m_strikeout, m_doublestrikeout, m_allcaps, m_initcaps, m_smallcaps, m_superscript, m_subscript);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  unsigned m_charCount;
+  boost::optional<VSDName> m_font;
+  boost::optional<Colour> m_fontColour;
+  boost::optional<double> m_fontSize;
+  boost::optional<bool> m_bold;
+  boost::optional<bool> m_italic;
+  boost::optional<bool> m_underline;
+  boost::optional<bool> m_doubleunderline;
+  boost::optional<bool> m_strikeout;
+  boost::optional<bool> m_doublestrikeout;
+  boost::optional<bool> m_allcaps;
+  boost::optional<bool> m_initcaps;
+  boost::optional<bool> m_smallcaps;
+  boost::optional<bool> m_superscript;
+  boost::optional<bool> m_subscript;
+};
+
+class DefaultCharStyleEvent : public VSDCollectorEvent
+{
+public:
+  DefaultCharStyleEvent(unsigned charCount, const boost::optional<VSDName> &font, const boost::optional<Colour> &fontColour,
+                        const boost::optional<double> &fontSize, const boost::optional<bool> &bold, const boost::optional<bool> &italic,
+                        const boost::optional<bool> &underline, const boost::optional<bool> &doubleunderline, const boost::optional<bool> &strikeout,
+                        const boost::optional<bool> &doublestrikeout, const boost::optional<bool> &allcaps, const boost::optional<bool> &initcaps,
+                        const boost::optional<bool> &smallcaps, const boost::optional<bool> &superscript, const boost::optional<bool> &subscript)
+    : m_charCount(charCount), m_font(font), m_fontColour(fontColour), m_fontSize(fontSize), m_bold(bold), m_italic(italic), m_underline(underline),
+      m_doubleunderline(doubleunderline), m_strikeout(strikeout), m_doublestrikeout(doublestrikeout), m_allcaps(allcaps), m_initcaps(initcaps),
+      m_smallcaps(smallcaps), m_superscript(superscript), m_subscript(subscript) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectDefaultCharStyle(m_charCount, m_font, m_fontColour, m_fontSize, m_bold, m_italic, m_underline, m_doubleunderline, m_strikeout,
+                                       m_doublestrikeout, m_allcaps, m_initcaps, m_smallcaps, m_superscript, m_subscript);
+  }
+
+private:
+  unsigned m_charCount;
+  boost::optional<VSDName> m_font;
+  boost::optional<Colour> m_fontColour;
+  boost::optional<double> m_fontSize;
+  boost::optional<bool> m_bold;
+  boost::optional<bool> m_italic;
+  boost::optional<bool> m_underline;
+  boost::optional<bool> m_doubleunderline;
+  boost::optional<bool> m_strikeout;
+  boost::optional<bool> m_doublestrikeout;
+  boost::optional<bool> m_allcaps;
+  boost::optional<bool> m_initcaps;
+  boost::optional<bool> m_smallcaps;
+  boost::optional<bool> m_superscript;
+  boost::optional<bool> m_subscript;
+};
+
+class ParaIXEvent : public VSDCollectorEvent
+{
+public:
+  ParaIXEvent(unsigned id, unsigned level, unsigned charCount, const boost::optional<double> &indFirst, const boost::optional<double> &indLeft,
+              const boost::optional<double> &indRight, const boost::optional<double> &spLine, const boost::optional<double> &spBefore,
+              const boost::optional<double> &spAfter, const boost::optional<unsigned char> &align, const boost::optional<unsigned> &flags)
+    : m_id(id), m_level(level), m_charCount(charCount), m_indFirst(indFirst), m_indLeft(indLeft), m_indRight(indRight), m_spLine(spLine),
+      m_spBefore(spBefore), m_spAfter(spAfter), m_align(align), m_flags(flags) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectParaIX(m_id, m_level, m_charCount, m_indFirst, m_indLeft, m_indRight, m_spLine, m_spBefore, m_spAfter, m_align, m_flags);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  unsigned m_charCount;
+  boost::optional<double> m_indFirst;
+  boost::optional<double> m_indLeft;
+  boost::optional<double> m_indRight;
+  boost::optional<double> m_spLine;
+  boost::optional<double> m_spBefore;
+  boost::optional<double> m_spAfter;
+  boost::optional<unsigned char> m_align;
+  boost::optional<unsigned> m_flags;
+};
+
+class DefaultParaStyleEvent : public VSDCollectorEvent
+{
+public:
+  DefaultParaStyleEvent(unsigned charCount, const boost::optional<double> &indFirst, const boost::optional<double> &indLeft,
+                        const boost::optional<double> &indRight, const boost::optional<double> &spLine, const boost::optional<double> &spBefore,
+                        const boost::optional<double> &spAfter, const boost::optional<unsigned char> &align, const boost::optional<unsigned> &flags)
+    : m_charCount(charCount), m_indFirst(indFirst), m_indLeft(indLeft), m_indRight(indRight), m_spLine(spLine), m_spBefore(spBefore),
+      m_spAfter(spAfter), m_align(align), m_flags(flags) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectDefaultParaStyle(m_charCount, m_indFirst, m_indLeft, m_indRight, m_spLine, m_spBefore, m_spAfter, m_align, m_flags);
+  }
+
+private:
+  unsigned m_charCount;
+  boost::optional<double> m_indFirst;
+  boost::optional<double> m_indLeft;
+  boost::optional<double> m_indRight;
+  boost::optional<double> m_spLine;
+  boost::optional<double> m_spBefore;
+  boost::optional<double> m_spAfter;
+  boost::optional<unsigned char> m_align;
+  boost::optional<unsigned> m_flags;
+};
+
+class TextBlockEvent : public VSDCollectorEvent
+{
+public:
+  TextBlockEvent(unsigned level, const boost::optional<double> &leftMargin, const boost::optional<double> &rightMargin,
+                 const boost::optional<double> &topMargin, const boost::optional<double> &bottomMargin,
+                 const boost::optional<unsigned char> &verticalAlign, const boost::optional<bool> &isBgFilled,
+                 const boost::optional<Colour> &bgColour, const boost::optional<double> &defaultTabStop,
+                 const boost::optional<unsigned char> &textDirection)
+    : m_level(level), m_leftMargin(leftMargin), m_rightMargin(rightMargin), m_topMargin(topMargin), m_bottomMargin(bottomMargin),
+      m_verticalAlign(verticalAlign), m_isBgFilled(isBgFilled), m_bgColour(bgColour), m_defaultTabStop(defaultTabStop), m_textDirection(textDirection) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectTextBlock(m_level, m_leftMargin, m_rightMargin, m_topMargin, m_bottomMargin, m_verticalAlign, m_isBgFilled, m_bgColour,
+                                m_defaultTabStop, m_textDirection);
+  }
+
+private:
+  unsigned m_level;
+  boost::optional<double> m_leftMargin;
+  boost::optional<double> m_rightMargin;
+  boost::optional<double> m_topMargin;
+  boost::optional<double> m_bottomMargin;
+  boost::optional<unsigned char> m_verticalAlign;
+  boost::optional<bool> m_isBgFilled;
+  boost::optional<Colour> m_bgColour;
+  boost::optional<double> m_defaultTabStop;
+  boost::optional<unsigned char> m_textDirection;
+};
+
+class NameListEvent : public VSDCollectorEvent
+{
+public:
+  NameListEvent(unsigned id, unsigned level)
+    : m_id(id), m_level(level) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectNameList(m_id, m_level);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+};
+
+class NameEvent : public VSDCollectorEvent
+{
+public:
+  NameEvent(unsigned id, unsigned level, const librevenge::RVNGBinaryData &name, TextFormat format)
+    : m_id(id), m_level(level), m_name(name), m_format(format) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectName(m_id, m_level, m_name, m_format);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  librevenge::RVNGBinaryData m_name;
+  TextFormat m_format;
+};
+
+class PageSheetEvent : public VSDCollectorEvent
+{
+public:
+  PageSheetEvent(unsigned id, unsigned level)
+    : m_id(id), m_level(level) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectPageSheet(m_id, m_level);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+};
+
+class MiscEvent : public VSDCollectorEvent
+{
+public:
+  MiscEvent(unsigned level, const VSDMisc &misc)
+    : m_level(level), m_misc(misc) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectMisc(m_level, m_misc);
+  }
+
+private:
+  unsigned m_level;
+  VSDMisc m_misc;
+};
+
+class StyleSheetEvent : public VSDCollectorEvent
+{
+public:
+  StyleSheetEvent(unsigned id, unsigned level, unsigned parentLineStyle, unsigned parentFillStyle, unsigned parentTextStyle)
+    : m_id(id), m_level(level), m_parentLineStyle(parentLineStyle), m_parentFillStyle(parentFillStyle), m_parentTextStyle(parentTextStyle) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectStyleSheet(m_id, m_level, m_parentLineStyle, m_parentFillStyle, m_parentTextStyle);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  unsigned m_parentLineStyle;
+  unsigned m_parentFillStyle;
+  unsigned m_parentTextStyle;
+};
+
+class LineStyleEvent : public VSDCollectorEvent
+{
+public:
+  LineStyleEvent(unsigned level, const boost::optional<double> &strokeWidth, const boost::optional<Colour> &c,
+                 const boost::optional<unsigned char> &linePattern, const boost::optional<unsigned char> &startMarker,
+                 const boost::optional<unsigned char> &endMarker, const boost::optional<unsigned char> &lineCap)
+    : m_level(level), m_strokeWidth(strokeWidth), m_c(c), m_linePattern(linePattern), m_startMarker(startMarker), m_endMarker(endMarker),
+      m_lineCap(lineCap) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectLineStyle(m_level, m_strokeWidth, m_c, m_linePattern, m_startMarker, m_endMarker, m_lineCap);
+  }
+
+private:
+  unsigned m_level;
+  boost::optional<double> m_strokeWidth;
+  boost::optional<Colour> m_c;
+  boost::optional<unsigned char> m_linePattern;
+  boost::optional<unsigned char> m_startMarker;
+  boost::optional<unsigned char> m_endMarker;
+  boost::optional<unsigned char> m_lineCap;
+};
+
+class FillStyleEvent : public VSDCollectorEvent
+{
+public:
+  FillStyleEvent(unsigned level, const boost::optional<Colour> &colourFG, const boost::optional<Colour> &colourBG,
+                 const boost::optional<unsigned char> &fillPattern, const boost::optional<double> &fillFGTransparency,
+                 const boost::optional<double> &fillBGTransparency, const boost::optional<unsigned char> &shadowPattern,
+                 const boost::optional<Colour> &shfgc, const boost::optional<double> &shadowOffsetX, const boost::optional<double> &shadowOffsetY)
+    : m_level(level), m_colourFG(colourFG), m_colourBG(colourBG), m_fillPattern(fillPattern), m_fillFGTransparency(fillFGTransparency),
+      m_fillBGTransparency(fillBGTransparency), m_shadowPattern(shadowPattern), m_shfgc(shfgc), m_shadowOffsetX(shadowOffsetX),
+      m_shadowOffsetY(shadowOffsetY) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectFillStyle(m_level, m_colourFG, m_colourBG, m_fillPattern, m_fillFGTransparency, m_fillBGTransparency, m_shadowPattern, m_shfgc,
+                                m_shadowOffsetX, m_shadowOffsetY);
+  }
+
+private:
+  unsigned m_level;
+  boost::optional<Colour> m_colourFG;
+  boost::optional<Colour> m_colourBG;
+  boost::optional<unsigned char> m_fillPattern;
+  boost::optional<double> m_fillFGTransparency;
+  boost::optional<double> m_fillBGTransparency;
+  boost::optional<unsigned char> m_shadowPattern;
+  boost::optional<Colour> m_shfgc;
+  boost::optional<double> m_shadowOffsetX;
+  boost::optional<double> m_shadowOffsetY;
+};
+
+class FillStyleWithoutOffsetEvent : public VSDCollectorEvent
+{
+public:
+  FillStyleWithoutOffsetEvent(unsigned level, const boost::optional<Colour> &colourFG, const boost::optional<Colour> &colourBG,
+                              const boost::optional<unsigned char> &fillPattern, const boost::optional<double> &fillFGTransparency,
+                              const boost::optional<double> &fillBGTransparency, const boost::optional<unsigned char> &shadowPattern,
+                              const boost::optional<Colour> &shfgc)
+    : m_level(level), m_colourFG(colourFG), m_colourBG(colourBG), m_fillPattern(fillPattern), m_fillFGTransparency(fillFGTransparency),
+      m_fillBGTransparency(fillBGTransparency), m_shadowPattern(shadowPattern), m_shfgc(shfgc) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectFillStyle(m_level, m_colourFG, m_colourBG, m_fillPattern, m_fillFGTransparency, m_fillBGTransparency, m_shadowPattern, m_shfgc);
+  }
+
+private:
+  unsigned m_level;
+  boost::optional<Colour> m_colourFG;
+  boost::optional<Colour> m_colourBG;
+  boost::optional<unsigned char> m_fillPattern;
+  boost::optional<double> m_fillFGTransparency;
+  boost::optional<double> m_fillBGTransparency;
+  boost::optional<unsigned char> m_shadowPattern;
+  boost::optional<Colour> m_shfgc;
+};
+
+class CharIXStyleEvent : public VSDCollectorEvent
+{
+public:
+  CharIXStyleEvent(unsigned id, unsigned level, unsigned charCount, const boost::optional<VSDName> &font, const boost::optional<Colour> &fontColour,
+                   const boost::optional<double> &fontSize, const boost::optional<bool> &bold, const boost::optional<bool> &italic,
+                   const boost::optional<bool> &underline, const boost::optional<bool> &doubleunderline, const boost::optional<bool> &strikeout,
+                   const boost::optional<bool> &doublestrikeout, const boost::optional<bool> &allcaps, const boost::optional<bool> &initcaps,
+                   const boost::optional<bool> &smallcaps, const boost::optional<bool> &superscript, const boost::optional<bool> &subscript)
+    : m_id(id), m_level(level), m_charCount(charCount), m_font(font), m_fontColour(fontColour), m_fontSize(fontSize), m_bold(bold), m_italic(italic),
+      m_underline(underline), m_doubleunderline(doubleunderline), m_strikeout(strikeout), m_doublestrikeout(doublestrikeout), m_allcaps(allcaps),
+      m_initcaps(initcaps), m_smallcaps(smallcaps), m_superscript(superscript), m_subscript(subscript) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectCharIXStyle(m_id, m_level, m_charCount, m_font, m_fontColour, m_fontSize, m_bold, m_italic, m_underline, m_doubleunderline,
+                                  m_strikeout, m_doublestrikeout, m_allcaps, m_initcaps, m_smallcaps, m_superscript, m_subscript);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  unsigned m_charCount;
+  boost::optional<VSDName> m_font;
+  boost::optional<Colour> m_fontColour;
+  boost::optional<double> m_fontSize;
+  boost::optional<bool> m_bold;
+  boost::optional<bool> m_italic;
+  boost::optional<bool> m_underline;
+  boost::optional<bool> m_doubleunderline;
+  boost::optional<bool> m_strikeout;
+  boost::optional<bool> m_doublestrikeout;
+  boost::optional<bool> m_allcaps;
+  boost::optional<bool> m_initcaps;
+  boost::optional<bool> m_smallcaps;
+  boost::optional<bool> m_superscript;
+  boost::optional<bool> m_subscript;
+};
+
+class ParaIXStyleEvent : public VSDCollectorEvent
+{
+public:
+  ParaIXStyleEvent(unsigned id, unsigned level, unsigned charCount, const boost::optional<double> &indFirst, const boost::optional<double> &indLeft,
+                   const boost::optional<double> &indRight, const boost::optional<double> &spLine, const boost::optional<double> &spBefore,
+                   const boost::optional<double> &spAfter, const boost::optional<unsigned char> &align, const boost::optional<unsigned> &flags)
+    : m_id(id), m_level(level), m_charCount(charCount), m_indFirst(indFirst), m_indLeft(indLeft), m_indRight(indRight), m_spLine(spLine),
+      m_spBefore(spBefore), m_spAfter(spAfter), m_align(align), m_flags(flags) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectParaIXStyle(m_id, m_level, m_charCount, m_indFirst, m_indLeft, m_indRight, m_spLine, m_spBefore, m_spAfter, m_align, m_flags);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  unsigned m_charCount;
+  boost::optional<double> m_indFirst;
+  boost::optional<double> m_indLeft;
+  boost::optional<double> m_indRight;
+  boost::optional<double> m_spLine;
+  boost::optional<double> m_spBefore;
+  boost::optional<double> m_spAfter;
+  boost::optional<unsigned char> m_align;
+  boost::optional<unsigned> m_flags;
+};
+
+class TextBlockStyleEvent : public VSDCollectorEvent
+{
+public:
+  TextBlockStyleEvent(unsigned level, const boost::optional<double> &leftMargin, const boost::optional<double> &rightMargin,
+                      const boost::optional<double> &topMargin, const boost::optional<double> &bottomMargin,
+                      const boost::optional<unsigned char> &verticalAlign, const boost::optional<bool> &isBgFilled,
+                      const boost::optional<Colour> &bgColour, const boost::optional<double> &defaultTabStop,
+                      const boost::optional<unsigned char> &textDirection)
+    : m_level(level), m_leftMargin(leftMargin), m_rightMargin(rightMargin), m_topMargin(topMargin), m_bottomMargin(bottomMargin),
+      m_verticalAlign(verticalAlign), m_isBgFilled(isBgFilled), m_bgColour(bgColour), m_defaultTabStop(defaultTabStop), m_textDirection(textDirection) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectTextBlockStyle(m_level, m_leftMargin, m_rightMargin, m_topMargin, m_bottomMargin, m_verticalAlign, m_isBgFilled, m_bgColour,
+                                     m_defaultTabStop, m_textDirection);
+  }
+
+private:
+  unsigned m_level;
+  boost::optional<double> m_leftMargin;
+  boost::optional<double> m_rightMargin;
+  boost::optional<double> m_topMargin;
+  boost::optional<double> m_bottomMargin;
+  boost::optional<unsigned char> m_verticalAlign;
+  boost::optional<bool> m_isBgFilled;
+  boost::optional<Colour> m_bgColour;
+  boost::optional<double> m_defaultTabStop;
+  boost::optional<unsigned char> m_textDirection;
+};
+
+class StyleThemeReferenceEvent : public VSDCollectorEvent
+{
+public:
+  StyleThemeReferenceEvent(unsigned level, const boost::optional<long> &lineColour, const boost::optional<long> &fillColour,
+                           const boost::optional<long> &shadowColour, const boost::optional<long> &fontColour)
+    : m_level(level), m_lineColour(lineColour), m_fillColour(fillColour), m_shadowColour(shadowColour), m_fontColour(fontColour) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectStyleThemeReference(m_level, m_lineColour, m_fillColour, m_shadowColour, m_fontColour);
+  }
+
+private:
+  unsigned m_level;
+  boost::optional<long> m_lineColour;
+  boost::optional<long> m_fillColour;
+  boost::optional<long> m_shadowColour;
+  boost::optional<long> m_fontColour;
+};
+
+class FieldListEvent : public VSDCollectorEvent
+{
+public:
+  FieldListEvent(unsigned id, unsigned level)
+    : m_id(id), m_level(level) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectFieldList(m_id, m_level);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+};
+
+class TextFieldEvent : public VSDCollectorEvent
+{
+public:
+  TextFieldEvent(unsigned id, unsigned level, int nameId, int formatStringId)
+    : m_id(id), m_level(level), m_nameId(nameId), m_formatStringId(formatStringId) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectTextField(m_id, m_level, m_nameId, m_formatStringId);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  int m_nameId;
+  int m_formatStringId;
+};
+
+class NumericFieldEvent : public VSDCollectorEvent
+{
+public:
+  NumericFieldEvent(unsigned id, unsigned level, unsigned short format, double number, int formatStringId)
+    : m_id(id), m_level(level), m_format(format), m_number(number), m_formatStringId(formatStringId) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->collectNumericField(m_id, m_level, m_format, m_number, m_formatStringId);
+  }
+
+private:
+  unsigned m_id;
+  unsigned m_level;
+  unsigned short m_format;
+  double m_number;
+  int m_formatStringId;
+};
+
+class StartPageEvent : public VSDCollectorEvent
+{
+public:
+  StartPageEvent(unsigned pageId)
+    : m_pageId(pageId) {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->startPage(m_pageId);
+  }
+
+private:
+  unsigned m_pageId;
+};
+
+class EndPageEvent : public VSDCollectorEvent
+{
+public:
+  EndPageEvent() {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->endPage();
+  }
+};
+
+class EndPagesEvent : public VSDCollectorEvent
+{
+public:
+  EndPagesEvent() {}
+  void replay(VSDCollector *collector) const
+  {
+    collector->endPages();
+  }
+};
+
+} // anonymous namespace
+
+} // namespace libvisio
+
+static bool g_recordingEnabled = false;
+
+void libvisio::VSDRecordingCollector::setEnabled(bool enabled)
+{
+  g_recordingEnabled = enabled;
+}
+
+bool libvisio::VSDRecordingCollector::isEnabled()
+{
+  return g_recordingEnabled;
+}
+
+libvisio::VSDRecordingCollector::VSDRecordingCollector(VSDCollector *collector)
+  : m_collector(collector), m_events(), m_paused(false)
+{
+}
+
+libvisio::VSDRecordingCollector::~VSDRecordingCollector()
+{
+  for (std::vector<VSDCollectorEvent *>::iterator iter = m_events.begin(); iter != m_events.end(); ++iter)
+    delete *iter;
+}
+
+void libvisio::VSDRecordingCollector::replay(VSDCollector *collector) const
+{
+  for (std::vector<VSDCollectorEvent *>::const_iterator iter = m_events.begin(); iter != m_events.end(); ++iter)
+    (*iter)->replay(collector);
+}
+
+void libvisio::VSDRecordingCollector::collectEllipticalArcTo(unsigned id, unsigned level, double x3, double y3, double x2, double y2, double angle,
+                                                             double ecc)
+{
+  m_collector->collectEllipticalArcTo(id, level, x3, y3, x2, y2, angle, ecc);
+  if (!m_paused)
+    m_events.push_back(new EllipticalArcToEvent(id, level, x3, y3, x2, y2, angle, ecc));
+}
+
+void libvisio::VSDRecordingCollector::collectForeignData(unsigned level, const librevenge::RVNGBinaryData &binaryData)
+{
+  m_collector->collectForeignData(level, binaryData);
+  if (!m_paused)
+    m_events.push_back(new ForeignDataEvent(level, binaryData));
+}
+
+void libvisio::VSDRecordingCollector::collectOLEList(unsigned id, unsigned level)
+{
+  m_collector->collectOLEList(id, level);
+  if (!m_paused)
+    m_events.push_back(new OLEListEvent(id, level));
+}
+
+void libvisio::VSDRecordingCollector::collectOLEData(unsigned id, unsigned level, const librevenge::RVNGBinaryData &oleData)
+{
+  m_collector->collectOLEData(id, level, oleData);
+  if (!m_paused)
+    m_events.push_back(new OLEDataEvent(id, level, oleData));
+}
+
+void libvisio::VSDRecordingCollector::collectEllipse(unsigned id, unsigned level, double cx, double cy, double xleft, double yleft, double xtop,
+                                                     double ytop)
+{
+  m_collector->collectEllipse(id, level, cx, cy, xleft, yleft, xtop, ytop);
+  if (!m_paused)
+    m_events.push_back(new EllipseEvent(id, level, cx, cy, xleft, yleft, xtop, ytop));
+}
+
+void libvisio::VSDRecordingCollector::collectLine(unsigned level, const boost::optional<double> &strokeWidth, const boost::optional<Colour> &c,
+                                                  const boost::optional<unsigned char> &linePattern,
+                                                  const boost::optional<unsigned char> &startMarker, const boost::optional<unsigned char> &endMarker,
+                                                  const boost::optional<unsigned char> &lineCap)
+{
+  m_collector->collectLine(level, strokeWidth, c, linePattern, startMarker, endMarker, lineCap);
+  if (!m_paused)
+    m_events.push_back(new LineEvent(level, strokeWidth, c, linePattern, startMarker, endMarker, lineCap));
+}
+
+void libvisio::VSDRecordingCollector::collectFillAndShadow(unsigned level, const boost::optional<Colour> &colourFG,
+                                                           const boost::optional<Colour> &colourBG,
+                                                           const boost::optional<unsigned char> &fillPattern,
+                                                           const boost::optional<double> &fillFGTransparency,
+                                                           const boost::optional<double> &fillBGTransparency,
+                                                           const boost::optional<unsigned char> &shadowPattern, const boost::optional<Colour> &shfgc,
+                                                           const boost::optional<double> &shadowOffsetX, const boost::optional<double> &shadowOffsetY)
+{
+  m_collector->collectFillAndShadow(level, colourFG, colourBG, fillPattern, fillFGTransparency, fillBGTransparency, shadowPattern, shfgc,
+                                    shadowOffsetX, shadowOffsetY);
+  if (!m_paused)
+    m_events.push_back(new FillAndShadowEvent(level, colourFG, colourBG, fillPattern, fillFGTransparency, fillBGTransparency, shadowPattern, shfgc,
+                                              shadowOffsetX, shadowOffsetY));
+}
+
+void libvisio::VSDRecordingCollector::collectFillAndShadow(unsigned level, const boost::optional<Colour> &colourFG,
+                                                           const boost::optional<Colour> &colourBG,
+                                                           const boost::optional<unsigned char> &fillPattern,
+                                                           const boost::optional<double> &fillFGTransparency,
+                                                           const boost::optional<double> &fillBGTransparency,
+                                                           const boost::optional<unsigned char> &shadowPattern, const boost::optional<Colour> &shfgc)
+{
+  m_collector->collectFillAndShadow(level, colourFG, colourBG, fillPattern, fillFGTransparency, fillBGTransparency, shadowPattern, shfgc);
+  if (!m_paused)
+    m_events.push_back(new FillAndShadowWithoutOffsetEvent(level, colourFG, colourBG, fillPattern, fillFGTransparency, fillBGTransparency,
+                                                           shadowPattern, shfgc));
+}
+
+void libvisio::VSDRecordingCollector::collectThemeReference(unsigned level, const boost::optional<long> &lineColour,
+                                                            const boost::optional<long> &fillColour, const boost::optional<long> &shadowColour,
+                                                            const boost::optional<long> &fontColour)
+{
+  m_collector->collectThemeReference(level, lineColour, fillColour, shadowColour, fontColour);
+  if (!m_paused)
+    m_events.push_back(new ThemeReferenceEvent(level, lineColour, fillColour, shadowColour, fontColour));
+}
+
+void libvisio::VSDRecordingCollector::collectGeometry(unsigned id, unsigned level, bool noFill, bool noLine, bool noShow)
+{
+  m_collector->collectGeometry(id, level, noFill, noLine, noShow);
+  if (!m_paused)
+    m_events.push_back(new GeometryEvent(id, level, noFill, noLine, noShow));
+}
+
+void libvisio::VSDRecordingCollector::collectMoveTo(unsigned id, unsigned level, double x, double y)
+{
+  m_collector->collectMoveTo(id, level, x, y);
+  if (!m_paused)
+    m_events.push_back(new MoveToEvent(id, level, x, y));
+}
+
+void libvisio::VSDRecordingCollector::collectLineTo(unsigned id, unsigned level, double x, double y)
+{
+  m_collector->collectLineTo(id, level, x, y);
+  if (!m_paused)
+    m_events.push_back(new LineToEvent(id, level, x, y));
+}
+
+void libvisio::VSDRecordingCollector::collectArcTo(unsigned id, unsigned level, double x2, double y2, double bow)
+{
+  m_collector->collectArcTo(id, level, x2, y2, bow);
+  if (!m_paused)
+    m_events.push_back(new ArcToEvent(id, level, x2, y2, bow));
+}
+
+void libvisio::VSDRecordingCollector::collectNURBSTo(unsigned id, unsigned level, double x2, double y2, unsigned char xType, unsigned char yType,
+                                                     unsigned degree, const std::vector<std::pair<double, double> > &ctrlPnts,
+                                                     const std::vector<double> &kntVec, const std::vector<double> &weights)
+{
+  m_collector->collectNURBSTo(id, level, x2, y2, xType, yType, degree, ctrlPnts, kntVec, weights);
+  if (!m_paused)
+    m_events.push_back(new NURBSToEvent(id, level, x2, y2, xType, yType, degree, ctrlPnts, kntVec, weights));
+}
+
+void libvisio::VSDRecordingCollector::collectNURBSTo(unsigned id, unsigned level, double x2, double y2, double knot, double knotPrev, double weight,
+                                                     double weightPrev, unsigned dataID)
+{
+  m_collector->collectNURBSTo(id, level, x2, y2, knot, knotPrev, weight, weightPrev, dataID);
+  if (!m_paused)
+    m_events.push_back(new NURBSToDataIDEvent(id, level, x2, y2, knot, knotPrev, weight, weightPrev, dataID));
+}
+
+void libvisio::VSDRecordingCollector::collectNURBSTo(unsigned id, unsigned level, double x2, double y2, double knot, double knotPrev, double weight,
+                                                     double weightPrev, const NURBSData &data)
+{
+  m_collector->collectNURBSTo(id, level, x2, y2, knot, knotPrev, weight, weightPrev, data);
+  if (!m_paused)
+    m_events.push_back(new NURBSToDataEvent(id, level, x2, y2, knot, knotPrev, weight, weightPrev, data));
+}
+
+void libvisio::VSDRecordingCollector::collectPolylineTo(unsigned id, unsigned level, double x, double y, unsigned char xType, unsigned char yType,
+                                                        const std::vector<std::pair<double, double> > &points)
+{
+  m_collector->collectPolylineTo(id, level, x, y, xType, yType, points);
+  if (!m_paused)
+    m_events.push_back(new PolylineToEvent(id, level, x, y, xType, yType, points));
+}
+
+void libvisio::VSDRecordingCollector::collectPolylineTo(unsigned id, unsigned level, double x, double y, unsigned dataID)
+{
+  m_collector->collectPolylineTo(id, level, x, y, dataID);
+  if (!m_paused)
+    m_events.push_back(new PolylineToDataIDEvent(id, level, x, y, dataID));
+}
+
+void libvisio::VSDRecordingCollector::collectPolylineTo(unsigned id, unsigned level, double x, double y, const PolylineData &data)
+{
+  m_collector->collectPolylineTo(id, level, x, y, data);
+  if (!m_paused)
+    m_events.push_back(new PolylineToDataEvent(id, level, x, y, data));
+}
+
+void libvisio::VSDRecordingCollector::collectShapeData(unsigned id, unsigned level, unsigned char xType, unsigned char yType, unsigned degree,
+                                                       double lastKnot, std::vector<std::pair<double, double> > controlPoints,
+                                                       std::vector<double> knotVector, std::vector<double> weights)
+{
+  m_collector->collectShapeData(id, level, xType, yType, degree, lastKnot, controlPoints, knotVector, weights);
+  if (!m_paused)
+    m_events.push_back(new NURBSShapeDataEvent(id, level, xType, yType, degree, lastKnot, controlPoints, knotVector, weights));
+}
+
+void libvisio::VSDRecordingCollector::collectShapeData(unsigned id, unsigned level, unsigned char xType, unsigned char yType,
+                                                       std::vector<std::pair<double, double> > points)
+{
+  m_collector->collectShapeData(id, level, xType, yType, points);
+  if (!m_paused)
+    m_events.push_back(new PolylineShapeDataEvent(id, level, xType, yType, points));
+}
+
+void libvisio::VSDRecordingCollector::collectXFormData(unsigned level, const XForm &xform)
+{
+  m_collector->collectXFormData(level, xform);
+  if (!m_paused)
+    m_events.push_back(new XFormDataEvent(level, xform));
+}
+
+void libvisio::VSDRecordingCollector::collectTxtXForm(unsigned level, const XForm &txtxform)
+{
+  m_collector->collectTxtXForm(level, txtxform);
+  if (!m_paused)
+    m_events.push_back(new TxtXFormEvent(level, txtxform));
+}
+
+void libvisio::VSDRecordingCollector::collectShapesOrder(unsigned id, unsigned level, const std::vector<unsigned> &shapeIds)
+{
+  m_collector->collectShapesOrder(id, level, shapeIds);
+  if (!m_paused)
+    m_events.push_back(new ShapesOrderEvent(id, level, shapeIds));
+}
+
+void libvisio::VSDRecordingCollector::collectForeignDataType(unsigned level, unsigned foreignType, unsigned foreignFormat, double offsetX,
+                                                             double offsetY, double width, double height)
+{
+  m_collector->collectForeignDataType(level, foreignType, foreignFormat, offsetX, offsetY, width, height);
+  if (!m_paused)
+    m_events.push_back(new ForeignDataTypeEvent(level, foreignType, foreignFormat, offsetX, offsetY, width, height));
+}
+
+void libvisio::VSDRecordingCollector::collectPageProps(unsigned id, unsigned level, double pageWidth, double pageHeight, double shadowOffsetX,
+                                                       double shadowOffsetY, double scale)
+{
+  m_collector->collectPageProps(id, level, pageWidth, pageHeight, shadowOffsetX, shadowOffsetY, scale);
+  if (!m_paused)
+    m_events.push_back(new PagePropsEvent(id, level, pageWidth, pageHeight, shadowOffsetX, shadowOffsetY, scale));
+}
+
+void libvisio::VSDRecordingCollector::collectPage(unsigned id, unsigned level, unsigned backgroundPageID, bool isBackgroundPage,
+                                                  const VSDName &pageName)
+{
+  m_collector->collectPage(id, level, backgroundPageID, isBackgroundPage, pageName);
+  if (!m_paused)
+    m_events.push_back(new PageEvent(id, level, backgroundPageID, isBackgroundPage, pageName));
+}
+
+void libvisio::VSDRecordingCollector::collectShape(unsigned id, unsigned level, unsigned parent, unsigned masterPage, unsigned masterShape,
+                                                   unsigned lineStyle, unsigned fillStyle, unsigned textStyle)
+{
+  m_collector->collectShape(id, level, parent, masterPage, masterShape, lineStyle, fillStyle, textStyle);
+  if (!m_paused)
+    m_events.push_back(new ShapeEvent(id, level, parent, masterPage, masterShape, lineStyle, fillStyle, textStyle));
+}
+
+void libvisio::VSDRecordingCollector::collectSplineStart(unsigned id, unsigned level, double x, double y, double secondKnot, double firstKnot,
+                                                         double lastKnot, unsigned degree)
+{
+  m_collector->collectSplineStart(id, level, x, y, secondKnot, firstKnot, lastKnot, degree);
+  if (!m_paused)
+    m_events.push_back(new SplineStartEvent(id, level, x, y, secondKnot, firstKnot, lastKnot, degree));
+}
+
+void libvisio::VSDRecordingCollector::collectSplineKnot(unsigned id, unsigned level, double x, double y, double knot)
+{
+  m_collector->collectSplineKnot(id, level, x, y, knot);
+  if (!m_paused)
+    m_events.push_back(new SplineKnotEvent(id, level, x, y, knot));
+}
+
+void libvisio::VSDRecordingCollector::collectSplineEnd()
+{
+  m_collector->collectSplineEnd();
+  if (!m_paused)
+    m_events.push_back(new SplineEndEvent());
+}
+
+void libvisio::VSDRecordingCollector::collectInfiniteLine(unsigned id, unsigned level, double x1, double y1, double x2, double y2)
+{
+  m_collector->collectInfiniteLine(id, level, x1, y1, x2, y2);
+  if (!m_paused)
+    m_events.push_back(new InfiniteLineEvent(id, level, x1, y1, x2, y2));
+}
+
+void libvisio::VSDRecordingCollector::collectRelCubBezTo(unsigned id, unsigned level, double x, double y, double a, double b, double c, double d)
+{
+  m_collector->collectRelCubBezTo(id, level, x, y, a, b, c, d);
+  if (!m_paused)
+    m_events.push_back(new RelCubBezToEvent(id, level, x, y, a, b, c, d));
+}
+
+void libvisio::VSDRecordingCollector::collectRelEllipticalArcTo(unsigned id, unsigned level, double x, double y, double a, double b, double c,
+                                                                double d)
+{
+  m_collector->collectRelEllipticalArcTo(id, level, x, y, a, b, c, d);
+  if (!m_paused)
+    m_events.push_back(new RelEllipticalArcToEvent(id, level, x, y, a, b, c, d));
+}
+
+void libvisio::VSDRecordingCollector::collectRelLineTo(unsigned id, unsigned level, double x, double y)
+{
+  m_collector->collectRelLineTo(id, level, x, y);
+  if (!m_paused)
+    m_events.push_back(new RelLineToEvent(id, level, x, y));
+}
+
+void libvisio::VSDRecordingCollector::collectRelMoveTo(unsigned id, unsigned level, double x, double y)
+{
+  m_collector->collectRelMoveTo(id, level, x, y);
+  if (!m_paused)
+    m_events.push_back(new RelMoveToEvent(id, level, x, y));
+}
+
+void libvisio::VSDRecordingCollector::collectRelQuadBezTo(unsigned id, unsigned level, double x, double y, double a, double b)
+{
+  m_collector->collectRelQuadBezTo(id, level, x, y, a, b);
+  if (!m_paused)
+    m_events.push_back(new RelQuadBezToEvent(id, level, x, y, a, b));
+}
+
+void libvisio::VSDRecordingCollector::collectUnhandledChunk(unsigned id, unsigned level)
+{
+  m_collector->collectUnhandledChunk(id, level);
+  if (!m_paused)
+    m_events.push_back(new UnhandledChunkEvent(id, level));
+}
+
+void libvisio::VSDRecordingCollector::collectText(unsigned level, const librevenge::RVNGBinaryData &textStream, TextFormat format)
+{
+  m_collector->collectText(level, textStream, format);
+  if (!m_paused)
+    m_events.push_back(new TextEvent(level, textStream, format));
+}
+
+void libvisio::VSDRecordingCollector::collectCharIX(unsigned id, unsigned level, unsigned charCount, const boost::optional<VSDName> &font,
+                                                    const boost::optional<Colour> &fontColour, const boost::optional<double> &fontSize,
+                                                    const boost::optional<bool> &bold, const boost::optional<bool> &italic,
+                                                    const boost::optional<bool> &underline, const boost::optional<bool> &doubleunderline,
+                                                    const boost::optional<bool> &strikeout, const boost::optional<bool> &doublestrikeout,
+                                                    const boost::optional<bool> &allcaps, const boost::optional<bool> &initcaps,
+                                                    const boost::optional<bool> &smallcaps, const boost::optional<bool> &superscript,
+                                                    const boost::optional<bool> &subscript)
+{
+  m_collector->collectCharIX(id, level, charCount, font, fontColour, fontSize, bold, italic, underline, doubleunderline, strikeout, doublestrikeout,
+                             allcaps, initcaps, smallcaps, superscript, subscript);
+  if (!m_paused)
+    m_events.push_back(new CharIXEvent(id, level, charCount, font, fontColour, fontSize, bold, italic, underline, doubleunderline, strikeout,
+                                       doublestrikeout, allcaps, initcaps, smallcaps, superscript, subscript));
+}
+
+void libvisio::VSDRecordingCollector::collectDefaultCharStyle(unsigned charCount, const boost::optional<VSDName> &font,
+                                                              const boost::optional<Colour> &fontColour, const boost::optional<double> &fontSize,
+                                                              const boost::optional<bool> &bold, const boost::optional<bool> &italic,
+                                                              const boost::optional<bool> &underline, const boost::optional<bool> &doubleunderline,
+                                                              const boost::optional<bool> &strikeout, const boost::optional<bool> &doublestrikeout,
+                                                              const boost::optional<bool> &allcaps, const boost::optional<bool> &initcaps,
+                                                              const boost::optional<bool> &smallcaps, const boost::optional<bool> &superscript,
+                                                              const boost::optional<bool> &subscript)
+{
+  m_collector->collectDefaultCharStyle(charCount, font, fontColour, fontSize, bold, italic, underline, doubleunderline, strikeout, doublestrikeout,
+                                       allcaps, initcaps, smallcaps, superscript, subscript);
+  if (!m_paused)
+    m_events.push_back(new DefaultCharStyleEvent(charCount, font, fontColour, fontSize, bold, italic, underline, doubleunderline, strikeout,
+                                                 doublestrikeout, allcaps, initcaps, smallcaps, superscript, subscript));
+}
+
+void libvisio::VSDRecordingCollector::collectParaIX(unsigned id, unsigned level, unsigned charCount, const boost::optional<double> &indFirst,
+                                                    const boost::optional<double> &indLeft, const boost::optional<double> &indRight,
+                                                    const boost::optional<double> &spLine, const boost::optional<double> &spBefore,
+                                                    const boost::optional<double> &spAfter, const boost::optional<unsigned char> &align,
+                                                    const boost::optional<unsigned> &flags)
+{
+  m_collector->collectParaIX(id, level, charCount, indFirst, indLeft, indRight, spLine, spBefore, spAfter, align, flags);
+  if (!m_paused)
+    m_events.push_back(new ParaIXEvent(id, level, charCount, indFirst, indLeft, indRight, spLine, spBefore, spAfter, align, flags));
+}
+
+void libvisio::VSDRecordingCollector::collectDefaultParaStyle(unsigned charCount, const boost::optional<double> &indFirst,
+                                                              const boost::optional<double> &indLeft, const boost::optional<double> &indRight,
+                                                              const boost::optional<double> &spLine, const boost::optional<double> &spBefore,
+                                                              const boost::optional<double> &spAfter, const boost::optional<unsigned char> &align,
+                                                              const boost::optional<unsigned> &flags)
+{
+  m_collector->collectDefaultParaStyle(charCount, indFirst, indLeft, indRight, spLine, spBefore, spAfter, align, flags);
+  if (!m_paused)
+    m_events.push_back(new DefaultParaStyleEvent(charCount, indFirst, indLeft, indRight, spLine, spBefore, spAfter, align, flags));
+}
+
+void libvisio::VSDRecordingCollector::collectTextBlock(unsigned level, const boost::optional<double> &leftMargin,
+                                                       const boost::optional<double> &rightMargin, const boost::optional<double> &topMargin,
+                                                       const boost::optional<double> &bottomMargin,
+                                                       const boost::optional<unsigned char> &verticalAlign, const boost::optional<bool> &isBgFilled,
+                                                       const boost::optional<Colour> &bgColour, const boost::optional<double> &defaultTabStop,
+                                                       const boost::optional<unsigned char> &textDirection)
+{
+  m_collector->collectTextBlock(level, leftMargin, rightMargin, topMargin, bottomMargin, verticalAlign, isBgFilled, bgColour, defaultTabStop,
+                                textDirection);
+  if (!m_paused)
+    m_events.push_back(new TextBlockEvent(level, leftMargin, rightMargin, topMargin, bottomMargin, verticalAlign, isBgFilled, bgColour,
+                                          defaultTabStop, textDirection));
+}
+
+void libvisio::VSDRecordingCollector::collectNameList(unsigned id, unsigned level)
+{
+  m_collector->collectNameList(id, level);
+  if (!m_paused)
+    m_events.push_back(new NameListEvent(id, level));
+}
+
+void libvisio::VSDRecordingCollector::collectName(unsigned id, unsigned level, const librevenge::RVNGBinaryData &name, TextFormat format)
+{
+  m_collector->collectName(id, level, name, format);
+  if (!m_paused)
+    m_events.push_back(new NameEvent(id, level, name, format));
+}
+
+void libvisio::VSDRecordingCollector::collectPageSheet(unsigned id, unsigned level)
+{
+  m_collector->collectPageSheet(id, level);
+  if (!m_paused)
+    m_events.push_back(new PageSheetEvent(id, level));
+}
+
+void libvisio::VSDRecordingCollector::collectMisc(unsigned level, const VSDMisc &misc)
+{
+  m_collector->collectMisc(level, misc);
+  if (!m_paused)
+    m_events.push_back(new MiscEvent(level, misc));
+}
+
+void libvisio::VSDRecordingCollector::collectStyleSheet(unsigned id, unsigned level, unsigned parentLineStyle, unsigned parentFillStyle,
+                                                        unsigned parentTextStyle)
+{
+  m_collector->collectStyleSheet(id, level, parentLineStyle, parentFillStyle, parentTextStyle);
+  if (!m_paused)
+    m_events.push_back(new StyleSheetEvent(id, level, parentLineStyle, parentFillStyle, parentTextStyle));
+}
+
+void libvisio::VSDRecordingCollector::collectLineStyle(unsigned level, const boost::optional<double> &strokeWidth, const boost::optional<Colour> &c,
+                                                       const boost::optional<unsigned char> &linePattern,
+                                                       const boost::optional<unsigned char> &startMarker,
+                                                       const boost::optional<unsigned char> &endMarker, const boost::optional<unsigned char> &lineCap)
+{
+  m_collector->collectLineStyle(level, strokeWidth, c, linePattern, startMarker, endMarker, lineCap);
+  if (!m_paused)
+    m_events.push_back(new LineStyleEvent(level, strokeWidth, c, linePattern, startMarker, endMarker, lineCap));
+}
+
+void libvisio::VSDRecordingCollector::collectFillStyle(unsigned level, const boost::optional<Colour> &colourFG,
+                                                       const boost::optional<Colour> &colourBG, const boost::optional<unsigned char> &fillPattern,
+                                                       const boost::optional<double> &fillFGTransparency,
+                                                       const boost::optional<double> &fillBGTransparency,
+                                                       const boost::optional<unsigned char> &shadowPattern, const boost::optional<Colour> &shfgc,
+                                                       const boost::optional<double> &shadowOffsetX, const boost::optional<double> &shadowOffsetY)
+{
+  m_collector->collectFillStyle(level, colourFG, colourBG, fillPattern, fillFGTransparency, fillBGTransparency, shadowPattern, shfgc, shadowOffsetX,
+                                shadowOffsetY);
+  if (!m_paused)
+    m_events.push_back(new FillStyleEvent(level, colourFG, colourBG, fillPattern, fillFGTransparency, fillBGTransparency, shadowPattern, shfgc,
+                                          shadowOffsetX, shadowOffsetY));
+}
+
+void libvisio::VSDRecordingCollector::collectFillStyle(unsigned level, const boost::optional<Colour> &colourFG,
+                                                       const boost::optional<Colour> &colourBG, const boost::optional<unsigned char> &fillPattern,
+                                                       const boost::optional<double> &fillFGTransparency,
+                                                       const boost::optional<double> &fillBGTransparency,
+                                                       const boost::optional<unsigned char> &shadowPattern, const boost::optional<Colour> &shfgc)
+{
+  m_collector->collectFillStyle(level, colourFG, colourBG, fillPattern, fillFGTransparency, fillBGTransparency, shadowPattern, shfgc);
+  if (!m_paused)
+    m_events.push_back(new FillStyleWithoutOffsetEvent(level, colourFG, colourBG, fillPattern, fillFGTransparency, fillBGTransparency, shadowPattern,
+                                                       shfgc));
+}
+
+void libvisio::VSDRecordingCollector::collectCharIXStyle(unsigned id, unsigned level, unsigned charCount, const boost::optional<VSDName> &font,
+                                                         const boost::optional<Colour> &fontColour, const boost::optional<double> &fontSize,
+                                                         const boost::optional<bool> &bold, const boost::optional<bool> &italic,
+                                                         const boost::optional<bool> &underline, const boost::optional<bool> &doubleunderline,
+                                                         const boost::optional<bool> &strikeout, const boost::optional<bool> &doublestrikeout,
+                                                         const boost::optional<bool> &allcaps, const boost::optional<bool> &initcaps,
+                                                         const boost::optional<bool> &smallcaps, const boost::optional<bool> &superscript,
+                                                         const boost::optional<bool> &subscript)
+{
+  m_collector->collectCharIXStyle(id, level, charCount, font, fontColour, fontSize, bold, italic, underline, doubleunderline, strikeout,
+                                  doublestrikeout, allcaps, initcaps, smallcaps, superscript, subscript);
+  if (!m_paused)
+    m_events.push_back(new CharIXStyleEvent(id, level, charCount, font, fontColour, fontSize, bold, italic, underline, doubleunderline, strikeout,
+                                            doublestrikeout, allcaps, initcaps, smallcaps, superscript, subscript));
+}
+
+void libvisio::VSDRecordingCollector::collectParaIXStyle(unsigned id, unsigned level, unsigned charCount, const boost::optional<double> &indFirst,
+                                                         const boost::optional<double> &indLeft, const boost::optional<double> &indRight,
+                                                         const boost::optional<double> &spLine, const boost::optional<double> &spBefore,
+                                                         const boost::optional<double> &spAfter, const boost::optional<unsigned char> &align,
+                                                         const boost::optional<unsigned> &flags)
+{
+  m_collector->collectParaIXStyle(id, level, charCount, indFirst, indLeft, indRight, spLine, spBefore, spAfter, align, flags);
+  if (!m_paused)
+    m_events.push_back(new ParaIXStyleEvent(id, level, charCount, indFirst, indLeft, indRight, spLine, spBefore, spAfter, align, flags));
+}
+
+void libvisio::VSDRecordingCollector::collectTextBlockStyle(unsigned level, const boost::optional<double> &leftMargin,
+                                                            const boost::optional<double> &rightMargin, const boost::optional<double> &topMargin,
+                                                            const boost::optional<double> &bottomMargin,
+                                                            const boost::optional<unsigned char> &verticalAlign,
+                                                            const boost::optional<bool> &isBgFilled, const boost::optional<Colour> &bgColour,
+                                                            const boost::optional<double> &defaultTabStop,
+                                                            const boost::optional<unsigned char> &textDirection)
+{
+  m_collector->collectTextBlockStyle(level, leftMargin, rightMargin, topMargin, bottomMargin, verticalAlign, isBgFilled, bgColour, defaultTabStop,
+                                     textDirection);
+  if (!m_paused)
+    m_events.push_back(new TextBlockStyleEvent(level, leftMargin, rightMargin, topMargin, bottomMargin, verticalAlign, isBgFilled, bgColour,
+                                               defaultTabStop, textDirection));
+}
+
+void libvisio::VSDRecordingCollector::collectStyleThemeReference(unsigned level, const boost::optional<long> &lineColour,
+                                                                 const boost::optional<long> &fillColour, const boost::optional<long> &shadowColour,
+                                                                 const boost::optional<long> &fontColour)
+{
+  m_collector->collectStyleThemeReference(level, lineColour, fillColour, shadowColour, fontColour);
+  if (!m_paused)
+    m_events.push_back(new StyleThemeReferenceEvent(level, lineColour, fillColour, shadowColour, fontColour));
+}
+
+void libvisio::VSDRecordingCollector::collectFieldList(unsigned id, unsigned level)
+{
+  m_collector->collectFieldList(id, level);
+  if (!m_paused)
+    m_events.push_back(new FieldListEvent(id, level));
+}
+
+void libvisio::VSDRecordingCollector::collectTextField(unsigned id, unsigned level, int nameId, int formatStringId)
+{
+  m_collector->collectTextField(id, level, nameId, formatStringId);
+  if (!m_paused)
+    m_events.push_back(new TextFieldEvent(id, level, nameId, formatStringId));
+}
+
+void libvisio::VSDRecordingCollector::collectNumericField(unsigned id, unsigned level, unsigned short format, double number, int formatStringId)
+{
+  m_collector->collectNumericField(id, level, format, number, formatStringId);
+  if (!m_paused)
+    m_events.push_back(new NumericFieldEvent(id, level, format, number, formatStringId));
+}
+
+void libvisio::VSDRecordingCollector::startPage(unsigned pageId)
+{
+  m_collector->startPage(pageId);
+  if (!m_paused)
+    m_events.push_back(new StartPageEvent(pageId));
+}
+
+void libvisio::VSDRecordingCollector::endPage()
+{
+  m_collector->endPage();
+  if (!m_paused)
+    m_events.push_back(new EndPageEvent());
+}
+
+void libvisio::VSDRecordingCollector::endPages()
+{
+  m_collector->endPages();
+  if (!m_paused)
+    m_events.push_back(new EndPagesEvent());
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -14,6 +14,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/spirit/include/classic.hpp>
 #include "VSDXMLParserBase.h"
+#include "VSDRecordingCollector.h"
 #include "libvisio_utils.h"
 #include "VSDContentCollector.h"
 #include "VSDStylesCollector.h"
@@ -22,10 +23,10 @@
 
 
 libvisio::VSDXMLParserBase::VSDXMLParserBase()
-  : m_collector(), m_stencils(), m_currentStencil(0), m_shape(),
+  : m_collector(), m_recorder(0), m_stencils(), m_currentStencil(0), m_shape(),
     m_isStencilStarted(false), m_currentStencilID(MINUS_ONE),
     m_extractStencils(false), m_isInStyles(false), m_currentLevel(0),
-    m_currentShapeLevel(0), m_colours(), m_fieldList(), m_shapeList(),
+    m_mastersLevel(0), m_currentShapeLevel(0), m_colours(), m_fieldList(), m_shapeList(),
     m_currentBinaryData(), m_shapeStack(), m_shapeLevelStack(),
     m_isShapeStarted(false), m_isPageStarted(false), m_currentGeometryList(0),
     m_currentGeometryListIndex(MINUS_ONE), m_fonts()
@@ -1804,7 +1805,15 @@ void libvisio::VSDXMLParserBase::handleMastersStart(xmlTextReaderPtr reader)
     if (m_extractStencils)
       m_isStencilStarted = false;
     else
+    {
       m_isStencilStarted = true;
+      // The second pass skips the masters, which are only parsed once
+      if (m_recorder)
+      {
+        m_recorder->setPaused(true);
+        m_mastersLevel = m_currentLevel;
+      }
+    }
   }
 }
 
@@ -1814,7 +1823,15 @@ void libvisio::VSDXMLParserBase::handleMastersEnd(xmlTextReaderPtr /* reader */)
   if (m_extractStencils)
     m_collector->endPages();
   else
+  {
+    if (m_isStencilStarted && m_recorder)
+    {
+      m_recorder->setPaused(false);
+      // where the second pass would have left the masters
+      m_currentLevel = m_mastersLevel;
+    }
     m_isStencilStarted = false;
+  }
 }
 
 void libvisio::VSDXMLParserBase::handleMasterStart(xmlTextReaderPtr reader)
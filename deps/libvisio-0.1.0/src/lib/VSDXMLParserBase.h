@@ -24,6 +24,7 @@ namespace libvisio
 {
 
 class VSDCollector;
+class VSDRecordingCollector;
 
 class VSDXMLParserBase
 {
@@ -36,6 +37,7 @@ public:
 protected:
   // Protected data
   VSDCollector *m_collector;
+  VSDRecordingCollector *m_recorder;
   VSDStencils m_stencils;
   VSDStencil *m_currentStencil;
   VSDShape m_shape;
@@ -45,6 +47,7 @@ protected:
   bool m_extractStencils;
   bool m_isInStyles;
   unsigned m_currentLevel;
+  unsigned m_mastersLevel;
   unsigned m_currentShapeLevel;
   std::map<unsigned, Colour> m_colours;
   VSDFieldList m_fieldList;
@@ -16,6 +16,7 @@
 #include "libvisio_utils.h"
 #include "VSDContentCollector.h"
 #include "VSDStylesCollector.h"
+#include "VSDRecordingCollector.h"
 #include "VSDXMLHelper.h"
 #include "VSDXMLTokenMap.h"
 
@@ -84,16 +85,35 @@ bool libvisio::VSDXParser::parseMain()
     std::vector<std::list<unsigned> > documentPageShapeOrders;
 
     VSDStylesCollector stylesCollector(groupXFormsSequence, groupMembershipsSequence, documentPageShapeOrders);
+    VSDRecordingCollector recorder(&stylesCollector);
+    bool replay = VSDRecordingCollector::isEnabled();
     m_collector = &stylesCollector;
-    if (!parseDocument(m_input, rel->getTarget().c_str()))
+    if (replay)
+    {
+      m_collector = &recorder;
+      m_recorder = &recorder;
+    }
+    bool success = false;
+    {
+      VSDPassScope pass("styles");
+      success = parseDocument(m_input, rel->getTarget().c_str());
+    }
+    m_recorder = 0;
+    if (!success)
       return false;
 
     VSDStyles styles = stylesCollector.getStyleSheets();
 
     VSDContentCollector contentCollector(m_painter, groupXFormsSequence, groupMembershipsSequence, documentPageShapeOrders, styles, m_stencils);
     m_collector = &contentCollector;
-    if (!parseDocument(m_input, rel->getTarget().c_str()))
-      return false;
+    VSDPassScope pass("content");
+    if (replay)
+      recorder.replay(&contentCollector);
+    else
+    {
+      if (!parseDocument(m_input, rel->getTarget().c_str()))
+        return false;
+    }
 
     return true;
   }
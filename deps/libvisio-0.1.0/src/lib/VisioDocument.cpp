@@ -17,6 +17,8 @@
 #include "VSD5Parser.h"
 #include "VSD6Parser.h"
 #include "VSDXMLHelper.h"
+#include "VSDContentCollector.h"
+#include "VSDRecordingCollector.h"
 
 namespace
 {
@@ -392,4 +394,52 @@ VSDAPI bool libvisio::VisioDocument::parseStencils(librevenge::RVNGInputStream *
   }
   return false;
 }
+
+/**
+Sets the flatness tolerance used when the rational or high degree NURBS are converted to polylines:
+the largest distance between the curve and the polyline, in drawing units (inches). It applies to
+the documents parsed afterwards.
+\param tolerance The tolerance, a non-positive value restores the default
+*/
+VSDAPI void libvisio::VisioDocument::setNURBSTolerance(double tolerance)
+{
+  VSDContentCollector::setNURBSTolerance(tolerance);
+}
+
+/**
+Returns the number of points generated so far, by the documents parsed in the calling thread, when
+the NURBS are converted to polylines. The count is cumulative: the difference between two calls
+gives the points of the documents parsed in between.
+\return The number of points
+*/
+VSDAPI unsigned long libvisio::VisioDocument::getNURBSPointCount()
+{
+  return VSDContentCollector::getNURBSPointCount();
+}
+
+/**
+Sets a function called at the beginning and at the end of each pass of the parsers over the
+documents parsed afterwards in the calling thread: "styles", which reads the document, and
+"content", which reads it again, or replays the first pass (see setSinglePass), to draw it on
+the painter. It is also called around the decompression of each stream of the binary formats,
+"decompression", within the passes. The hook is called with the name of the pass, true
+at its beginning or false at its end, and data.
+\param hook The function, or NULL to remove the hook
+\param data Passed to hook as is
+*/
+VSDAPI void libvisio::VisioDocument::setPassHook(PassHook hook, void *data)
+{
+  libvisio::setPassHook(hook, data);
+}
+
+/**
+Sets whether the parsers read the documents parsed afterwards only once: the calls made by the
+first pass are then kept and replayed by the second one, instead of the document being parsed
+again. It trades the memory of the calls kept for the time of the second parse. Off by default.
+\param singlePass True to parse the documents once
+*/
+VSDAPI void libvisio::VisioDocument::setSinglePass(bool singlePass)
+{
+  VSDRecordingCollector::setEnabled(singlePass);
+}
 /* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -107,6 +107,34 @@ const librevenge::RVNGString libvisio::getColourString(const Colour &c)
   return sColour;
 }
 
+namespace
+{
+
+// Per thread, so that the documents parsed concurrently are reported apart
+static VSD_THREAD_LOCAL libvisio::PassHook g_passHook = 0;
+static VSD_THREAD_LOCAL void *g_passHookData = 0;
+
+} // anonymous namespace
+
+void libvisio::setPassHook(PassHook hook, void *data)
+{
+  g_passHook = hook;
+  g_passHookData = data;
+}
+
+libvisio::VSDPassScope::VSDPassScope(const char *pass)
+  : m_pass(pass), m_hook(g_passHook), m_data(g_passHookData)
+{
+  if (m_hook)
+    m_hook(m_pass, true, m_data);
+}
+
+libvisio::VSDPassScope::~VSDPassScope()
+{
+  if (m_hook)
+    m_hook(m_pass, false, m_data);
+}
+
 
 
 /* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -65,6 +65,12 @@ typedef unsigned __int64 uint64_t;
 #define VSD_DEBUG(M)
 #endif
 
+#if defined(_MSC_VER)
+#define VSD_THREAD_LOCAL __declspec(thread)
+#else
+#define VSD_THREAD_LOCAL __thread
+#endif
+
 namespace libvisio
 {
 
@@ -79,6 +85,28 @@ double readDouble(librevenge::RVNGInputStream *input);
 
 const librevenge::RVNGString getColourString(const Colour &c);
 
+typedef void (*PassHook)(const char *pass, bool begin, void *data);
+
+// Hook called around the passes of the parsers, and around the
+// decompression of the streams, in the calling thread
+void setPassHook(PassHook hook, void *data);
+
+// Reports the beginning and the end of a pass to the hook, if any
+class VSDPassScope
+{
+public:
+  explicit VSDPassScope(const char *pass);
+  ~VSDPassScope();
+
+private:
+  VSDPassScope(const VSDPassScope &);
+  VSDPassScope &operator=(const VSDPassScope &);
+
+  const char *m_pass;
+  PassHook m_hook;
+  void *m_data;
+};
+
 class EndOfStreamException
 {
 };
@@ -35,17 +35,59 @@
 #include <librevenge/RVNGDrawingInterface.h>
 #include <librevenge/RVNGStringVector.h>
 
+#include "SVGPageSink.h"
+
 namespace vss2svg {
 
 struct SVGDrawingGeneratorPrivate;
+class SVGEMFCache;
+class SVGStats;
+class SVGTrace;
 
 class REVENGE_API SVGDrawingGenerator
     : public librevenge::RVNGDrawingInterface {
   public:
+    //! append each page to vec
     SVGDrawingGenerator(librevenge::RVNGStringVector &vec,
                         const librevenge::RVNGString &nmspace);
+    //! hand each page to sink as soon as it is complete
+    SVGDrawingGenerator(SVGPageSink &sink,
+                        const librevenge::RVNGString &nmspace);
     ~SVGDrawingGenerator();
 
+    /* Write the styles of the shapes as class="sN" attributes referencing
+     * a <style> element emitted once per page, instead of repeating each
+     * style inline. Off by default. */
+    void setStyleClasses(bool enable);
+    //! reuse the EMF conversions stored in cache, which may be shared with
+    //! other generators and must outlive this one; NULL (the default)
+    //! converts every EMF image
+    void setEMFCache(SVGEMFCache *cache);
+    /* Convert the EMF images on nbThreads background threads; each page
+     * is then handed to the sink once all its images are converted, the
+     * pages staying in order. 0 (the default) converts them inline. */
+    void setEMFThreads(unsigned nbThreads);
+    //! count the callbacks, pages and EMF images in stats, and time them;
+    //! stats must outlive the conversions in progress. NULL (the default)
+    //! measures nothing
+    void setStats(SVGStats *stats);
+    //! record the pages, the shapes and the EMF conversions as spans of
+    //! trace, which must outlive the conversions in progress; NULL (the
+    //! default) records nothing
+    void setTrace(SVGTrace *trace);
+    /* Write scale SVG user units per inch of the drawing, for another
+     * resolution or unit; 631 by default. The points, the lengths and the
+     * stroke widths follow, the font sizes are left in points. */
+    void setScale(double scale);
+    //! the point of the page, in inches, written as (0, 0); the top left
+    //! corner by default
+    void setOrigin(double x, double y);
+    /* Drop the points of the polylines, the polygons and the runs of lines
+     * of the paths which are at most tolerance user units away from the
+     * simplified shape (Douglas-Peucker), and the segments of length zero.
+     * 0 (the default) writes every point. */
+    void setSimplification(double tolerance);
+
     void startDocument(const librevenge::RVNGPropertyList &propList);
     void endDocument();
     void setDocumentMetaData(const librevenge::RVNGPropertyList &propList);
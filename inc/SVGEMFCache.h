@@ -0,0 +1,91 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * cache of the EMF images already converted to SVG
+ */
+
+#ifndef SVGEMFCACHE_H
+#define SVGEMFCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <librevenge/librevenge-api.h>
+
+namespace vss2svg {
+
+//! what identifies a conversion: the EMF bytes and the emf2svg options
+struct REVENGE_API SVGEMFKey {
+    SVGEMFKey(const char *emf, size_t size, double width, double height,
+              const std::string &nmSpace);
+
+    const char *emf;
+    size_t size;
+    double width;
+    double height;
+    const std::string &nmSpace;
+    //! hash of all of the above
+    uint64_t hash;
+};
+
+/* Bounded cache of the SVG fragments produced by emf2svg, so that an EMF
+ * used by several masters, or by several stencils of a batch, is only
+ * converted once. The least recently used fragments are dropped when
+ * the memory budget is exceeded. All the methods are thread safe, one
+ * cache can be shared by the generators of several workers. */
+class REVENGE_API SVGEMFCache {
+  public:
+    typedef std::shared_ptr<const std::string> Fragment;
+
+    //! budget is the approximate memory used by the entries, in bytes
+    explicit SVGEMFCache(size_t budget = 64 * 1024 * 1024);
+
+    //! the fragment converted with key, or NULL if it isn't cached
+    Fragment find(const SVGEMFKey &key);
+    //! remember that key was converted to svg
+    void insert(const SVGEMFKey &key, const Fragment &svg);
+    //! drop all the entries, the counters are kept
+    void clear();
+
+    unsigned long hits() const;
+    unsigned long misses() const;
+    //! memory used by the entries, in bytes
+    size_t memory() const;
+
+  private:
+    SVGEMFCache(const SVGEMFCache &);
+    SVGEMFCache &operator=(const SVGEMFCache &);
+
+    struct Entry {
+        uint64_t hash;
+        std::string emf;
+        double width;
+        double height;
+        std::string nmSpace;
+        Fragment svg;
+    };
+    typedef std::list<Entry> EntryList;
+
+    static bool matches(const Entry &entry, const SVGEMFKey &key);
+    static size_t footprint(const Entry &entry);
+    void erase(EntryList::iterator entry);
+
+    size_t m_budget;
+    size_t m_memory;
+    unsigned long m_hits;
+    unsigned long m_misses;
+    //! most recently used first
+    EntryList m_entries;
+    std::unordered_map<uint64_t, EntryList::iterator> m_index;
+    mutable std::mutex m_mutex;
+};
+}
+
+#endif // SVGEMFCACHE_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,57 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * page sinks receiving the SVG pages produced by SVGDrawingGenerator
+ */
+
+#ifndef SVGPAGESINK_H
+#define SVGPAGESINK_H
+
+#include <stddef.h>
+#include <sys/uio.h>
+#include <string>
+
+#include <librevenge/librevenge-api.h>
+
+namespace vss2svg {
+
+//! receives each page from SVGDrawingGenerator as soon as it is complete
+class REVENGE_API SVGPageSink {
+  public:
+    virtual ~SVGPageSink() {
+    }
+    //! called by endPage with the content of the page, split in count
+    //! chunks to be written in order (as with writev), the data is only
+    //! valid for the duration of the call
+    virtual void writePage(const struct iovec *chunks, size_t count) = 0;
+};
+
+//! page sink writing the pages to <dir>/image-<n>.svg, n starting at 0,
+//! each file ending with an extra newline
+class REVENGE_API SVGFilePageSink : public SVGPageSink {
+  public:
+    explicit SVGFilePageSink(const std::string &dir);
+
+    void writePage(const struct iovec *chunks, size_t count);
+
+    //! number of pages received so far
+    unsigned pageCount() const {
+        return m_pageCount;
+    }
+    //! false if at least one page could not be written
+    bool good() const {
+        return m_good;
+    }
+    //! start again at image-0.svg in another directory
+    void reset(const std::string &dir);
+
+  private:
+    std::string m_dir;
+    unsigned m_pageCount;
+    bool m_good;
+};
+}
+
+#endif // SVGPAGESINK_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
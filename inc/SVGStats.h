@@ -0,0 +1,236 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * timers and counters of the phases of a conversion
+ */
+
+#ifndef SVGSTATS_H
+#define SVGSTATS_H
+
+#include <stdint.h>
+#include <atomic>
+#include <ostream>
+
+#include <librevenge/librevenge-api.h>
+#include <librevenge/librevenge.h>
+
+namespace vss2svg {
+
+// the RVNGDrawingInterface callbacks implemented by SVGDrawingGenerator
+#define SVG_STATS_CALLBACKS(X)                                                 \
+    X(START_DOCUMENT, startDocument)                                           \
+    X(END_DOCUMENT, endDocument)                                               \
+    X(SET_DOCUMENT_META_DATA, setDocumentMetaData)                             \
+    X(DEFINE_EMBEDDED_FONT, defineEmbeddedFont)                                \
+    X(START_PAGE, startPage)                                                   \
+    X(END_PAGE, endPage)                                                       \
+    X(START_MASTER_PAGE, startMasterPage)                                      \
+    X(END_MASTER_PAGE, endMasterPage)                                          \
+    X(START_LAYER, startLayer)                                                 \
+    X(END_LAYER, endLayer)                                                     \
+    X(START_EMBEDDED_GRAPHICS, startEmbeddedGraphics)                          \
+    X(END_EMBEDDED_GRAPHICS, endEmbeddedGraphics)                              \
+    X(OPEN_GROUP, openGroup)                                                   \
+    X(CLOSE_GROUP, closeGroup)                                                 \
+    X(SET_STYLE, setStyle)                                                     \
+    X(DRAW_RECTANGLE, drawRectangle)                                           \
+    X(DRAW_ELLIPSE, drawEllipse)                                               \
+    X(DRAW_POLYLINE, drawPolyline)                                             \
+    X(DRAW_POLYGON, drawPolygon)                                               \
+    X(DRAW_PATH, drawPath)                                                     \
+    X(DRAW_GRAPHIC_OBJECT, drawGraphicObject)                                  \
+    X(DRAW_CONNECTOR, drawConnector)                                           \
+    X(START_TEXT_OBJECT, startTextObject)                                      \
+    X(END_TEXT_OBJECT, endTextObject)                                          \
+    X(START_TABLE_OBJECT, startTableObject)                                    \
+    X(OPEN_TABLE_ROW, openTableRow)                                            \
+    X(CLOSE_TABLE_ROW, closeTableRow)                                          \
+    X(OPEN_TABLE_CELL, openTableCell)                                          \
+    X(CLOSE_TABLE_CELL, closeTableCell)                                        \
+    X(INSERT_COVERED_TABLE_CELL, insertCoveredTableCell)                       \
+    X(END_TABLE_OBJECT, endTableObject)                                        \
+    X(OPEN_ORDERED_LIST_LEVEL, openOrderedListLevel)                           \
+    X(CLOSE_ORDERED_LIST_LEVEL, closeOrderedListLevel)                         \
+    X(OPEN_UNORDERED_LIST_LEVEL, openUnorderedListLevel)                       \
+    X(CLOSE_UNORDERED_LIST_LEVEL, closeUnorderedListLevel)                     \
+    X(OPEN_LIST_ELEMENT, openListElement)                                      \
+    X(CLOSE_LIST_ELEMENT, closeListElement)                                    \
+    X(DEFINE_PARAGRAPH_STYLE, defineParagraphStyle)                            \
+    X(OPEN_PARAGRAPH, openParagraph)                                           \
+    X(CLOSE_PARAGRAPH, closeParagraph)                                         \
+    X(DEFINE_CHARACTER_STYLE, defineCharacterStyle)                            \
+    X(OPEN_SPAN, openSpan)                                                     \
+    X(CLOSE_SPAN, closeSpan)                                                   \
+    X(OPEN_LINK, openLink)                                                     \
+    X(CLOSE_LINK, closeLink)                                                   \
+    X(INSERT_TAB, insertTab)                                                   \
+    X(INSERT_SPACE, insertSpace)                                               \
+    X(INSERT_TEXT, insertText)                                                 \
+    X(INSERT_LINE_BREAK, insertLineBreak)                                      \
+    X(INSERT_FIELD, insertField)
+
+/* Timers and counters of a conversion, filled by the SVGDrawingGenerator
+ * given it with setStats, by SVGStatsInputStream and by the caller, the
+ * latter timing the passes of libvisio with its pass hook. The
+ * updates are atomic, the EMF conversions running in the background add
+ * to the same object. When a generator has no stats object, which is the
+ * default, none of this is measured. */
+class REVENGE_API SVGStats {
+  public:
+#define SVG_STATS_ENUM(id, name) id,
+    enum Callback { SVG_STATS_CALLBACKS(SVG_STATS_ENUM) CALLBACK_COUNT };
+#undef SVG_STATS_ENUM
+
+    enum Counter {
+        PAGES,
+        //! SVG bytes handed to the page sink
+        BYTES_EMITTED,
+        EMF_IMAGES,
+        //! EMF images found in the cache of conversions
+        EMF_CACHE_HITS,
+        //! streams extracted from an OLE2 or ZIP container
+        SUB_STREAMS,
+        //! bytes read from those streams, once decompressed
+        BYTES_EXTRACTED,
+        //! points of the polylines replacing NURBS curves
+        NURBS_POINTS,
+        //! points dropped by the simplification of the polylines and paths
+        POINTS_DROPPED,
+        COUNTER_COUNT
+    };
+
+    //! in nanoseconds
+    enum Timer {
+        //! whole conversion, between beginConversion and endConversion
+        CONVERSION,
+        //! reading the streams of the container, inflating the ZIP ones
+        EXTRACTION,
+        /* from beginConversion to the first callback, extraction excluded:
+         * libvisio runs its styles pass and most of its content pass over
+         * the whole document before it draws the first page */
+        PARSING,
+        /* the passes of libvisio, reported by its pass hook; extraction
+         * and decompression are included, the content pass also includes
+         * the drawing of the pages and thus the callbacks */
+        STYLES,
+        CONTENT,
+        //! decoding the LZ77 streams of the binary formats, in libvisio
+        DECOMPRESSION,
+        //! spent in the callbacks of the generator
+        CALLBACKS,
+        //! spent in emf2svg, inline or in the background
+        EMF,
+        //! part of EMF spent inline, in the callbacks
+        EMF_INLINE,
+        TIMER_COUNT
+    };
+
+    SVGStats();
+
+    void beginConversion();
+    void endConversion();
+
+    //! a call to callback that took ns nanoseconds
+    void addCall(Callback callback, uint64_t ns);
+    void add(Counter counter, uint64_t value = 1) {
+        m_counters[counter].fetch_add(value, std::memory_order_relaxed);
+    }
+    void addTime(Timer timer, uint64_t ns) {
+        m_timers[timer].fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    uint64_t calls(Callback callback) const {
+        return m_calls[callback].load(std::memory_order_relaxed);
+    }
+    uint64_t value(Counter counter) const {
+        return m_counters[counter].load(std::memory_order_relaxed);
+    }
+    uint64_t time(Timer timer) const {
+        return m_timers[timer].load(std::memory_order_relaxed);
+    }
+
+    //! zero everything, for instance before the next input
+    void reset();
+    //! add the timers and counters of other to this one
+    void merge(const SVGStats &other);
+
+    //! human readable report, one value per line
+    void write(std::ostream &os) const;
+    //! the same as a JSON object
+    void writeJSON(std::ostream &os) const;
+
+    static const char *callbackName(Callback callback);
+    //! monotonic clock, in nanoseconds
+    static uint64_t now();
+
+  private:
+    SVGStats(const SVGStats &);
+    SVGStats &operator=(const SVGStats &);
+
+    std::atomic<uint64_t> m_calls[CALLBACK_COUNT];
+    std::atomic<uint64_t> m_callTimes[CALLBACK_COUNT];
+    std::atomic<uint64_t> m_counters[COUNTER_COUNT];
+    std::atomic<uint64_t> m_timers[TIMER_COUNT];
+    //! when the current conversion began, 0 if none is in progress
+    uint64_t m_begin;
+    //! whether the first callback of the conversion was seen
+    std::atomic<bool> m_called;
+};
+
+//! add the time spent in its scope to a timer, nothing if stats is NULL
+class SVGScopedTimer {
+  public:
+    SVGScopedTimer(SVGStats *stats, SVGStats::Timer timer)
+        : m_stats(stats), m_timer(timer), m_start(stats ? SVGStats::now() : 0) {
+    }
+    ~SVGScopedTimer() {
+        if (m_stats)
+            m_stats->addTime(m_timer, SVGStats::now() - m_start);
+    }
+
+  private:
+    SVGScopedTimer(const SVGScopedTimer &);
+    SVGScopedTimer &operator=(const SVGScopedTimer &);
+
+    SVGStats *m_stats;
+    SVGStats::Timer m_timer;
+    uint64_t m_start;
+};
+
+/* Input stream timing the extraction of the sub-streams of input in the
+ * EXTRACTION timer of stats, and counting them and their bytes. The
+ * sub-streams it returns are wrapped as well; input is not owned. */
+class REVENGE_API SVGStatsInputStream : public librevenge::RVNGInputStream {
+  public:
+    SVGStatsInputStream(librevenge::RVNGInputStream *input, SVGStats &stats);
+    ~SVGStatsInputStream();
+
+    bool isStructured();
+    unsigned subStreamCount();
+    const char *subStreamName(unsigned id);
+    bool existsSubStream(const char *name);
+    librevenge::RVNGInputStream *getSubStreamByName(const char *name);
+    librevenge::RVNGInputStream *getSubStreamById(unsigned id);
+
+    const unsigned char *read(unsigned long numBytes,
+                              unsigned long &numBytesRead);
+    int seek(long offset, librevenge::RVNG_SEEK_TYPE seekType);
+    long tell();
+    bool isEnd();
+
+  private:
+    SVGStatsInputStream(const SVGStatsInputStream &);
+    SVGStatsInputStream &operator=(const SVGStatsInputStream &);
+
+    //! wrap a sub-stream, which is then owned
+    librevenge::RVNGInputStream *wrap(librevenge::RVNGInputStream *stream);
+
+    librevenge::RVNGInputStream *m_input;
+    SVGStats &m_stats;
+    bool m_own;
+};
+}
+
+#endif // SVGSTATS_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,95 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * spans of a conversion, exported in the Chrome trace event format
+ */
+
+#ifndef SVGTRACE_H
+#define SVGTRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <ostream>
+
+#include <librevenge/librevenge-api.h>
+
+namespace vss2svg {
+
+/* Fixed size buffer of spans (a name, a category, when it began and how
+ * long it lasted), allocated once. Recording a span claims a slot with an
+ * atomic increment, so that several threads (the EMF conversions running
+ * in the background) can record at the same time without a lock; once
+ * the buffer is full, the spans are counted as dropped. The names and the
+ * categories are not copied, they must be string literals. */
+class REVENGE_API SVGTrace {
+  public:
+    explicit SVGTrace(size_t capacity = 256 * 1024);
+    ~SVGTrace();
+
+    /* record a span which began at start, as given by now(), and ends
+     * now; id, if not negative, is written as its argument */
+    void record(const char *name, const char *category, uint64_t start,
+                long id = -1);
+
+    //! forget the spans, for instance before the next input
+    void reset();
+    size_t size() const;
+    size_t dropped() const;
+
+    //! the spans in the Chrome trace event format, which chrome://tracing
+    //! and Perfetto load
+    void writeJSON(std::ostream &os) const;
+
+    //! monotonic clock, in nanoseconds
+    static uint64_t now();
+
+  private:
+    SVGTrace(const SVGTrace &);
+    SVGTrace &operator=(const SVGTrace &);
+
+    struct Event {
+        const char *name;
+        const char *category;
+        uint64_t start;
+        uint64_t duration;
+        long id;
+        unsigned thread;
+    };
+
+    Event *m_events;
+    size_t m_capacity;
+    //! next free slot, may exceed the capacity
+    std::atomic<size_t> m_next;
+    //! origin of the timestamps
+    uint64_t m_origin;
+};
+
+//! record the span of its scope, nothing if trace is NULL
+class SVGTraceScope {
+  public:
+    SVGTraceScope(SVGTrace *trace, const char *name, const char *category,
+                  long id = -1)
+        : m_trace(trace), m_name(name), m_category(category), m_id(id),
+          m_start(trace ? SVGTrace::now() : 0) {
+    }
+    ~SVGTraceScope() {
+        if (m_trace)
+            m_trace->record(m_name, m_category, m_start, m_id);
+    }
+
+  private:
+    SVGTraceScope(const SVGTraceScope &);
+    SVGTraceScope &operator=(const SVGTraceScope &);
+
+    SVGTrace *m_trace;
+    const char *m_name;
+    const char *m_category;
+    long m_id;
+    uint64_t m_start;
+};
+}
+
+#endif // SVGTRACE_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,331 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * corpus benchmark of the whole conversion: parseStencils feeding a
+ * SVGDrawingGenerator, over every Visio file found under a directory.
+ * Reports, per file and in total, the wall time, pages per second, SVG
+ * bytes produced, peak RSS and C++ allocations, as JSON on stdout so
+ * that runs can be compared.
+ *
+ * usage: bench-corpus <dir> [runs]
+ * each file is converted runs times (default 3), the fastest run is kept
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include <librevenge-stream/librevenge-stream.h>
+#include <librevenge/librevenge.h>
+#include <libvisio/libvisio.h>
+
+#include "SVGDrawingGenerator.h"
+#include "SVGPageSink.h"
+
+namespace {
+
+std::atomic<unsigned long> g_allocations(0);
+std::atomic<unsigned long> g_allocatedBytes(0);
+
+void *countedAlloc(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+}
+
+// count every C++ allocation of the process, the libraries included
+void *operator new(size_t size) {
+    return countedAlloc(size);
+}
+
+void *operator new[](size_t size) {
+    return countedAlloc(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    try {
+        return countedAlloc(size);
+    } catch (...) {
+        return NULL;
+    }
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+    try {
+        return countedAlloc(size);
+    } catch (...) {
+        return NULL;
+    }
+}
+
+void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+    free(ptr);
+}
+
+namespace {
+
+//! counts the pages and their bytes, without writing them anywhere
+class CountingPageSink : public vss2svg::SVGPageSink {
+  public:
+    CountingPageSink() : m_pages(0), m_bytes(0) {
+    }
+    void writePage(const struct iovec *chunks, size_t count) {
+        m_pages++;
+        for (size_t i = 0; i < count; i++)
+            m_bytes += chunks[i].iov_len;
+    }
+    void reset() {
+        m_pages = 0;
+        m_bytes = 0;
+    }
+    unsigned pages() const {
+        return m_pages;
+    }
+    unsigned long bytes() const {
+        return m_bytes;
+    }
+
+  private:
+    unsigned m_pages;
+    unsigned long m_bytes;
+};
+
+struct Result {
+    std::string file;
+    bool ok;
+    double seconds;
+    unsigned pages;
+    unsigned long outputBytes;
+    long peakRSS;
+    unsigned long allocations;
+    unsigned long allocatedBytes;
+};
+
+bool isVisioFile(const std::string &name) {
+    static const char *extensions[] = {".vss", ".vssx", ".vssm", ".vsd",
+                                       ".vsdx", ".vsdm", ".vst",  ".vstx",
+                                       ".vstm", ".vdx",  ".vsx",  ".vtx",
+                                       NULL};
+    size_t dot = name.rfind('.');
+    if (dot == std::string::npos)
+        return false;
+    std::string ext = name.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    for (int i = 0; extensions[i]; i++)
+        if (ext == extensions[i])
+            return true;
+    return false;
+}
+
+void findFiles(const std::string &path, std::vector<std::string> &files) {
+    DIR *dir = opendir(path.c_str());
+    if (dir == NULL)
+        return;
+    std::vector<std::string> entries;
+    for (struct dirent *ent = readdir(dir); ent != NULL; ent = readdir(dir)) {
+        if (strcmp(ent->d_name, ".") && strcmp(ent->d_name, ".."))
+            entries.push_back(ent->d_name);
+    }
+    closedir(dir);
+    std::sort(entries.begin(), entries.end());
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        std::string entry = path + "/" + entries[i];
+        struct stat st;
+        if (stat(entry.c_str(), &st) != 0)
+            continue;
+        if (S_ISDIR(st.st_mode))
+            findFiles(entry, files);
+        else if (S_ISREG(st.st_mode) && isVisioFile(entries[i]))
+            files.push_back(entry);
+    }
+}
+
+/* Linux keeps the peak RSS in VmHWM, which can be reset by writing 5 to
+ * clear_refs; elsewhere, only the peak of the whole process is known. */
+void resetPeakRSS() {
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (!f)
+        return;
+    fputs("5", f);
+    fclose(f);
+}
+
+long peakRSS() {
+    FILE *f = fopen("/proc/self/status", "r");
+    if (f) {
+        char line[256];
+        long kb = -1;
+        while (fgets(line, sizeof(line), f))
+            if (!strncmp(line, "VmHWM:", 6))
+                kb = strtol(line + 6, NULL, 10);
+        fclose(f);
+        if (kb >= 0)
+            return kb;
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+bool convert(const std::string &file, vss2svg::SVGDrawingGenerator &generator) {
+#ifdef HAVE_RVNG_MMAP_STREAM
+    librevenge::RVNGMMapStream input(file.c_str());
+#else
+    librevenge::RVNGFileStream input(file.c_str());
+#endif
+    if (!libvisio::VisioDocument::isSupported(&input))
+        return false;
+    return libvisio::VisioDocument::parseStencils(&input, &generator);
+}
+
+Result run(const std::string &file, unsigned runs) {
+    CountingPageSink sink;
+    vss2svg::SVGDrawingGenerator generator(sink, NULL);
+    Result result = {file, true, 0, 0, 0, 0, 0, 0};
+    for (unsigned r = 0; r < runs && result.ok; r++) {
+        sink.reset();
+        resetPeakRSS();
+        unsigned long allocations = g_allocations;
+        unsigned long allocatedBytes = g_allocatedBytes;
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        result.ok = convert(file, generator) && sink.pages();
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        // the counters and the peak RSS of the first run, which includes
+        // the warm up of the caches
+        if (r == 0) {
+            result.seconds = elapsed.count();
+            result.peakRSS = peakRSS();
+            result.allocations = g_allocations - allocations;
+            result.allocatedBytes = g_allocatedBytes - allocatedBytes;
+        } else
+            result.seconds = std::min(result.seconds, elapsed.count());
+        result.pages = sink.pages();
+        result.outputBytes = sink.bytes();
+    }
+    return result;
+}
+
+std::string jsonString(const std::string &str) {
+    std::string out("\"");
+    for (size_t i = 0; i < str.size(); i++) {
+        unsigned char c = (unsigned char)str[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += (char)c;
+        } else if (c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else
+            out += (char)c;
+    }
+    return out + "\"";
+}
+
+void writeStats(std::ostream &os, double seconds, unsigned pages,
+                unsigned long outputBytes, long peakRSS,
+                unsigned long allocations, unsigned long allocatedBytes) {
+    os << "\"seconds\": " << seconds << ", \"pages\": " << pages
+       << ", \"pages_per_second\": " << (seconds > 0 ? pages / seconds : 0)
+       << ", \"output_bytes\": " << outputBytes
+       << ", \"peak_rss_kb\": " << peakRSS
+       << ", \"allocations\": " << allocations
+       << ", \"allocated_bytes\": " << allocatedBytes;
+}
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <dir> [runs]\n";
+        return 1;
+    }
+    unsigned runs = argc > 2 ? strtoul(argv[2], NULL, 10) : 3;
+    if (runs == 0)
+        runs = 1;
+
+    std::string root(argv[1]);
+    while (root.size() > 1 && root[root.size() - 1] == '/')
+        root.erase(root.size() - 1);
+    std::vector<std::string> files;
+    findFiles(root, files);
+    if (files.empty()) {
+        std::cerr << "[ERROR] no Visio file found under '" << root << "'\n";
+        return 1;
+    }
+
+    std::vector<Result> results;
+    for (size_t i = 0; i < files.size(); i++) {
+        results.push_back(run(files[i], runs));
+        const Result &r = results.back();
+        std::cerr << (r.ok ? "[OK] " : "[ERROR] ") << r.file << ": "
+                  << r.seconds * 1e3 << " ms, " << r.pages << " page(s)\n";
+    }
+
+    double seconds = 0;
+    unsigned pages = 0, failed = 0;
+    unsigned long outputBytes = 0, allocations = 0, allocatedBytes = 0;
+    long rss = 0;
+    std::ostringstream json;
+    json << "{\n  \"runs\": " << runs << ",\n  \"files\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        json << "    {\"file\": " << jsonString(r.file)
+             << ", \"ok\": " << (r.ok ? "true" : "false") << ", ";
+        writeStats(json, r.seconds, r.pages, r.outputBytes, r.peakRSS,
+                   r.allocations, r.allocatedBytes);
+        json << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        if (!r.ok) {
+            failed++;
+            continue;
+        }
+        seconds += r.seconds;
+        pages += r.pages;
+        outputBytes += r.outputBytes;
+        allocations += r.allocations;
+        allocatedBytes += r.allocatedBytes;
+        rss = std::max(rss, r.peakRSS);
+    }
+    json << "  ],\n  \"total\": {\"files\": " << results.size()
+         << ", \"failed\": " << failed << ", ";
+    writeStats(json, seconds, pages, outputBytes, rss, allocations,
+               allocatedBytes);
+    json << "}\n}\n";
+    std::cout << json.str();
+
+    std::cerr << "total: " << seconds << " s, " << pages << " page(s), "
+              << (seconds > 0 ? pages / seconds : 0) << " pages/s, "
+              << failed << " failure(s)\n";
+    return failed ? 1 : 0;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,118 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * micro benchmark of the coordinate formatting used in the SVG output:
+ * RVNGDoubleProperty::getStr() (the former doubleToString) against
+ * formatDouble, on the number stream of path heavy pages, written in a
+ * std::ostringstream and in a SVGOutputBuffer
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+
+#include <librevenge/librevenge.h>
+
+#include "../lib/SVGNumberFormat.h"
+#include "../lib/SVGOutputBuffer.h"
+
+namespace {
+
+std::string propertyToString(const double value) {
+    librevenge::RVNGProperty *prop =
+        librevenge::RVNGPropertyFactory::newDoubleProp(value);
+    std::string retVal = prop->getStr().cstr();
+    delete prop;
+    return retVal;
+}
+
+/* Coordinates as libvisio hands them to drawPath: inches on a letter
+ * sized page, some on a grid, most of them computed by the NURBS and
+ * arc approximations, then scaled to SVG units. */
+std::vector<double> pathCoordinates(size_t count) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> coord(0.0, 11.0);
+    std::uniform_int_distribution<int> grid(0, 88);
+    std::vector<double> values(count);
+    for (size_t i = 0; i < count; i++)
+        values[i] = 631 * (i % 4 ? coord(gen) : grid(gen) / 8.0);
+    return values;
+}
+
+template <typename F>
+double run(const std::vector<double> &values, unsigned pages, F emit,
+           std::string &out) {
+    std::ostringstream sink;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (unsigned p = 0; p < pages; p++) {
+        sink.str("");
+        for (size_t i = 0; i < values.size(); i += 2) {
+            sink << "\nL";
+            emit(sink, values[i]);
+            sink << ",";
+            emit(sink, values[i + 1]);
+        }
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    out = sink.str();
+    return elapsed.count();
+}
+
+double runBuffer(const std::vector<double> &values, unsigned pages,
+                 std::string &out) {
+    vss2svg::SVGOutputBuffer sink;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (unsigned p = 0; p < pages; p++) {
+        sink.clear();
+        for (size_t i = 0; i < values.size(); i += 2) {
+            sink << "\nL";
+            sink.appendDouble(values[i]);
+            sink << ",";
+            sink.appendDouble(values[i + 1]);
+        }
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    out = sink.str();
+    return elapsed.count();
+}
+}
+
+int main(int argc, char *argv[]) {
+    // one page: 2000 paths of 50 segments
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 200000;
+    unsigned pages = argc > 2 ? strtoul(argv[2], NULL, 10) : 20;
+    std::vector<double> values = pathCoordinates(count);
+
+    std::string before, after, buffered;
+    double tBefore = run(
+        values, pages,
+        [](std::ostream &os, double v) { os << propertyToString(v); }, before);
+    double tAfter = run(
+        values, pages,
+        [](std::ostream &os, double v) { os << vss2svg::FormattedDouble(v); },
+        after);
+    double tBuffer = runBuffer(values, pages, buffered);
+
+    double n = (double)count * pages;
+    std::cout << "numbers formatted:   " << (unsigned long)n << "\n";
+    std::cout << "RVNGDoubleProperty:  " << tBefore * 1e9 / n << " ns/number\n";
+    std::cout << "formatDouble:        " << tAfter * 1e9 / n << " ns/number\n";
+    std::cout << "formatDouble+buffer: " << tBuffer * 1e9 / n << " ns/number\n";
+    std::cout << "speedup:             " << tBefore / tAfter << "x / "
+              << tBefore / tBuffer << "x\n";
+    if (before != after || before != buffered) {
+        std::cerr << "[ERROR] outputs differ\n";
+        return 1;
+    }
+    return 0;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -18,8 +18,18 @@
 
 #include <iostream>
 #include <sstream>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
+#include <glob.h>
+#include <dirent.h>
 #include <librevenge-stream/librevenge-stream.h>
 #include <librevenge-generators/librevenge-generators.h>
 #include <librevenge/librevenge.h>
@@ -31,6 +41,9 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include "SVGDrawingGenerator.h"
+#include "SVGEMFCache.h"
+#include "SVGStats.h"
+#include "SVGTrace.h"
 
 using namespace std;
 
@@ -42,19 +55,72 @@ static char doc[] = "vss2svg -- Visio stencil to SVG converter";
 
 static struct argp_option options[] = {
     {"verbose", 'v', 0, 0, "Produce verbose output"},
-    {"input", 'i', "FILE", 0, "Input Visio .vss file"},
+    {"input", 'i', "FILE", 0,
+     "Input Visio .vss file; its pages are written in the output directory, "
+     "or in <output>/<basename of FILE>/ when a batch mode is given too"},
     {"output", 'o', "FILE/DIR", 0, "Output file (yED) or directory (svg)"},
     {"version", 'V', 0, 0, "Print vss2svg version"},
+    {"list", 'l', "FILE", 0,
+     "Batch mode: convert every input listed in FILE (one path per line)"},
+    {"dir", 'd', "DIR", 0,
+     "Batch mode: convert every Visio file found under DIR (recursive)"},
+    {"glob", 'g', "PATTERN", 0,
+     "Batch mode: convert every file matching PATTERN"},
+    {"jobs", 'j', "N", 0,
+     "Number of worker threads in batch mode (default: number of cores)"},
+    {"css-classes", 'c', 0, 0,
+     "Share identical styles as CSS classes in a <style> element per page"},
+    {"scale", 'u', "UNITS", 0,
+     "SVG user units per inch of the drawing (default: 631)"},
+    {"simplify", 'p', "UNITS", 0,
+     "Drop the points of polylines and paths at most UNITS SVG user units "
+     "away from the simplified shape (default: 0, every point is kept)"},
+    {"emf-cache", 'e', "MB", 0,
+     "Memory budget of the cache of converted EMF images, shared by all the "
+     "workers (default: 64, 0 disables it)"},
+    {"emf-threads", 't', "N", 0,
+     "Convert the EMF images on N background threads (default: 0, inline)"},
+    {"stats", 's', 0, 0,
+     "Print the time spent in each phase of the conversion, the callbacks "
+     "and the counters of each input on stderr"},
+    {"stats-json", 'S', 0, 0,
+     "Write the same statistics as stats.json in the output directory of "
+     "each input"},
+    {"trace", 'T', 0, 0,
+     "Record the pages, shapes, EMF conversions and parser passes of each "
+     "input as trace.json (Chrome trace event format) in its output "
+     "directory"},
+#ifdef HAVE_VISIO_NURBS_TOLERANCE
+    {"nurbs-tolerance", 'n', "INCHES", 0,
+     "Largest distance between a NURBS curve and the polyline replacing it "
+     "(default: 0.0002)"},
+#endif
+#ifdef HAVE_VISIO_SINGLE_PASS
+    {"single-pass", 'r', 0, 0,
+     "Parse each input once, replaying the first pass of the parser instead "
+     "of parsing the input again (experimental)"},
+#endif
     {0}};
 
 /* A description of the arguments we accept. */
-static char args_doc[] = "[options] -i <in vss> -o <out dir>";
+static char args_doc[] = "[options] -i <in vss> -o <out dir>\n"
+                         "[options] -l <list>|-d <dir>|-g <glob> -o <out dir>";
 
 struct arguments {
     char *args[2]; /* arg1 & arg2 */
-    bool version, svg, verbose, yed;
+    bool version, svg, verbose, yed, cssClasses, stats, statsJSON,
+        trace, singlePass;
     char *output;
     char *input;
+    char *list;
+    char *dir;
+    char *glob;
+    unsigned jobs;
+    unsigned emfCache;
+    unsigned emfThreads;
+    double nurbsTolerance;
+    double scale;
+    double simplify;
 };
 
 static error_t parse_opt(int key, char *arg, struct argp_state *state) {
@@ -75,6 +141,54 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
     case 'V':
         arguments->version = 1;
         break;
+    case 'l':
+        arguments->list = arg;
+        break;
+    case 'd':
+        arguments->dir = arg;
+        break;
+    case 'g':
+        arguments->glob = arg;
+        break;
+    case 'c':
+        arguments->cssClasses = 1;
+        break;
+    case 's':
+        arguments->stats = 1;
+        break;
+    case 'S':
+        arguments->statsJSON = 1;
+        break;
+    case 'T':
+        arguments->trace = 1;
+        break;
+    case 'r':
+        arguments->singlePass = 1;
+        break;
+    case 'e':
+        arguments->emfCache = (unsigned)atoi(arg);
+        break;
+    case 't':
+        arguments->emfThreads = (unsigned)atoi(arg);
+        break;
+    case 'n':
+        arguments->nurbsTolerance = atof(arg);
+        break;
+    case 'u':
+        arguments->scale = atof(arg);
+        if (!(arguments->scale > 0))
+            argp_error(state, "invalid scale '%s'", arg);
+        break;
+    case 'p':
+        arguments->simplify = atof(arg);
+        if (arguments->simplify < 0)
+            argp_error(state, "invalid simplification tolerance '%s'", arg);
+        break;
+    case 'j':
+        arguments->jobs = (unsigned)atoi(arg);
+        if (arguments->jobs == 0)
+            argp_error(state, "invalid number of jobs '%s'", arg);
+        break;
     case ARGP_KEY_ARG:
         if (state->arg_num >= 6)
             /* Too many arguments. */
@@ -99,19 +213,376 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
 /* Our argp parser. */
 static struct argp argp = {options, parse_opt, args_doc, doc};
 
+/* One input of a batch conversion and the directory its pages go to. */
+struct job {
+    std::string input;
+    std::string output;
+};
+
+static bool isVisioFile(const std::string &name) {
+    static const char *extensions[] = {".vss", ".vssx", ".vssm", ".vsd",
+                                       ".vsdx", ".vsdm", ".vst",  ".vstx",
+                                       ".vstm", ".vdx",  ".vsx",  ".vtx",
+                                       NULL};
+    size_t dot = name.rfind('.');
+    if (dot == std::string::npos)
+        return false;
+    std::string ext = name.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    for (int i = 0; extensions[i]; i++)
+        if (ext == extensions[i])
+            return true;
+    return false;
+}
+
+static std::string baseName(const std::string &path) {
+    size_t slash = path.rfind('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+/* Add a job for each of inputs, its output directory being its path
+ * relative to the deepest directory containing all of them, once made
+ * absolute: two inputs of the same name in different directories are
+ * then converted to different directories. The inputs which cannot be
+ * resolved are reported and left out, their number is returned. */
+static unsigned addJobs(const std::vector<std::string> &inputs,
+                        const std::string &outputdir, std::vector<job> &jobs) {
+    std::vector<std::string> found;
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        char *resolved = realpath(inputs[i].c_str(), NULL);
+        if (resolved == NULL) {
+            std::cerr << "[ERROR] "
+                      << "Impossible to find input '" << inputs[i] << "'\n";
+            continue;
+        }
+        found.push_back(inputs[i]);
+        paths.push_back(resolved);
+        free(resolved);
+    }
+    std::string common;
+    if (!paths.empty())
+        common = paths[0].substr(0, paths[0].rfind('/') + 1);
+    for (size_t i = 1; i < paths.size(); i++) {
+        // drop the last directory until common is a prefix of the path
+        while (!common.empty() && paths[i].compare(0, common.size(), common)) {
+            common.erase(common.size() - 1);
+            common.erase(common.rfind('/') + 1);
+        }
+    }
+    for (size_t i = 0; i < found.size(); i++) {
+        job j = {found[i], outputdir + "/" + paths[i].substr(common.size())};
+        jobs.push_back(j);
+    }
+    return inputs.size() - found.size();
+}
+
+/* Check that no two jobs write to the same output directory, which the
+ * same input given twice would still do. */
+static bool checkOutputs(const std::vector<job> &jobs) {
+    std::map<std::string, const job *> outputs;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        std::pair<std::map<std::string, const job *>::iterator, bool> ret =
+            outputs.insert(std::make_pair(jobs[i].output, &jobs[i]));
+        if (ret.second)
+            continue;
+        std::cerr << "[ERROR] "
+                  << "Inputs '" << ret.first->second->input << "' and '"
+                  << jobs[i].input << "' would both be converted to '"
+                  << jobs[i].output << "'\n";
+        return false;
+    }
+    return true;
+}
+
+static void mkdirs(const std::string &path) {
+    for (size_t pos = path.find('/', 1); pos != std::string::npos;
+         pos = path.find('/', pos + 1))
+        mkdir(path.substr(0, pos).c_str(), S_IRWXU);
+    mkdir(path.c_str(), S_IRWXU);
+}
+
+static void walkDirectory(const std::string &root, const std::string &rel,
+                          const std::string &outputdir,
+                          std::vector<job> &jobs) {
+    std::string path = rel.empty() ? root : root + "/" + rel;
+    DIR *dir = opendir(path.c_str());
+    if (dir == NULL) {
+        std::cerr << "[ERROR] "
+                  << "Impossible to open directory '" << path << "'\n";
+        return;
+    }
+    std::vector<std::string> entries;
+    for (struct dirent *ent = readdir(dir); ent != NULL; ent = readdir(dir)) {
+        if (strcmp(ent->d_name, ".") && strcmp(ent->d_name, ".."))
+            entries.push_back(ent->d_name);
+    }
+    closedir(dir);
+    std::sort(entries.begin(), entries.end());
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        std::string entryrel = rel.empty() ? entries[i] : rel + "/" + entries[i];
+        struct stat st;
+        if (stat((root + "/" + entryrel).c_str(), &st) != 0)
+            continue;
+        if (S_ISDIR(st.st_mode))
+            walkDirectory(root, entryrel, outputdir, jobs);
+        else if (S_ISREG(st.st_mode) && isVisioFile(entries[i])) {
+            job j = {root + "/" + entryrel, outputdir + "/" + entryrel};
+            jobs.push_back(j);
+        }
+    }
+}
+
+//! apply the output options given on the command line to generator
+static void setupGenerator(vss2svg::SVGDrawingGenerator &generator,
+                           const struct arguments &arguments,
+                           vss2svg::SVGEMFCache *emfCache,
+                           vss2svg::SVGStats *stats,
+                           vss2svg::SVGTrace *trace) {
+    generator.setStyleClasses(arguments.cssClasses);
+    generator.setEMFCache(emfCache);
+    generator.setEMFThreads(arguments.emfThreads);
+    generator.setStats(stats);
+    generator.setTrace(trace);
+    generator.setScale(arguments.scale);
+    generator.setSimplification(arguments.simplify);
+}
+
+static void reportEMFCache(const vss2svg::SVGEMFCache *emfCache) {
+    if (!emfCache)
+        return;
+    std::cerr << "[INFO] EMF cache: " << emfCache->hits() << " hit(s), "
+              << emfCache->misses() << " miss(es), " << emfCache->memory()
+              << " bytes used\n";
+}
+
+//! print the statistics of inputfile on stderr and/or write them as JSON
+static void reportStats(const vss2svg::SVGStats &stats,
+                        const std::string &inputfile,
+                        const std::string &outputdir,
+                        const struct arguments &arguments) {
+    if (arguments.statsJSON) {
+        std::ofstream json((outputdir + "/stats.json").c_str());
+        stats.writeJSON(json);
+    }
+    if (arguments.stats) {
+        std::ostringstream text;
+        text << "[STATS] " << inputfile << "\n";
+        stats.write(text);
+        std::cerr << text.str();
+    }
+}
+
+static void writeTrace(const vss2svg::SVGTrace &trace,
+                       const std::string &outputdir) {
+    std::ofstream json((outputdir + "/trace.json").c_str());
+    trace.writeJSON(json);
+}
+
+#ifdef HAVE_VISIO_PASS_HOOK
+//! the passes of libvisio in progress in the thread of a conversion
+struct PassHookData {
+    vss2svg::SVGStats *stats;
+    vss2svg::SVGTrace *trace;
+    //! when each pass began; the decompressions run within the passes
+    uint64_t start[3];
+};
+
+static const char *const passNames[] = {"styles", "content", "decompression"};
+static const vss2svg::SVGStats::Timer passTimers[] = {
+    vss2svg::SVGStats::STYLES, vss2svg::SVGStats::CONTENT,
+    vss2svg::SVGStats::DECOMPRESSION};
+
+//! time the passes reported by libvisio in stats and trace, if not NULL
+static void hookPass(const char *pass, bool begin, void *data) {
+    PassHookData *hookData = (PassHookData *)data;
+    unsigned i = 0;
+    while (i < 3 && strcmp(pass, passNames[i]))
+        i++;
+    if (i == 3)
+        return;
+    if (begin) {
+        hookData->start[i] = vss2svg::SVGStats::now();
+        return;
+    }
+    if (hookData->stats)
+        hookData->stats->addTime(passTimers[i], vss2svg::SVGStats::now() -
+                                                    hookData->start[i]);
+    if (hookData->trace)
+        hookData->trace->record(passNames[i], "libvisio", hookData->start[i]);
+}
+#endif
+
+/* Convert one stencil, writing its pages as image-<k>.svg in outputdir as
+ * soon as they are generated. generator must be bound to sink; both are
+ * reused from one call to the next by the batch workers. The phases of
+ * the conversion are added to stats and its spans to trace, if not NULL,
+ * which must be the ones given to generator. */
+static bool convert(const std::string &inputfile, const std::string &outputdir,
+                    vss2svg::SVGFilePageSink &sink,
+                    vss2svg::SVGDrawingGenerator &generator,
+                    vss2svg::SVGStats *stats, vss2svg::SVGTrace *trace,
+                    std::string &error) {
+    vss2svg::SVGTraceScope span(trace, "convert", "file");
+#ifdef HAVE_RVNG_MMAP_STREAM
+    // the parsers seek back and forth a lot, which is free on a mapping
+    librevenge::RVNGMMapStream input(inputfile.c_str());
+    if (!input.isOpen()) {
+        error = "Impossible to open input file '" + inputfile + "'";
+        return false;
+    }
+#else
+    std::ifstream in(inputfile.c_str());
+    if (!in.is_open()) {
+        error = "Impossible to open input file '" + inputfile + "'";
+        return false;
+    }
+    in.close();
+
+    librevenge::RVNGFileStream input(inputfile.c_str());
+#endif
+    // time the extraction of the streams of the container
+    librevenge::RVNGInputStream *stream = &input;
+    std::unique_ptr<vss2svg::SVGStatsInputStream> statsInput;
+    if (stats) {
+        statsInput.reset(new vss2svg::SVGStatsInputStream(&input, *stats));
+        stream = statsInput.get();
+        stats->beginConversion();
+    }
+#ifdef HAVE_VISIO_NURBS_POINT_COUNT
+    unsigned long nurbsPoints = libvisio::VisioDocument::getNURBSPointCount();
+#endif
+    if (!libvisio::VisioDocument::isSupported(stream)) {
+        error = "Unsupported file format (unsupported version) or file is "
+                "encrypted!";
+        return false;
+    }
+
+    mkdirs(outputdir);
+    sink.reset(outputdir);
+#ifdef HAVE_VISIO_PASS_HOOK
+    PassHookData hookData = {stats, trace, {0, 0, 0}};
+    if (stats || trace)
+        libvisio::VisioDocument::setPassHook(hookPass, &hookData);
+#endif
+    bool parsed = libvisio::VisioDocument::parseStencils(stream, &generator);
+#ifdef HAVE_VISIO_PASS_HOOK
+    if (stats || trace)
+        libvisio::VisioDocument::setPassHook(NULL, NULL);
+#endif
+    if (stats) {
+        stats->endConversion();
+#ifdef HAVE_VISIO_NURBS_POINT_COUNT
+        stats->add(vss2svg::SVGStats::NURBS_POINTS,
+                   libvisio::VisioDocument::getNURBSPointCount() -
+                       nurbsPoints);
+#endif
+    }
+    if (!parsed) {
+        error = "SVG Generation failed!";
+        return false;
+    }
+    if (sink.pageCount() == 0) {
+        error = "No SVG document generated!";
+        return false;
+    }
+    if (!sink.good()) {
+        error = "Impossible to write the SVG files in '" + outputdir + "'";
+        return false;
+    }
+    return true;
+}
+
+/* Convert all the jobs on a fixed pool of workers, each worker owning its
+ * own SVGDrawingGenerator. Returns the number of failed conversions. */
+static unsigned convertBatch(const std::vector<job> &jobs, unsigned nbWorkers,
+                             const struct arguments &arguments,
+                             vss2svg::SVGEMFCache *emfCache,
+                             vss2svg::SVGStats *total) {
+    std::atomic<size_t> next(0);
+    std::atomic<unsigned> failed(0);
+    std::mutex reportMutex;
+
+    if (nbWorkers > jobs.size())
+        nbWorkers = jobs.size();
+
+    auto worker = [&]() {
+        vss2svg::SVGFilePageSink sink(".");
+        vss2svg::SVGDrawingGenerator generator(sink, NULL);
+        std::unique_ptr<vss2svg::SVGStats> stats;
+        if (total)
+            stats.reset(new vss2svg::SVGStats());
+        std::unique_ptr<vss2svg::SVGTrace> trace;
+        if (arguments.trace)
+            trace.reset(new vss2svg::SVGTrace());
+        setupGenerator(generator, arguments, emfCache, stats.get(),
+                       trace.get());
+        for (size_t i = next++; i < jobs.size(); i = next++) {
+            std::string error;
+            if (stats)
+                stats->reset();
+            if (trace)
+                trace->reset();
+            bool ok = convert(jobs[i].input, jobs[i].output, sink, generator,
+                              stats.get(), trace.get(), error);
+            if (!ok)
+                failed++;
+            else if (trace)
+                writeTrace(*trace, jobs[i].output);
+            std::lock_guard<std::mutex> lock(reportMutex);
+            if (ok && stats) {
+                reportStats(*stats, jobs[i].input, jobs[i].output, arguments);
+                total->merge(*stats);
+            }
+            if (!ok)
+                std::cerr << "[ERROR] " << jobs[i].input << ": " << error
+                          << "\n";
+            else if (arguments.verbose)
+                std::cout << "[OK] " << jobs[i].input << " -> "
+                          << jobs[i].output << "\n";
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned w = 1; w < nbWorkers; w++)
+        workers.push_back(std::thread(worker));
+    worker();
+    for (size_t w = 0; w < workers.size(); w++)
+        workers[w].join();
+    return failed;
+}
+
 int main(int argc, char *argv[]) {
     struct arguments arguments;
     arguments.version = 0;
+    arguments.verbose = 0;
+    arguments.cssClasses = 0;
+    arguments.stats = 0;
+    arguments.statsJSON = 0;
+    arguments.trace = 0;
+    arguments.singlePass = 0;
+    arguments.input = NULL;
+    arguments.output = NULL;
+    arguments.list = NULL;
+    arguments.dir = NULL;
+    arguments.glob = NULL;
+    arguments.jobs = 0;
+    arguments.emfCache = 64;
+    arguments.emfThreads = 0;
+    arguments.nurbsTolerance = 0;
+    arguments.scale = 631;
+    arguments.simplify = 0;
     argp_parse(&argp, argc, argv, 0, 0, &arguments);
 
-    librevenge::RVNGFileStream input(arguments.input);
-
     if (arguments.version) {
         std::cout << "vss2svg version: " << V2S_VERSION << "\n";
         return 0;
     }
 
-    if (arguments.input == NULL) {
+    bool batch = arguments.list || arguments.dir || arguments.glob;
+
+    if (arguments.input == NULL && !batch) {
         std::cerr << "[ERROR] "
                   << "Missing --input=FILE argument\n";
         return 1;
@@ -123,42 +594,120 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    std::ifstream in(arguments.input);
-    if (!in.is_open()) {
-        std::cerr << "[ERROR] "
-                  << "Impossible to open input file '" << arguments.input
-                  << "'\n";
-        return 1;
+    std::string outputdir(arguments.output);
+
+#ifdef HAVE_VISIO_NURBS_TOLERANCE
+    libvisio::VisioDocument::setNURBSTolerance(arguments.nurbsTolerance);
+#endif
+#ifdef HAVE_VISIO_SINGLE_PASS
+    libvisio::VisioDocument::setSinglePass(arguments.singlePass);
+#endif
+
+    std::unique_ptr<vss2svg::SVGEMFCache> emfCache;
+    if (arguments.emfCache)
+        emfCache.reset(
+            new vss2svg::SVGEMFCache((size_t)arguments.emfCache << 20));
+
+    std::unique_ptr<vss2svg::SVGStats> stats;
+    if (arguments.stats || arguments.statsJSON)
+        stats.reset(new vss2svg::SVGStats());
+
+    if (!batch) {
+        vss2svg::SVGFilePageSink sink(outputdir);
+        vss2svg::SVGDrawingGenerator generator(sink, NULL);
+        std::unique_ptr<vss2svg::SVGTrace> trace;
+        if (arguments.trace)
+            trace.reset(new vss2svg::SVGTrace());
+        setupGenerator(generator, arguments, emfCache.get(), stats.get(),
+                       trace.get());
+        std::string error;
+        if (!convert(arguments.input, outputdir, sink, generator, stats.get(),
+                     trace.get(), error)) {
+            std::cerr << "[ERROR] " << error << "\n";
+            return 1;
+        }
+        if (trace)
+            writeTrace(*trace, outputdir);
+        if (stats)
+            reportStats(*stats, arguments.input, outputdir, arguments);
+        if (arguments.verbose)
+            reportEMFCache(emfCache.get());
+        return 0;
     }
 
-    if (!libvisio::VisioDocument::isSupported(&input)) {
-        std::cerr << "ERROR: Unsupported file format (unsupported version) or "
-                     "file is encrypted!" << std::endl;
-        return 1;
+    std::vector<job> jobs;
+    // the inputs of --list and --glob which do not exist
+    unsigned missing = 0;
+    // unlike a lone --input, written in a directory named after it, as the
+    // inputs of the batch modes are
+    if (arguments.input) {
+        job j = {arguments.input,
+                 outputdir + "/" + baseName(arguments.input)};
+        jobs.push_back(j);
+    }
+    if (arguments.list) {
+        std::ifstream list(arguments.list);
+        if (!list.is_open()) {
+            std::cerr << "[ERROR] "
+                      << "Impossible to open list file '" << arguments.list
+                      << "'\n";
+            return 1;
+        }
+        std::vector<std::string> inputs;
+        for (std::string line; getline(list, line);) {
+            if (line.empty() || line[0] == '#')
+                continue;
+            inputs.push_back(line);
+        }
+        missing += addJobs(inputs, outputdir, jobs);
+    }
+    if (arguments.glob) {
+        glob_t matches;
+        int ret = glob(arguments.glob, 0, NULL, &matches);
+        if (ret != 0 && ret != GLOB_NOMATCH) {
+            std::cerr << "[ERROR] "
+                      << "Impossible to expand pattern '" << arguments.glob
+                      << "'\n";
+            return 1;
+        }
+        std::vector<std::string> inputs;
+        for (size_t k = 0; ret == 0 && k < matches.gl_pathc; k++)
+            inputs.push_back(matches.gl_pathv[k]);
+        globfree(&matches);
+        missing += addJobs(inputs, outputdir, jobs);
+    }
+    if (arguments.dir) {
+        std::string root(arguments.dir);
+        while (root.size() > 1 && root[root.size() - 1] == '/')
+            root.erase(root.size() - 1);
+        walkDirectory(root, "", outputdir, jobs);
     }
 
-    librevenge::RVNGStringVector output;
-    vss2svg::SVGDrawingGenerator generator(output, NULL);
-    if (!libvisio::VisioDocument::parseStencils(&input, &generator)) {
-        std::cerr << "ERROR: SVG Generation failed!" << std::endl;
+    if (jobs.empty()) {
+        std::cerr << "[ERROR] "
+                  << "No input file to convert\n";
         return 1;
     }
-    if (output.empty()) {
-        std::cerr << "ERROR: No SVG document generated!" << std::endl;
+    if (!checkOutputs(jobs))
         return 1;
-    }
-    std::string outputdir(arguments.output);
-    mkdir(arguments.output, S_IRWXU);
-    for (unsigned k = 0; k < output.size(); ++k) {
-        ofstream myfile;
 
-        std::basic_string<char> newfilename =
-            outputdir + "/image-" + std::to_string(k) + ".svg";
-        myfile.open(newfilename);
-        myfile << output[k].cstr() << std::endl;
-        myfile.close();
-    }
+    unsigned nbWorkers = arguments.jobs;
+    if (nbWorkers == 0)
+        nbWorkers = std::max(1u, std::thread::hardware_concurrency());
 
-    return 0;
+    mkdir(arguments.output, S_IRWXU);
+    unsigned failed =
+        convertBatch(jobs, nbWorkers, arguments, emfCache.get(), stats.get()) +
+        missing;
+    if (arguments.verbose)
+        reportEMFCache(emfCache.get());
+    if (stats && arguments.stats) {
+        // the times of the workers add up, they exceed the elapsed time
+        std::cerr << "[STATS] total\n";
+        stats->write(std::cerr);
+    }
+    std::cerr << "[INFO] " << jobs.size() + missing - failed << "/"
+              << jobs.size() + missing << " file(s) converted\n";
+    return failed ? 1 : 0;
 }
 /* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,129 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * access to the binary properties (embedded images) and base64 coding
+ */
+
+#include <string.h>
+
+#include "SVGBinaryData.h"
+
+namespace vss2svg {
+
+namespace {
+
+const char alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+//! lookup tables, built once when the library is loaded
+struct Base64Tables {
+    Base64Tables() {
+        // two output characters for each 12 bits of input
+        for (unsigned i = 0; i < 4096; i++) {
+            encode[2 * i] = alphabet[i >> 6];
+            encode[2 * i + 1] = alphabet[i & 0x3f];
+        }
+        memset(decode, 0xff, sizeof(decode));
+        for (unsigned i = 0; i < 64; i++)
+            decode[(unsigned char)alphabet[i]] = (unsigned char)i;
+    }
+    char encode[2 * 4096];
+    unsigned char decode[256];
+};
+
+const Base64Tables tables;
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+}
+
+void encodeBase64(const unsigned char *data, size_t size, char *out) {
+    const char *encode = tables.encode;
+    for (; size >= 3; data += 3, size -= 3, out += 4) {
+        unsigned n = (data[0] << 16) | (data[1] << 8) | data[2];
+        memcpy(out, encode + 2 * (n >> 12), 2);
+        memcpy(out + 2, encode + 2 * (n & 0xfff), 2);
+    }
+    if (size) {
+        unsigned n = data[0] << 16;
+        if (size == 2)
+            n |= data[1] << 8;
+        out[0] = alphabet[n >> 18];
+        out[1] = alphabet[(n >> 12) & 0x3f];
+        out[2] = size == 2 ? alphabet[(n >> 6) & 0x3f] : '=';
+        out[3] = '=';
+    }
+}
+
+size_t decodeBase64(const char *text, size_t size, unsigned char *out) {
+    const unsigned char *decode = tables.decode;
+    const char *end = text + size;
+    unsigned char *start = out;
+    unsigned n = 0, count = 0;
+    while (text < end) {
+        // fast path: four valid characters in a row
+        if (count == 0 && end - text >= 4) {
+            unsigned a = decode[(unsigned char)text[0]];
+            unsigned b = decode[(unsigned char)text[1]];
+            unsigned c = decode[(unsigned char)text[2]];
+            unsigned d = decode[(unsigned char)text[3]];
+            if ((a | b | c | d) < 64) {
+                n = (a << 18) | (b << 12) | (c << 6) | d;
+                out[0] = (unsigned char)(n >> 16);
+                out[1] = (unsigned char)(n >> 8);
+                out[2] = (unsigned char)n;
+                out += 3;
+                text += 4;
+                continue;
+            }
+        }
+        char ch = *text++;
+        if (isSpace(ch))
+            continue;
+        unsigned value = decode[(unsigned char)ch];
+        if (value >= 64)
+            break;
+        n = (n << 6) | value;
+        if (++count == 4) {
+            out[0] = (unsigned char)(n >> 16);
+            out[1] = (unsigned char)(n >> 8);
+            out[2] = (unsigned char)n;
+            out += 3;
+            n = count = 0;
+        }
+    }
+    // a partial group holds 1 or 2 bytes
+    if (count >= 2) {
+        n <<= 6 * (4 - count);
+        *out++ = (unsigned char)(n >> 16);
+        if (count == 3)
+            *out++ = (unsigned char)(n >> 8);
+    }
+    return (size_t)(out - start);
+}
+
+void getBinaryData(const librevenge::RVNGProperty *prop,
+                   std::vector<unsigned char> &scratch,
+                   const unsigned char *&data, size_t &size) {
+    data = NULL;
+    size = 0;
+    if (!prop)
+        return;
+#ifdef HAVE_RVNG_BINARY_DATA_ACCESS
+    const librevenge::RVNGBinaryData *binary =
+        librevenge::RVNGPropertyFactory::getBinaryData(prop);
+    if (binary) {
+        data = binary->getDataBuffer();
+        size = (size_t)binary->size();
+        return;
+    }
+#endif
+    librevenge::RVNGString base64 = prop->getStr();
+    scratch.resize(base64.size() / 4 * 3 + 3);
+    size = decodeBase64(base64.cstr(), base64.size(), &scratch[0]);
+    data = &scratch[0];
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
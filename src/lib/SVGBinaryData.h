@@ -0,0 +1,43 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * access to the binary properties (embedded images) and base64 coding
+ */
+
+#ifndef SVGBINARYDATA_H
+#define SVGBINARYDATA_H
+
+#include <stddef.h>
+#include <vector>
+
+#include <librevenge/librevenge.h>
+
+namespace vss2svg {
+
+//! number of characters of the base64 encoding of size bytes
+inline size_t base64EncodedSize(size_t size) {
+    return (size + 2) / 3 * 4;
+}
+
+//! encode size bytes in out, which must hold base64EncodedSize(size)
+//! characters (no NUL is added)
+void encodeBase64(const unsigned char *data, size_t size, char *out);
+
+//! decode size characters of base64 in out, which must hold size / 4 * 3 + 3
+//! bytes; whitespaces are skipped and the decoding stops at the first '='
+//! or invalid character. Returns the number of bytes written.
+size_t decodeBase64(const char *text, size_t size, unsigned char *out);
+
+/* The raw bytes of a binary property, such as office:binary-data or
+ * draw:fill-image. When librevenge gives access to them, no copy is
+ * made; otherwise (older librevenge, or a base64 string property) they
+ * are decoded in scratch. data and size stay valid as long as the
+ * property and scratch are neither modified nor destroyed. */
+void getBinaryData(const librevenge::RVNGProperty *prop,
+                   std::vector<unsigned char> &scratch,
+                   const unsigned char *&data, size_t &size);
+}
+
+#endif // SVGBINARYDATA_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -27,9 +27,15 @@
 
 // <<<<<<<<<<<<<<<<<< END ORIGINAL HEADER >>>>>>>>>>>>>>>>>>>>>>>>>>>
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <future>
 #include <map>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <stdio.h>
 #include <iostream>
 #include <fstream>
@@ -38,21 +44,22 @@
 #include <librevenge-generators/librevenge-generators.h>
 #include <librevenge/RVNGBinaryData.h>
 
+#include "SVGBinaryData.h"
 #include "SVGDrawingGenerator.h"
-#include <emf2svg.h>
+#include "SVGEMFCache.h"
+#include "SVGEMFConverter.h"
+#include "SVGNumberFormat.h"
+#include "SVGOutputBuffer.h"
+#include "SVGSimplifier.h"
+#include "SVGStats.h"
+#include "SVGStyle.h"
+#include "SVGTrace.h"
+#include "SVGTransform.h"
 
 namespace vss2svg {
 
 namespace {
 
-static std::string doubleToString(const double value) {
-    librevenge::RVNGProperty *prop =
-        librevenge::RVNGPropertyFactory::newDoubleProp(value);
-    std::string retVal = prop->getStr().cstr();
-    delete prop;
-    return retVal;
-}
-
 static unsigned stringToColour(const librevenge::RVNGString &s) {
     std::string str(s.cstr());
     if (str[0] == '#') {
@@ -69,16 +76,103 @@ static unsigned stringToColour(const librevenge::RVNGString &s) {
     return val;
 }
 
+//! page sink appending the pages to a RVNGStringVector
+class StringVectorPageSink : public SVGPageSink {
+  public:
+    explicit StringVectorPageSink(librevenge::RVNGStringVector &vec)
+        : m_vec(vec) {
+    }
+    void writePage(const struct iovec *chunks, size_t count) {
+        std::string page;
+        for (size_t i = 0; i < count; i++)
+            page.append((const char *)chunks[i].iov_base, chunks[i].iov_len);
+        m_vec.append(page.c_str());
+    }
+
+  private:
+    librevenge::RVNGStringVector &m_vec;
+};
+
+//! the callbacks drawing a shape, traced one by one
+inline bool isShapeCallback(SVGStats::Callback callback) {
+    return callback >= SVGStats::DRAW_RECTANGLE &&
+           callback <= SVGStats::DRAW_CONNECTOR;
+}
+
+//! count a callback and time it, nothing if stats and trace are NULL
+class CallbackScope {
+  public:
+    CallbackScope(SVGStats *stats, SVGTrace *trace,
+                  SVGStats::Callback callback)
+        : m_stats(stats),
+          m_trace(trace && isShapeCallback(callback) ? trace : NULL),
+          m_callback(callback),
+          m_start(m_stats || m_trace ? SVGStats::now() : 0) {
+    }
+    ~CallbackScope() {
+        if (m_stats)
+            m_stats->addCall(m_callback, SVGStats::now() - m_start);
+        if (m_trace)
+            m_trace->record(SVGStats::callbackName(m_callback), "shape",
+                            m_start);
+    }
+
+  private:
+    CallbackScope(const CallbackScope &);
+    CallbackScope &operator=(const CallbackScope &);
+
+    SVGStats *m_stats;
+    SVGTrace *m_trace;
+    SVGStats::Callback m_callback;
+    uint64_t m_start;
+};
+
 } // anomymous namespace
 
 struct SVGDrawingGeneratorPrivate {
-    SVGDrawingGeneratorPrivate(librevenge::RVNGStringVector &vec,
+    SVGDrawingGeneratorPrivate(SVGPageSink *sink, bool ownSink,
                                const librevenge::RVNGString &nmSpace);
+    ~SVGDrawingGeneratorPrivate();
 
     void setStyle(const librevenge::RVNGPropertyList &propList);
+    //! write the style attribute of the current shape
     void writeStyle(bool isClosed = true);
+    //! format the declarations of the current style in m_styleDecl
+    void formatStyle();
+    //! write the <style> element holding the classes of the page
+    void writeStyleClasses();
+    //! forget the classes, at the start of each page
+    void resetStyleClasses();
+    //! hand the current page to the sink, or queue it if some of its EMF
+    //! images are still being converted
+    void endPage();
+    //! write the queued pages whose images are converted, all of them
+    //! (waiting for the conversions) if wait is true
+    void flushPages(bool wait);
+    //! drop the queued pages, for instance those of an aborted document
+    void discardPages();
+    //! hand a complete page to the sink
+    void writePage(const SVGOutputBuffer &buffer);
+    //! write the base64 encoding of a binary property
+    void writeBinary(const librevenge::RVNGProperty *prop);
     void drawPolySomething(const librevenge::RVNGPropertyListVector &vertices,
                            bool isClosed);
+    //! write a path given as the property lists of its segments
+    void drawPath(const librevenge::RVNGPropertyListVector &path);
+    //! write the point of seg at the keys x and y, transformed, as "x,y"
+    void writePoint(const SVGProperties &seg, SVGKey x, SVGKey y);
+#ifdef HAVE_RVNG_PATH
+    //! write a path given as arrays of actions and coordinates
+    void drawPath(const librevenge::RVNGPath &path);
+    /* Simplify the runs of lines of the count segments doing actions,
+     * whose coordinates are in m_points: the actions left go to
+     * m_actions, the coordinates are compacted in m_points. */
+    void simplifyPath(const unsigned char *actions, unsigned long count);
+#endif
+    //! simplify the count points of m_points, returns the number kept
+    size_t simplifyPoints(double *points, size_t count);
+    //! close the path element opened by drawPath
+    void endPath(bool isClosed);
 
     //! return the namespace and the delimiter
     std::string const &getNamespaceAndDelim() const {
@@ -89,6 +183,8 @@ struct SVGDrawingGeneratorPrivate {
 
     librevenge::RVNGPropertyListVector m_gradient;
     librevenge::RVNGPropertyList m_style;
+    //! m_style, resolved and decoded by setStyle
+    SVGStyle m_styleProps;
     int m_gradientIndex, m_shadowIndex;
     //! index uses when fill=bitmap
     int m_patternIndex;
@@ -100,43 +196,113 @@ struct SVGDrawingGeneratorPrivate {
     std::string m_nmSpace;
     //! a prefix used to define the svg namespace with delimiter
     std::string m_nmSpaceAndDelim;
-    std::ostringstream m_outputSink;
-    librevenge::RVNGStringVector &m_vec;
+    SVGOutputBuffer m_outputSink;
+    //! declarations of the current style, formatted once per setStyle
+    SVGOutputBuffer m_styleBuffer;
+    std::string m_styleDecl;
+    bool m_styleDeclValid;
+    //! reference shared classes instead of writing inline styles
+    bool m_useStyleClasses;
+    //! the classes of the page, by declarations and in creation order
+    std::unordered_map<std::string, unsigned> m_styleClassIds;
+    std::vector<const std::string *> m_styleClasses;
+    //! class of the current style, -1 if not looked up yet
+    int m_styleClass;
+    //! decoded images, when librevenge doesn't give access to the bytes
+    std::vector<unsigned char> m_binaryScratch;
+    //! conversions of the EMF images, NULL if not cached
+    SVGEMFCache *m_emfCache;
+    //! converts the EMF images in the background, NULL to convert inline
+    SVGEMFConverter *m_emfConverter;
+    //! where the timers and counters go, NULL if not measured
+    SVGStats *m_stats;
+    //! where the spans go, NULL if not traced
+    SVGTrace *m_trace;
+    //! from the inches of libvisio to the user units of the output
+    SVGTransform m_transform;
+    //! points of the current polyline or path, once transformed
+    std::vector<double> m_points;
+    //! drops the redundant points of m_points, disabled by default
+    SVGSimplifier m_simplifier;
+    //! actions of the current path, once simplified
+    std::vector<unsigned char> m_actions;
+    //! when the current page was started, and its index in the document
+    uint64_t m_pageStart;
+    long m_pageIndex;
+
+    //! an EMF image waiting for its conversion
+    struct PendingEMF {
+        size_t slot;
+        std::shared_future<SVGEMFCache::Fragment> result;
+        //! keeps the fragment alive until the page is written
+        SVGEMFCache::Fragment svg;
+    };
+    //! a complete page waiting for some of its EMF images
+    struct PendingPage {
+        SVGOutputBuffer buffer;
+        std::vector<PendingEMF> emfs;
+    };
+    //! EMF images of the current page
+    std::vector<PendingEMF> m_pendingEMF;
+    //! pages waiting to be written, in order
+    std::deque<PendingPage *> m_pendingPages;
+    //! written pages, kept to reuse their blocks
+    std::vector<PendingPage *> m_freePages;
+    //! where the pages go once complete
+    SVGPageSink *m_sink;
+    bool m_ownSink;
+
+  private:
+    SVGDrawingGeneratorPrivate(const SVGDrawingGeneratorPrivate &);
+    SVGDrawingGeneratorPrivate &operator=(const SVGDrawingGeneratorPrivate &);
 };
 
 SVGDrawingGeneratorPrivate::SVGDrawingGeneratorPrivate(
-    librevenge::RVNGStringVector &vec, const librevenge::RVNGString &nmSpace)
-    : m_idSpanMap(), m_gradient(), m_style(), m_gradientIndex(1),
-      m_shadowIndex(1), m_patternIndex(1), m_arrowStartIndex(1),
-      m_arrowEndIndex(1), m_layerId(1000), m_nmSpace(nmSpace.cstr()),
-      m_nmSpaceAndDelim(""), m_outputSink(), m_vec(vec) {
+    SVGPageSink *sink, bool ownSink, const librevenge::RVNGString &nmSpace)
+    : m_idSpanMap(), m_gradient(), m_style(), m_styleProps(),
+      m_gradientIndex(1), m_shadowIndex(1), m_patternIndex(1),
+      m_arrowStartIndex(1), m_arrowEndIndex(1), m_layerId(1000),
+      m_nmSpace(nmSpace.cstr()), m_nmSpaceAndDelim(""), m_outputSink(),
+      m_styleBuffer(1024), m_styleDecl(), m_styleDeclValid(false),
+      m_useStyleClasses(false), m_styleClassIds(), m_styleClasses(),
+      m_styleClass(-1), m_binaryScratch(), m_emfCache(NULL),
+      m_emfConverter(NULL), m_stats(NULL), m_trace(NULL), m_transform(),
+      m_points(), m_simplifier(), m_actions(), m_pageStart(0), m_pageIndex(0),
+      m_pendingEMF(), m_pendingPages(), m_freePages(), m_sink(sink),
+      m_ownSink(ownSink) {
     if (!m_nmSpace.empty())
         m_nmSpaceAndDelim = m_nmSpace + ":";
 }
 
+SVGDrawingGeneratorPrivate::~SVGDrawingGeneratorPrivate() {
+    discardPages();
+    for (size_t i = 0; i < m_freePages.size(); i++)
+        delete m_freePages[i];
+    delete m_emfConverter;
+    if (m_ownSink)
+        delete m_sink;
+}
+
 void SVGDrawingGeneratorPrivate::drawPolySomething(
     const librevenge::RVNGPropertyListVector &vertices, bool isClosed) {
     if (vertices.count() < 2)
         return;
 
     if (vertices.count() == 2) {
-        if (!vertices[0]["svg:x"] || !vertices[0]["svg:y"] ||
-            !vertices[1]["svg:x"] || !vertices[1]["svg:y"])
+        SVGProperties first(vertices[0]);
+        SVGProperties last(vertices[1]);
+        if (!first[KEY_SVG_X] || !first[KEY_SVG_Y] || !last[KEY_SVG_X] ||
+            !last[KEY_SVG_Y])
             return;
         m_outputSink << "<" << getNamespaceAndDelim() << "line ";
-        m_outputSink << "x1=\""
-                     << doubleToString(631 *
-                                       (vertices[0]["svg:x"]->getDouble()))
-                     << "\"  y1=\""
-                     << doubleToString(
-                            631 * (vertices[0]["svg:y"]->getDouble())) << "\" ";
-        m_outputSink << "x2=\""
-                     << doubleToString(631 *
-                                       (vertices[1]["svg:x"]->getDouble()))
-                     << "\"  y2=\""
-                     << doubleToString(631 *
-                                       (vertices[1]["svg:y"]->getDouble()))
-                     << "\"\n";
+        double points[4] = {
+            first[KEY_SVG_X]->getDouble(), first[KEY_SVG_Y]->getDouble(),
+            last[KEY_SVG_X]->getDouble(), last[KEY_SVG_Y]->getDouble()};
+        m_transform.points(points, points, 2);
+        m_outputSink << "x1=\"" << FormattedDouble(points[0]) << "\"  y1=\""
+                     << FormattedDouble(points[1]) << "\" ";
+        m_outputSink << "x2=\"" << FormattedDouble(points[2]) << "\"  y2=\""
+                     << FormattedDouble(points[3]) << "\"\n";
         writeStyle();
         m_outputSink << "/>\n";
     } else {
@@ -146,15 +312,26 @@ void SVGDrawingGeneratorPrivate::drawPolySomething(
             m_outputSink << "<" << getNamespaceAndDelim() << "polyline ";
 
         m_outputSink << "points=\"";
+        // gather the points to transform them at once, the vertices
+        // lacking a coordinate are skipped
+        m_points.clear();
+        SVGProperties vertex;
+        bool lastSkipped = false;
         for (unsigned i = 0; i < vertices.count(); i++) {
-            if (!vertices[i]["svg:x"] || !vertices[i]["svg:y"])
+            vertex.resolve(vertices[i]);
+            lastSkipped = !vertex[KEY_SVG_X] || !vertex[KEY_SVG_Y];
+            if (lastSkipped)
                 continue;
-            m_outputSink << doubleToString(631 *
-                                           (vertices[i]["svg:x"]->getDouble()))
-                         << " "
-                         << doubleToString(631 *
-                                           (vertices[i]["svg:y"]->getDouble()));
-            if (i < vertices.count() - 1)
+            m_points.push_back(vertex[KEY_SVG_X]->getDouble());
+            m_points.push_back(vertex[KEY_SVG_Y]->getDouble());
+        }
+        size_t count = m_points.size() / 2;
+        m_transform.points(m_points.data(), m_points.data(), count);
+        count = simplifyPoints(m_points.data(), count);
+        for (size_t i = 0; i < count; i++) {
+            m_outputSink << FormattedDouble(m_points[2 * i]) << " "
+                         << FormattedDouble(m_points[2 * i + 1]);
+            if (i + 1 < count || lastSkipped)
                 m_outputSink << ", ";
         }
         m_outputSink << "\"\n";
@@ -163,25 +340,223 @@ void SVGDrawingGeneratorPrivate::drawPolySomething(
     }
 }
 
+void SVGDrawingGeneratorPrivate::drawPath(
+    const librevenge::RVNGPropertyListVector &path) {
+    m_outputSink << "<" << getNamespaceAndDelim() << "path d=\" ";
+    bool isClosed = false;
+    unsigned i = 0;
+    for (i = 0; i < path.count(); i++) {
+        SVGProperties seg(path[i]);
+        if (!seg[KEY_LIBREVENGE_PATH_ACTION])
+            continue;
+        librevenge::RVNGString actionStr =
+            seg[KEY_LIBREVENGE_PATH_ACTION]->getStr();
+        if (actionStr.len() != 1)
+            continue;
+        char action = actionStr.cstr()[0];
+        bool coordOk = seg[KEY_SVG_X] && seg[KEY_SVG_Y];
+        bool coord1Ok = coordOk && seg[KEY_SVG_X1] && seg[KEY_SVG_Y1];
+        bool coord2Ok = coord1Ok && seg[KEY_SVG_X2] && seg[KEY_SVG_Y2];
+        if (seg[KEY_SVG_X] && action == 'H')
+            m_outputSink << "\nH"
+                         << FormattedDouble(
+                                m_transform.x(seg[KEY_SVG_X]->getDouble()));
+        else if (seg[KEY_SVG_Y] && action == 'V')
+            m_outputSink << "\nV"
+                         << FormattedDouble(
+                                m_transform.y(seg[KEY_SVG_Y]->getDouble()));
+        else if (coordOk && (action == 'M' || action == 'L' || action == 'T')) {
+            m_outputSink << "\n" << action;
+            writePoint(seg, KEY_SVG_X, KEY_SVG_Y);
+        } else if (coord1Ok && (action == 'Q' || action == 'S')) {
+            m_outputSink << "\n" << action;
+            writePoint(seg, KEY_SVG_X1, KEY_SVG_Y1);
+            m_outputSink << " ";
+            writePoint(seg, KEY_SVG_X, KEY_SVG_Y);
+        } else if (coord2Ok && action == 'C') {
+            m_outputSink << "\nC";
+            writePoint(seg, KEY_SVG_X1, KEY_SVG_Y1);
+            m_outputSink << " ";
+            writePoint(seg, KEY_SVG_X2, KEY_SVG_Y2);
+            m_outputSink << " ";
+            writePoint(seg, KEY_SVG_X, KEY_SVG_Y);
+        } else if (coordOk && seg[KEY_SVG_RX] && seg[KEY_SVG_RY] &&
+                   action == 'A') {
+            m_outputSink << "\nA";
+            m_outputSink << FormattedDouble(m_transform.length(
+                                seg[KEY_SVG_RX]->getDouble()))
+                         << ","
+                         << FormattedDouble(m_transform.length(
+                                seg[KEY_SVG_RY]->getDouble()))
+                         << " ";
+            m_outputSink
+                << FormattedDouble(seg.getDouble(KEY_LIBREVENGE_ROTATE, 0))
+                << " ";
+            m_outputSink << seg.getInt(KEY_LIBREVENGE_LARGE_ARC, 1) << ","
+                         << seg.getInt(KEY_LIBREVENGE_SWEEP, 1) << " ";
+            writePoint(seg, KEY_SVG_X, KEY_SVG_Y);
+        } else if (action == 'Z') {
+            isClosed = true;
+            m_outputSink << "\nZ";
+        }
+    }
+
+    endPath(isClosed);
+}
+
+void SVGDrawingGeneratorPrivate::writePoint(const SVGProperties &seg, SVGKey x,
+                                            SVGKey y) {
+    m_outputSink << FormattedDouble(m_transform.x(seg[x]->getDouble())) << ","
+                 << FormattedDouble(m_transform.y(seg[y]->getDouble()));
+}
+
+#ifdef HAVE_RVNG_PATH
+void SVGDrawingGeneratorPrivate::drawPath(const librevenge::RVNGPath &path) {
+    const unsigned char *actions = path.getActions();
+    const double *in = path.getCoordinates();
+    size_t size = 0;
+    for (unsigned long i = 0; i < path.count(); i++)
+        size += librevenge::RVNGPath::coordinateCount(actions[i]);
+    m_points.resize(size);
+    double *coords = m_points.data();
+
+    /* Transform the points in runs, between the arcs: the radii, the
+     * rotation and the flags of an arc are not points, and the 7 values
+     * of an arc would shift the x y pairs of the following segments. */
+    size_t run = 0, pos = 0;
+    for (unsigned long i = 0; i < path.count(); i++) {
+        if (actions[i] == librevenge::RVNGPath::ARC_TO) {
+            m_transform.points(in + run, coords + run, (pos - run) / 2);
+            coords[pos] = m_transform.length(in[pos]);
+            coords[pos + 1] = m_transform.length(in[pos + 1]);
+            coords[pos + 2] = in[pos + 2];
+            coords[pos + 3] = in[pos + 3];
+            coords[pos + 4] = in[pos + 4];
+            m_transform.points(in + pos + 5, coords + pos + 5, 1);
+            run = pos + 7;
+        }
+        pos += librevenge::RVNGPath::coordinateCount(actions[i]);
+    }
+    m_transform.points(in + run, coords + run, (pos - run) / 2);
+
+    unsigned long count = path.count();
+    if (m_simplifier.enabled()) {
+        simplifyPath(actions, count);
+        actions = m_actions.data();
+        count = m_actions.size();
+    }
+
+    m_outputSink << "<" << getNamespaceAndDelim() << "path d=\" ";
+    bool isClosed = false;
+    for (unsigned long i = 0; i < count; i++) {
+        const unsigned char action = actions[i];
+        switch (action) {
+        case librevenge::RVNGPath::MOVE_TO:
+        case librevenge::RVNGPath::LINE_TO:
+            m_outputSink << "\n" << (char)action << FormattedDouble(coords[0])
+                         << "," << FormattedDouble(coords[1]);
+            break;
+        case librevenge::RVNGPath::QUAD_TO:
+            m_outputSink << "\nQ" << FormattedDouble(coords[0]) << ","
+                         << FormattedDouble(coords[1]) << " "
+                         << FormattedDouble(coords[2]) << ","
+                         << FormattedDouble(coords[3]);
+            break;
+        case librevenge::RVNGPath::CURVE_TO:
+            m_outputSink << "\nC" << FormattedDouble(coords[0]) << ","
+                         << FormattedDouble(coords[1]) << " "
+                         << FormattedDouble(coords[2]) << ","
+                         << FormattedDouble(coords[3]) << " "
+                         << FormattedDouble(coords[4]) << ","
+                         << FormattedDouble(coords[5]);
+            break;
+        case librevenge::RVNGPath::ARC_TO:
+            m_outputSink << "\nA" << FormattedDouble(coords[0]) << ","
+                         << FormattedDouble(coords[1]) << " "
+                         << FormattedDouble(coords[2]) << " " << (int)coords[3]
+                         << "," << (int)coords[4] << " "
+                         << FormattedDouble(coords[5]) << ","
+                         << FormattedDouble(coords[6]);
+            break;
+        case librevenge::RVNGPath::CLOSE:
+            isClosed = true;
+            m_outputSink << "\nZ";
+            break;
+        }
+        coords += librevenge::RVNGPath::coordinateCount(action);
+    }
+    endPath(isClosed);
+}
+
+void SVGDrawingGeneratorPrivate::simplifyPath(const unsigned char *actions,
+                                              unsigned long count) {
+    m_actions.clear();
+    double *points = m_points.data();
+    size_t in = 0, out = 0;
+    unsigned long i = 0;
+    while (i < count) {
+        unsigned n = librevenge::RVNGPath::coordinateCount(actions[i]);
+        if (actions[i] != librevenge::RVNGPath::LINE_TO) {
+            std::copy(points + in, points + in + n, points + out);
+            m_actions.push_back(actions[i]);
+            in += n;
+            out += n;
+            i++;
+            continue;
+        }
+        unsigned long end = i;
+        while (end < count && actions[end] == librevenge::RVNGPath::LINE_TO)
+            end++;
+        // the run starts from the end of the previous segment, if any
+        bool from = i > 0 && out >= 2 &&
+                    librevenge::RVNGPath::coordinateCount(actions[i - 1]);
+        size_t first = from ? out - 2 : out;
+        std::copy(points + in, points + in + 2 * (end - i), points + out);
+        size_t kept =
+            simplifyPoints(points + first, end - i + (from ? 1 : 0));
+        for (size_t j = from ? 1 : 0; j < kept; j++)
+            m_actions.push_back(librevenge::RVNGPath::LINE_TO);
+        in += 2 * (end - i);
+        out = first + 2 * kept;
+        i = end;
+    }
+}
+#endif
+
+size_t SVGDrawingGeneratorPrivate::simplifyPoints(double *points,
+                                                  size_t count) {
+    size_t kept = m_simplifier.simplify(points, count);
+    if (m_stats && kept < count)
+        m_stats->add(SVGStats::POINTS_DROPPED, count - kept);
+    return kept;
+}
+
+void SVGDrawingGeneratorPrivate::endPath(bool isClosed) {
+    m_outputSink << "\" \n";
+    writeStyle(isClosed);
+    m_outputSink << "/>\n";
+}
+
 void SVGDrawingGeneratorPrivate::setStyle(
     const librevenge::RVNGPropertyList &propList) {
     m_style.clear();
     m_style = propList;
+    m_styleProps.decode(m_style);
+    m_styleDeclValid = false;
+    const SVGStyle &style = m_styleProps;
 
     const librevenge::RVNGPropertyListVector *gradient =
         propList.child("svg:linearGradient");
     if (!gradient)
         gradient = propList.child("svg:radialGradient");
     m_gradient = gradient ? *gradient : librevenge::RVNGPropertyListVector();
-    if (m_style["draw:shadow"] &&
-        m_style["draw:shadow"]->getStr() == "visible" &&
-        m_style["draw:shadow-opacity"]) {
+    if (style.shadow && style[KEY_DRAW_SHADOW_OPACITY]) {
         double shadowRed = 0.0;
         double shadowGreen = 0.0;
         double shadowBlue = 0.0;
-        if (m_style["draw:shadow-color"]) {
+        if (style[KEY_DRAW_SHADOW_COLOR]) {
             unsigned shadowColour =
-                stringToColour(m_style["draw:shadow-color"]->getStr());
+                stringToColour(style[KEY_DRAW_SHADOW_COLOR]->getStr());
             shadowRed = (double)((shadowColour & 0x00ff0000) >> 16) / 255.0;
             shadowGreen = (double)((shadowColour & 0x0000ff00) >> 8) / 255.0;
             shadowBlue = (double)(shadowColour & 0x000000ff) / 255.0;
@@ -192,35 +567,33 @@ void SVGDrawingGeneratorPrivate::setStyle(
                      << m_shadowIndex++ << "\">";
         m_outputSink << "<" << getNamespaceAndDelim()
                      << "feOffset in=\"SourceGraphic\" result=\"offset\" ";
-        if (m_style["draw:shadow-offset-x"])
+        if (style[KEY_DRAW_SHADOW_OFFSET_X])
             m_outputSink << "dx=\""
-                         << doubleToString(
-                                631 *
-                                m_style["draw:shadow-offset-x"]->getDouble())
+                         << FormattedDouble(m_transform.length(
+                                style[KEY_DRAW_SHADOW_OFFSET_X]->getDouble()))
                          << "\" ";
-        if (m_style["draw:shadow-offset-y"])
+        if (style[KEY_DRAW_SHADOW_OFFSET_Y])
             m_outputSink << "dy=\""
-                         << doubleToString(
-                                631 *
-                                m_style["draw:shadow-offset-y"]->getDouble())
+                         << FormattedDouble(m_transform.length(
+                                style[KEY_DRAW_SHADOW_OFFSET_Y]->getDouble()))
                          << "\" ";
         m_outputSink << "/>";
         m_outputSink << "<" << getNamespaceAndDelim()
                      << "feColorMatrix in=\"offset\" result=\"offset-color\" "
                         "type=\"matrix\" values=\"";
-        m_outputSink << "0 0 0 0 " << doubleToString(shadowRed);
-        m_outputSink << " 0 0 0 0 " << doubleToString(shadowGreen);
-        m_outputSink << " 0 0 0 0 " << doubleToString(shadowBlue);
-        if (m_style["draw:opacity"] && m_style["draw:opacity"]->getDouble() < 1)
+        m_outputSink << "0 0 0 0 " << FormattedDouble(shadowRed);
+        m_outputSink << " 0 0 0 0 " << FormattedDouble(shadowGreen);
+        m_outputSink << " 0 0 0 0 " << FormattedDouble(shadowBlue);
+        if (style[KEY_DRAW_OPACITY] && style[KEY_DRAW_OPACITY]->getDouble() < 1)
             m_outputSink << " 0 0 0 "
-                         << doubleToString(
-                                m_style["draw:shadow-opacity"]->getDouble() /
-                                m_style["draw:opacity"]->getDouble())
+                         << FormattedDouble(
+                                style[KEY_DRAW_SHADOW_OPACITY]->getDouble() /
+                                style[KEY_DRAW_OPACITY]->getDouble())
                          << " 0\"/>";
         else
             m_outputSink << " 0 0 0 "
-                         << doubleToString(
-                                m_style["draw:shadow-opacity"]->getDouble())
+                         << FormattedDouble(
+                                style[KEY_DRAW_SHADOW_OPACITY]->getDouble())
                          << " 0\"/>";
 
         m_outputSink << "<" << getNamespaceAndDelim() << "feMerge>";
@@ -233,102 +606,99 @@ void SVGDrawingGeneratorPrivate::setStyle(
         m_outputSink << "</" << getNamespaceAndDelim() << "defs>";
     }
 
-    if (m_style["draw:fill"] && m_style["draw:fill"]->getStr() == "gradient") {
+    if (style.fill == SVGStyle::FILL_GRADIENT) {
         double angle =
-            (m_style["draw:angle"] ? m_style["draw:angle"]->getDouble() : 0.0);
+            (style[KEY_DRAW_ANGLE] ? style[KEY_DRAW_ANGLE]->getDouble() : 0.0);
         angle *= -1.0;
         while (angle < 0)
             angle += 360;
         while (angle > 360)
             angle -= 360;
 
-        if (m_style["draw:style"] &&
-            (m_style["draw:style"]->getStr() == "radial" ||
-             m_style["draw:style"]->getStr() == "rectangular" ||
-             m_style["draw:style"]->getStr() == "square" ||
-             m_style["draw:style"]->getStr() == "ellipsoid")) {
+        if (style.gradient == SVGStyle::GRADIENT_RADIAL) {
             m_outputSink << "<" << getNamespaceAndDelim() << "defs>\n";
             m_outputSink << "  <" << getNamespaceAndDelim()
                          << "radialGradient id=\"grad" << m_gradientIndex++
                          << "\"";
 
-            if (m_style["svg:cx"])
-                m_outputSink << " cx=\"" << m_style["svg:cx"]->getStr().cstr()
+            if (style[KEY_SVG_CX])
+                m_outputSink << " cx=\"" << style[KEY_SVG_CX]->getStr().cstr()
                              << "\"";
-            else if (m_style["draw:cx"])
-                m_outputSink << " cx=\"" << m_style["draw:cx"]->getStr().cstr()
+            else if (style[KEY_DRAW_CX])
+                m_outputSink << " cx=\"" << style[KEY_DRAW_CX]->getStr().cstr()
                              << "\"";
 
-            if (m_style["svg:cy"])
-                m_outputSink << " cy=\"" << m_style["svg:cy"]->getStr().cstr()
+            if (style[KEY_SVG_CY])
+                m_outputSink << " cy=\"" << style[KEY_SVG_CY]->getStr().cstr()
                              << "\"";
-            else if (m_style["draw:cy"])
-                m_outputSink << " cy=\"" << m_style["draw:cy"]->getStr().cstr()
+            else if (style[KEY_DRAW_CY])
+                m_outputSink << " cy=\"" << style[KEY_DRAW_CY]->getStr().cstr()
                              << "\"";
-            if (m_style["svg:r"])
-                m_outputSink << " r=\"" << m_style["svg:r"]->getStr().cstr()
+            if (style[KEY_SVG_R])
+                m_outputSink << " r=\"" << style[KEY_SVG_R]->getStr().cstr()
                              << "\"";
-            else if (m_style["draw:border"])
+            else if (style[KEY_DRAW_BORDER])
                 m_outputSink
                     << " r=\""
-                    << doubleToString(
-                           (1 - m_style["draw:border"]->getDouble()) * 100.0)
+                    << FormattedDouble(
+                           (1 - style[KEY_DRAW_BORDER]->getDouble()) * 100.0)
                     << "%\"";
             else
                 m_outputSink << " r=\"100%\"";
             m_outputSink << " >\n";
             if (m_gradient.count()) {
                 for (unsigned c = 0; c < m_gradient.count(); c++) {
-                    librevenge::RVNGPropertyList const &grad = m_gradient[c];
+                    SVGProperties grad(m_gradient[c]);
                     m_outputSink << "    <" << getNamespaceAndDelim() << "stop";
-                    if (grad["svg:offset"])
+                    if (grad[KEY_SVG_OFFSET])
                         m_outputSink << " offset=\""
-                                     << grad["svg:offset"]->getStr().cstr()
-                                     << "\"";
-                    if (grad["svg:stop-color"])
-                        m_outputSink << " stop-color=\""
-                                     << grad["svg:stop-color"]->getStr().cstr()
+                                     << grad[KEY_SVG_OFFSET]->getStr().cstr()
                                      << "\"";
-                    if (grad["svg:stop-opacity"])
+                    if (grad[KEY_SVG_STOP_COLOR])
+                        m_outputSink
+                            << " stop-color=\""
+                            << grad[KEY_SVG_STOP_COLOR]->getStr().cstr()
+                            << "\"";
+                    if (grad[KEY_SVG_STOP_OPACITY])
                         m_outputSink
                             << " stop-opacity=\""
-                            << doubleToString(
-                                   grad["svg:stop-opacity"]->getDouble())
+                            << FormattedDouble(
+                                   grad[KEY_SVG_STOP_OPACITY]->getDouble())
                             << "\"";
-                    m_outputSink << "/>" << std::endl;
+                    m_outputSink << "/>\n";
                 }
-            } else if (m_style["draw:start-color"] &&
-                       m_style["draw:end-color"]) {
+            } else if (style[KEY_DRAW_START_COLOR] &&
+                       style[KEY_DRAW_END_COLOR]) {
                 m_outputSink << "    <" << getNamespaceAndDelim()
                              << "stop offset=\"0%\"";
                 m_outputSink << " stop-color=\""
-                             << m_style["draw:end-color"]->getStr().cstr()
+                             << style[KEY_DRAW_END_COLOR]->getStr().cstr()
                              << "\"";
                 m_outputSink
                     << " stop-opacity=\""
-                    << doubleToString(
-                           m_style["librevenge:end-opacity"]
-                               ? m_style["librevenge:end-opacity"]->getDouble()
-                               : 1) << "\" />" << std::endl;
+                    << FormattedDouble(
+                           style[KEY_LIBREVENGE_END_OPACITY]
+                               ? style[KEY_LIBREVENGE_END_OPACITY]->getDouble()
+                               : 1) << "\" />\n";
 
                 m_outputSink << "    <" << getNamespaceAndDelim()
                              << "stop offset=\"100%\"";
                 m_outputSink << " stop-color=\""
-                             << m_style["draw:start-color"]->getStr().cstr()
+                             << style[KEY_DRAW_START_COLOR]->getStr().cstr()
                              << "\"";
                 m_outputSink
                     << " stop-opacity=\""
-                    << doubleToString(m_style["librevenge:start-opacity"]
-                                          ? m_style["librevenge:start-opacity"]
+                    << FormattedDouble(style[KEY_LIBREVENGE_START_OPACITY]
+                                          ? style[KEY_LIBREVENGE_START_OPACITY]
                                                 ->getDouble()
-                                          : 1) << "\" />" << std::endl;
+                                          : 1) << "\" />\n";
             }
             m_outputSink << "  </" << getNamespaceAndDelim()
                          << "radialGradient>\n";
             m_outputSink << "</" << getNamespaceAndDelim() << "defs>\n";
-        } else if (!m_style["draw:style"] ||
-                   m_style["draw:style"]->getStr() == "linear" ||
-                   m_style["draw:style"]->getStr() == "axial") {
+        } else if (style.gradient == SVGStyle::GRADIENT_UNSET ||
+                   style.gradient == SVGStyle::GRADIENT_LINEAR ||
+                   style.gradient == SVGStyle::GRADIENT_AXIAL) {
             m_outputSink << "<" << getNamespaceAndDelim() << "defs>\n";
             m_outputSink << "  <" << getNamespaceAndDelim()
                          << "linearGradient id=\"grad" << m_gradientIndex++
@@ -336,22 +706,20 @@ void SVGDrawingGeneratorPrivate::setStyle(
 
             if (m_gradient.count()) {
                 bool canBuildAxial = false;
-                if (m_style["draw:style"] &&
-                    m_style["draw:style"]->getStr() == "axial") {
+                if (style.gradient == SVGStyle::GRADIENT_AXIAL) {
                     // check if we can reconstruct the linear offset, ie. if
                     // each offset is a valid percent%
                     canBuildAxial = true;
                     for (unsigned c = 0; c < m_gradient.count(); ++c) {
-                        librevenge::RVNGPropertyList const &grad =
-                            m_gradient[c];
-                        if (!grad["svg:offset"] ||
-                            grad["svg:offset"]->getDouble() < 0 ||
-                            grad["svg:offset"]->getDouble() > 1) {
+                        SVGProperties grad(m_gradient[c]);
+                        if (!grad[KEY_SVG_OFFSET] ||
+                            grad[KEY_SVG_OFFSET]->getDouble() < 0 ||
+                            grad[KEY_SVG_OFFSET]->getDouble() > 1) {
                             canBuildAxial = false;
                             break;
                         }
                         librevenge::RVNGString str =
-                            grad["svg:offset"]->getStr();
+                            grad[KEY_SVG_OFFSET]->getStr();
                         int len = str.len();
                         if (len < 1 || str.cstr()[len - 1] != '%') {
                             canBuildAxial = false;
@@ -361,147 +729,145 @@ void SVGDrawingGeneratorPrivate::setStyle(
                 }
                 if (canBuildAxial) {
                     for (unsigned long c = m_gradient.count(); c > 0;) {
-                        librevenge::RVNGPropertyList const &grad =
-                            m_gradient[--c];
+                        SVGProperties grad(m_gradient[--c]);
                         m_outputSink << "    <" << getNamespaceAndDelim()
                                      << "stop ";
-                        if (grad["svg:offset"])
+                        if (grad[KEY_SVG_OFFSET])
                             m_outputSink
                                 << "offset=\""
-                                << doubleToString(
+                                << FormattedDouble(
                                        50. -
-                                       50. * grad["svg:offset"]->getDouble())
+                                       50. * grad[KEY_SVG_OFFSET]->getDouble())
                                 << "%\"";
-                        if (grad["svg:stop-color"])
+                        if (grad[KEY_SVG_STOP_COLOR])
                             m_outputSink
                                 << " stop-color=\""
-                                << grad["svg:stop-color"]->getStr().cstr()
+                                << grad[KEY_SVG_STOP_COLOR]->getStr().cstr()
                                 << "\"";
-                        if (grad["svg:stop-opacity"])
+                        if (grad[KEY_SVG_STOP_OPACITY])
                             m_outputSink
                                 << " stop-opacity=\""
-                                << doubleToString(
-                                       grad["svg:stop-opacity"]->getDouble())
+                                << FormattedDouble(
+                                       grad[KEY_SVG_STOP_OPACITY]->getDouble())
                                 << "\"";
-                        m_outputSink << "/>" << std::endl;
+                        m_outputSink << "/>\n";
                     }
                     for (unsigned long c = 0; c < m_gradient.count(); ++c) {
-                        librevenge::RVNGPropertyList const &grad =
-                            m_gradient[c];
-                        if (c == 0 && grad["svg:offset"] &&
-                            grad["svg:offset"]->getDouble() <= 0)
+                        SVGProperties grad(m_gradient[c]);
+                        if (c == 0 && grad[KEY_SVG_OFFSET] &&
+                            grad[KEY_SVG_OFFSET]->getDouble() <= 0)
                             continue;
                         m_outputSink << "    <" << getNamespaceAndDelim()
                                      << "stop ";
-                        if (grad["svg:offset"])
+                        if (grad[KEY_SVG_OFFSET])
                             m_outputSink
                                 << "offset=\""
-                                << doubleToString(
+                                << FormattedDouble(
                                        50. +
-                                       50. * grad["svg:offset"]->getDouble())
+                                       50. * grad[KEY_SVG_OFFSET]->getDouble())
                                 << "%\"";
-                        if (grad["svg:stop-color"])
+                        if (grad[KEY_SVG_STOP_COLOR])
                             m_outputSink
                                 << " stop-color=\""
-                                << grad["svg:stop-color"]->getStr().cstr()
+                                << grad[KEY_SVG_STOP_COLOR]->getStr().cstr()
                                 << "\"";
-                        if (grad["svg:stop-opacity"])
+                        if (grad[KEY_SVG_STOP_OPACITY])
                             m_outputSink
                                 << " stop-opacity=\""
-                                << doubleToString(
-                                       grad["svg:stop-opacity"]->getDouble())
+                                << FormattedDouble(
+                                       grad[KEY_SVG_STOP_OPACITY]->getDouble())
                                 << "\"";
-                        m_outputSink << "/>" << std::endl;
+                        m_outputSink << "/>\n";
                     }
                 } else {
                     for (unsigned c = 0; c < m_gradient.count(); c++) {
-                        librevenge::RVNGPropertyList const &grad =
-                            m_gradient[c];
+                        SVGProperties grad(m_gradient[c]);
                         m_outputSink << "    <" << getNamespaceAndDelim()
                                      << "stop";
-                        if (grad["svg:offset"])
-                            m_outputSink << " offset=\""
-                                         << grad["svg:offset"]->getStr().cstr()
-                                         << "\"";
-                        if (grad["svg:stop-color"])
+                        if (grad[KEY_SVG_OFFSET])
+                            m_outputSink
+                                << " offset=\""
+                                << grad[KEY_SVG_OFFSET]->getStr().cstr()
+                                << "\"";
+                        if (grad[KEY_SVG_STOP_COLOR])
                             m_outputSink
                                 << " stop-color=\""
-                                << grad["svg:stop-color"]->getStr().cstr()
+                                << grad[KEY_SVG_STOP_COLOR]->getStr().cstr()
                                 << "\"";
-                        if (grad["svg:stop-opacity"])
+                        if (grad[KEY_SVG_STOP_OPACITY])
                             m_outputSink
                                 << " stop-opacity=\""
-                                << doubleToString(
-                                       grad["svg:stop-opacity"]->getDouble())
+                                << FormattedDouble(
+                                       grad[KEY_SVG_STOP_OPACITY]->getDouble())
                                 << "\"";
-                        m_outputSink << "/>" << std::endl;
+                        m_outputSink << "/>\n";
                     }
                 }
-            } else if (m_style["draw:start-color"] &&
-                       m_style["draw:end-color"]) {
-                if (!m_style["draw:style"] ||
-                    m_style["draw:style"]->getStr() == "linear") {
+            } else if (style[KEY_DRAW_START_COLOR] &&
+                       style[KEY_DRAW_END_COLOR]) {
+                if (style.gradient == SVGStyle::GRADIENT_UNSET ||
+                    style.gradient == SVGStyle::GRADIENT_LINEAR) {
                     m_outputSink << "    <" << getNamespaceAndDelim()
                                  << "stop offset=\"0%\"";
                     m_outputSink << " stop-color=\""
-                                 << m_style["draw:start-color"]->getStr().cstr()
+                                 << style[KEY_DRAW_START_COLOR]->getStr().cstr()
                                  << "\"";
                     m_outputSink
                         << " stop-opacity=\""
-                        << doubleToString(
-                               m_style["librevenge:start-opacity"]
-                                   ? m_style["librevenge:start-opacity"]
+                        << FormattedDouble(
+                               style[KEY_LIBREVENGE_START_OPACITY]
+                                   ? style[KEY_LIBREVENGE_START_OPACITY]
                                          ->getDouble()
-                                   : 1) << "\" />" << std::endl;
+                                   : 1) << "\" />\n";
 
                     m_outputSink << "    <" << getNamespaceAndDelim()
                                  << "stop offset=\"100%\"";
                     m_outputSink << " stop-color=\""
-                                 << m_style["draw:end-color"]->getStr().cstr()
+                                 << style[KEY_DRAW_END_COLOR]->getStr().cstr()
                                  << "\"";
                     m_outputSink << " stop-opacity=\""
-                                 << doubleToString(
-                                        m_style["librevenge:end-opacity"]
-                                            ? m_style["librevenge:end-opacity"]
+                                 << FormattedDouble(
+                                        style[KEY_LIBREVENGE_END_OPACITY]
+                                            ? style[KEY_LIBREVENGE_END_OPACITY]
                                                   ->getDouble()
-                                            : 1) << "\" />" << std::endl;
+                                            : 1) << "\" />\n";
                 } else {
                     m_outputSink << "    <" << getNamespaceAndDelim()
                                  << "stop offset=\"0%\"";
                     m_outputSink << " stop-color=\""
-                                 << m_style["draw:end-color"]->getStr().cstr()
+                                 << style[KEY_DRAW_END_COLOR]->getStr().cstr()
                                  << "\"";
                     m_outputSink << " stop-opacity=\""
-                                 << doubleToString(
-                                        m_style["librevenge:end-opacity"]
-                                            ? m_style["librevenge:end-opacity"]
+                                 << FormattedDouble(
+                                        style[KEY_LIBREVENGE_END_OPACITY]
+                                            ? style[KEY_LIBREVENGE_END_OPACITY]
                                                   ->getDouble()
-                                            : 1) << "\" />" << std::endl;
+                                            : 1) << "\" />\n";
 
                     m_outputSink << "    <" << getNamespaceAndDelim()
                                  << "stop offset=\"50%\"";
                     m_outputSink << " stop-color=\""
-                                 << m_style["draw:start-color"]->getStr().cstr()
+                                 << style[KEY_DRAW_START_COLOR]->getStr().cstr()
                                  << "\"";
                     m_outputSink
                         << " stop-opacity=\""
-                        << doubleToString(
-                               m_style["librevenge:start-opacity"]
-                                   ? m_style["librevenge:start-opacity"]
+                        << FormattedDouble(
+                               style[KEY_LIBREVENGE_START_OPACITY]
+                                   ? style[KEY_LIBREVENGE_START_OPACITY]
                                          ->getDouble()
-                                   : 1) << "\" />" << std::endl;
+                                   : 1) << "\" />\n";
 
                     m_outputSink << "    <" << getNamespaceAndDelim()
                                  << "stop offset=\"100%\"";
                     m_outputSink << " stop-color=\""
-                                 << m_style["draw:end-color"]->getStr().cstr()
+                                 << style[KEY_DRAW_END_COLOR]->getStr().cstr()
                                  << "\"";
                     m_outputSink << " stop-opacity=\""
-                                 << doubleToString(
-                                        m_style["librevenge:end-opacity"]
-                                            ? m_style["librevenge:end-opacity"]
+                                 << FormattedDouble(
+                                        style[KEY_LIBREVENGE_END_OPACITY]
+                                            ? style[KEY_LIBREVENGE_END_OPACITY]
                                                   ->getDouble()
-                                            : 1) << "\" />" << std::endl;
+                                            : 1) << "\" />\n";
                 }
             }
             m_outputSink << "  </" << getNamespaceAndDelim()
@@ -523,71 +889,72 @@ void SVGDrawingGeneratorPrivate::setStyle(
 
             m_outputSink << "</" << getNamespaceAndDelim() << "defs>\n";
         }
-    } else if (m_style["draw:fill"] &&
-               m_style["draw:fill"]->getStr() == "bitmap" &&
-               m_style["draw:fill-image"] && m_style["librevenge:mime-type"]) {
+    } else if (style.fill == SVGStyle::FILL_BITMAP &&
+               style[KEY_DRAW_FILL_IMAGE] && style[KEY_LIBREVENGE_MIME_TYPE]) {
         m_outputSink << "<" << getNamespaceAndDelim() << "defs>\n";
         m_outputSink << "  <" << getNamespaceAndDelim() << "pattern id=\"img"
                      << m_patternIndex++
                      << "\" patternUnits=\"userSpaceOnUse\" ";
-        if (m_style["svg:width"])
+        if (style[KEY_SVG_WIDTH])
             m_outputSink << "width=\""
-                         << doubleToString(631 *
-                                           (m_style["svg:width"]->getDouble()))
+                         << FormattedDouble(m_transform.length(
+                                style[KEY_SVG_WIDTH]->getDouble()))
                          << "\" ";
         else
             m_outputSink << "width=\"100\" ";
 
-        if (m_style["svg:height"])
+        if (style[KEY_SVG_HEIGHT])
             m_outputSink << "height=\""
-                         << doubleToString(631 *
-                                           (m_style["svg:height"]->getDouble()))
-                         << "\">" << std::endl;
+                         << FormattedDouble(m_transform.length(
+                                style[KEY_SVG_HEIGHT]->getDouble()))
+                         << "\">\n";
         else
-            m_outputSink << "height=\"100\">" << std::endl;
+            m_outputSink << "height=\"100\">\n";
         m_outputSink << "<" << getNamespaceAndDelim() << "image ";
 
-        if (m_style["svg:x"])
-            m_outputSink << "x=\"" << doubleToString(
-                                          631 * (m_style["svg:x"]->getDouble()))
+        if (style[KEY_SVG_X])
+            m_outputSink << "x=\""
+                         << FormattedDouble(m_transform.length(
+                                style[KEY_SVG_X]->getDouble()))
                          << "\" ";
         else
             m_outputSink << "x=\"0\" ";
 
-        if (m_style["svg:y"])
-            m_outputSink << "y=\"" << doubleToString(
-                                          631 * (m_style["svg:y"]->getDouble()))
+        if (style[KEY_SVG_Y])
+            m_outputSink << "y=\""
+                         << FormattedDouble(m_transform.length(
+                                style[KEY_SVG_Y]->getDouble()))
                          << "\" ";
         else
             m_outputSink << "y=\"0\" ";
 
-        if (m_style["svg:width"])
+        if (style[KEY_SVG_WIDTH])
             m_outputSink << "width=\""
-                         << doubleToString(631 *
-                                           (m_style["svg:width"]->getDouble()))
+                         << FormattedDouble(m_transform.length(
+                                style[KEY_SVG_WIDTH]->getDouble()))
                          << "\" ";
         else
             m_outputSink << "width=\"100\" ";
 
-        if (m_style["svg:height"])
+        if (style[KEY_SVG_HEIGHT])
             m_outputSink << "height=\""
-                         << doubleToString(631 *
-                                           (m_style["svg:height"]->getDouble()))
+                         << FormattedDouble(m_transform.length(
+                                style[KEY_SVG_HEIGHT]->getDouble()))
                          << "\" ";
         else
             m_outputSink << "height=\"100\" ";
 
         m_outputSink << "xlink:href=\"data:"
-                     << m_style["librevenge:mime-type"]->getStr().cstr()
+                     << style[KEY_LIBREVENGE_MIME_TYPE]->getStr().cstr()
                      << ";base64,";
-        m_outputSink << m_style["draw:fill-image"]->getStr().cstr();
+        writeBinary(style[KEY_DRAW_FILL_IMAGE]);
         m_outputSink << "\" />\n";
         m_outputSink << "  </" << getNamespaceAndDelim() << "pattern>\n";
         m_outputSink << "</" << getNamespaceAndDelim() << "defs>\n";
     }
 
     // check for arrow and if find some, define a basic arrow
-    if (m_style["draw:marker-start-path"]) {
+    if (style[KEY_DRAW_MARKER_START_PATH]) {
         m_outputSink << "<" << getNamespaceAndDelim() << "defs>\n";
         m_outputSink << "<" << getNamespaceAndDelim()
                      << "marker id=\"startMarker" << m_arrowStartIndex++
@@ -601,7 +968,7 @@ void SVGDrawingGeneratorPrivate::setStyle(
         m_outputSink << "</" << getNamespaceAndDelim() << "marker>\n";
         m_outputSink << "</" << getNamespaceAndDelim() << "defs>\n";
     }
-    if (m_style["draw:marker-end-path"]) {
+    if (style[KEY_DRAW_MARKER_END_PATH]) {
         m_outputSink << "<" << getNamespaceAndDelim() << "defs>\n";
         m_outputSink << "<" << getNamespaceAndDelim() << "marker id=\"endMarker"
                      << m_arrowEndIndex++ << "\" ";
@@ -617,140 +984,358 @@ void SVGDrawingGeneratorPrivate::setStyle(
 }
 
 // create "style" attribute based on current pen and brush
-void SVGDrawingGeneratorPrivate::writeStyle(bool /* isClosed */) {
-    m_outputSink << "style=\"";
-
-    double width = 1.0 / 631.0;
-    if (m_style["svg:stroke-width"]) {
-        width = m_style["svg:stroke-width"]->getDouble();
+void SVGDrawingGeneratorPrivate::formatStyle() {
+    const SVGStyle &style = m_styleProps;
+    m_styleBuffer.clear();
+
+    // one user unit unless given
+    double width = 1.0 / m_transform.scale();
+    if (style[KEY_SVG_STROKE_WIDTH]) {
+        width = style[KEY_SVG_STROKE_WIDTH]->getDouble();
 #if 0
 		// add me in libmspub and libcdr
-		if (width <= 0.0 && m_style["draw:stroke"] && m_style["draw:stroke"]->getStr() != "none")
-			width = 0.2 / 631.0; // reasonable hairline
+		if (width <= 0.0 && style.stroke != SVGStyle::STROKE_UNSET &&
+        style.stroke != SVGStyle::STROKE_NONE)
+			width = 0.2 / m_transform.scale(); // reasonable hairline
 #endif
-        m_outputSink << "stroke-width: " << doubleToString(631 * width) << "; ";
+        m_styleBuffer << "stroke-width: "
+                      << FormattedDouble(m_transform.length(width)) << "; ";
     }
 
-    if (m_style["draw:stroke"] && m_style["draw:stroke"]->getStr() != "none") {
-        if (m_style["svg:stroke-color"])
-            m_outputSink << "stroke: "
-                         << m_style["svg:stroke-color"]->getStr().cstr()
+    if (style.stroke != SVGStyle::STROKE_UNSET &&
+        style.stroke != SVGStyle::STROKE_NONE) {
+        if (style[KEY_SVG_STROKE_COLOR])
+            m_styleBuffer << "stroke: "
+                         << style[KEY_SVG_STROKE_COLOR]->getStr().cstr()
                          << "; ";
-        if (m_style["svg:stroke-opacity"] &&
-            m_style["svg:stroke-opacity"]->getInt() != 1)
-            m_outputSink << "stroke-opacity: "
-                         << doubleToString(
-                                m_style["svg:stroke-opacity"]->getDouble())
+        if (style[KEY_SVG_STROKE_OPACITY] &&
+            style[KEY_SVG_STROKE_OPACITY]->getInt() != 1)
+            m_styleBuffer << "stroke-opacity: "
+                         << FormattedDouble(
+                                style[KEY_SVG_STROKE_OPACITY]->getDouble())
                          << "; ";
     }
 
-    if (m_style["draw:stroke"] && m_style["draw:stroke"]->getStr() == "solid")
-        m_outputSink << "stroke-dasharray: none; ";
-    else if (m_style["draw:stroke"] &&
-             m_style["draw:stroke"]->getStr() == "dash") {
-        int dots1 = m_style["draw:dots1"] ? m_style["draw:dots1"]->getInt() : 0;
-        int dots2 = m_style["draw:dots2"] ? m_style["draw:dots2"]->getInt() : 0;
-        double dots1len = 631. * width, dots2len = 631. * width,
-               gap = 631. * width;
-        if (m_style["draw:dots1-length"]) {
-            dots1len = 631. * m_style["draw:dots1-length"]->getDouble();
-            std::string str = m_style["draw:dots1-length"]->getStr().cstr();
+    if (style.stroke == SVGStyle::STROKE_SOLID)
+        m_styleBuffer << "stroke-dasharray: none; ";
+    else if (style.stroke == SVGStyle::STROKE_DASH) {
+        int dots1 = style[KEY_DRAW_DOTS1] ? style[KEY_DRAW_DOTS1]->getInt() : 0;
+        int dots2 = style[KEY_DRAW_DOTS2] ? style[KEY_DRAW_DOTS2]->getInt() : 0;
+        double dots1len = m_transform.length(width),
+               dots2len = m_transform.length(width),
+               gap = m_transform.length(width);
+        if (style[KEY_DRAW_DOTS1_LENGTH]) {
+            dots1len = m_transform.length(
+                style[KEY_DRAW_DOTS1_LENGTH]->getDouble());
+            std::string str = style[KEY_DRAW_DOTS1_LENGTH]->getStr().cstr();
             if (str.size() > 1 && str[str.size() - 1] == '%')
                 dots1len *= width;
         }
-        if (m_style["draw:dots2-length"]) {
-            dots2len = 631. * m_style["draw:dots2-length"]->getDouble();
-            std::string str = m_style["draw:dots2-length"]->getStr().cstr();
+        if (style[KEY_DRAW_DOTS2_LENGTH]) {
+            dots2len = m_transform.length(
+                style[KEY_DRAW_DOTS2_LENGTH]->getDouble());
+            std::string str = style[KEY_DRAW_DOTS2_LENGTH]->getStr().cstr();
             if (str.size() > 1 && str[str.size() - 1] == '%')
                 dots2len *= width;
         }
-        if (m_style["draw:distance"]) {
-            gap = 631. * m_style["draw:distance"]->getDouble();
-            std::string str = m_style["draw:distance"]->getStr().cstr();
+        if (style[KEY_DRAW_DISTANCE]) {
+            gap = m_transform.length(
+                style[KEY_DRAW_DISTANCE]->getDouble());
+            std::string str = style[KEY_DRAW_DISTANCE]->getStr().cstr();
             if (str.size() > 1 && str[str.size() - 1] == '%')
                 gap *= width;
         }
-        m_outputSink << "stroke-dasharray: ";
+        m_styleBuffer << "stroke-dasharray: ";
         for (int i = 0; i < dots1; i++) {
             if (i)
-                m_outputSink << ", ";
-            m_outputSink << doubleToString(dots1len);
-            m_outputSink << ", ";
-            m_outputSink << doubleToString(gap);
+                m_styleBuffer << ", ";
+            m_styleBuffer << FormattedDouble(dots1len);
+            m_styleBuffer << ", ";
+            m_styleBuffer << FormattedDouble(gap);
         }
         for (int j = 0; j < dots2; j++) {
-            m_outputSink << ", ";
-            m_outputSink << doubleToString(dots2len);
-            m_outputSink << ", ";
-            m_outputSink << doubleToString(gap);
+            m_styleBuffer << ", ";
+            m_styleBuffer << FormattedDouble(dots2len);
+            m_styleBuffer << ", ";
+            m_styleBuffer << FormattedDouble(gap);
         }
-        m_outputSink << "; ";
+        m_styleBuffer << "; ";
     }
 
-    if (m_style["svg:stroke-linecap"])
-        m_outputSink << "stroke-linecap: "
-                     << m_style["svg:stroke-linecap"]->getStr().cstr() << "; ";
-
-    if (m_style["svg:stroke-linejoin"])
-        m_outputSink << "stroke-linejoin: "
-                     << m_style["svg:stroke-linejoin"]->getStr().cstr() << "; ";
-
-    if (m_style["draw:fill"] && m_style["draw:fill"]->getStr() == "none")
-        m_outputSink << "fill: none; ";
-    else if (m_style["svg:fill-rule"])
-        m_outputSink << "fill-rule: "
-                     << m_style["svg:fill-rule"]->getStr().cstr() << "; ";
-
-    if (m_style["draw:fill"] && m_style["draw:fill"]->getStr() == "gradient")
-        m_outputSink << "fill: url(#grad" << m_gradientIndex - 1 << "); ";
-    else if (m_style["draw:fill"] && m_style["draw:fill"]->getStr() == "bitmap")
-        m_outputSink << "fill: url(#img" << m_patternIndex - 1 << "); ";
-
-    if (m_style["draw:shadow"] && m_style["draw:shadow"]->getStr() == "visible")
-        m_outputSink << "filter:url(#shadow" << m_shadowIndex - 1 << "); ";
-
-    if (m_style["draw:fill"] && m_style["draw:fill"]->getStr() == "solid")
-        if (m_style["draw:fill-color"])
-            m_outputSink << "fill: "
-                         << m_style["draw:fill-color"]->getStr().cstr() << "; ";
-    if (m_style["draw:opacity"] && m_style["draw:opacity"]->getDouble() < 1)
-        m_outputSink << "fill-opacity: "
-                     << doubleToString(m_style["draw:opacity"]->getDouble())
+    if (style[KEY_SVG_STROKE_LINECAP])
+        m_styleBuffer << "stroke-linecap: "
+                     << style[KEY_SVG_STROKE_LINECAP]->getStr().cstr() << "; ";
+
+    if (style[KEY_SVG_STROKE_LINEJOIN])
+        m_styleBuffer << "stroke-linejoin: "
+                     << style[KEY_SVG_STROKE_LINEJOIN]->getStr().cstr() << "; ";
+
+    if (style.fill == SVGStyle::FILL_NONE)
+        m_styleBuffer << "fill: none; ";
+    else if (style[KEY_SVG_FILL_RULE])
+        m_styleBuffer << "fill-rule: "
+                     << style[KEY_SVG_FILL_RULE]->getStr().cstr() << "; ";
+
+    if (style.fill == SVGStyle::FILL_GRADIENT)
+        m_styleBuffer << "fill: url(#grad" << m_gradientIndex - 1 << "); ";
+    else if (style.fill == SVGStyle::FILL_BITMAP)
+        m_styleBuffer << "fill: url(#img" << m_patternIndex - 1 << "); ";
+
+    if (style.shadow)
+        m_styleBuffer << "filter:url(#shadow" << m_shadowIndex - 1 << "); ";
+
+    if (style.fill == SVGStyle::FILL_SOLID)
+        if (style[KEY_DRAW_FILL_COLOR])
+            m_styleBuffer << "fill: "
+                         << style[KEY_DRAW_FILL_COLOR]->getStr().cstr() << "; ";
+    if (style[KEY_DRAW_OPACITY] && style[KEY_DRAW_OPACITY]->getDouble() < 1)
+        m_styleBuffer << "fill-opacity: "
+                     << FormattedDouble(style[KEY_DRAW_OPACITY]->getDouble())
                      << "; ";
 
-    if (m_style["draw:marker-start-path"])
-        m_outputSink << "marker-start: url(#startMarker"
+    if (style[KEY_DRAW_MARKER_START_PATH])
+        m_styleBuffer << "marker-start: url(#startMarker"
                      << m_arrowStartIndex - 1 << "); ";
-    if (m_style["draw:marker-end-path"])
-        m_outputSink << "marker-end: url(#endMarker" << m_arrowEndIndex - 1
+    if (style[KEY_DRAW_MARKER_END_PATH])
+        m_styleBuffer << "marker-end: url(#endMarker" << m_arrowEndIndex - 1
                      << "); ";
 
-    m_outputSink << "\""; // style
+    m_styleDecl = m_styleBuffer.str();
+}
+
+void SVGDrawingGeneratorPrivate::writeStyle(bool /* isClosed */) {
+    if (!m_styleDeclValid) {
+        formatStyle();
+        m_styleDeclValid = true;
+        m_styleClass = -1;
+    }
+    if (!m_useStyleClasses) {
+        m_outputSink << "style=\"" << m_styleDecl << "\"";
+        return;
+    }
+    if (m_styleClass < 0) {
+        std::unordered_map<std::string, unsigned>::iterator it =
+            m_styleClassIds.find(m_styleDecl);
+        if (it == m_styleClassIds.end()) {
+            unsigned id = (unsigned)m_styleClasses.size();
+            it = m_styleClassIds.insert(std::make_pair(m_styleDecl, id)).first;
+            m_styleClasses.push_back(&it->first);
+        }
+        m_styleClass = (int)it->second;
+    }
+    m_outputSink << "class=\"s" << m_styleClass << "\"";
+}
+
+void SVGDrawingGeneratorPrivate::writeStyleClasses() {
+    if (m_styleClasses.empty())
+        return;
+    m_outputSink << "<" << getNamespaceAndDelim()
+                 << "style type=\"text/css\"><![CDATA[\n";
+    for (size_t i = 0; i < m_styleClasses.size(); i++)
+        m_outputSink << ".s" << (unsigned long)i << " { "
+                     << *m_styleClasses[i] << "}\n";
+    m_outputSink << "]]></" << getNamespaceAndDelim() << "style>\n";
+}
+
+void SVGDrawingGeneratorPrivate::writeBinary(
+    const librevenge::RVNGProperty *prop) {
+#ifdef HAVE_RVNG_BINARY_DATA_ACCESS
+    const librevenge::RVNGBinaryData *binary =
+        librevenge::RVNGPropertyFactory::getBinaryData(prop);
+    if (binary) {
+        // encoded straight in the page instead of in a temporary string
+        m_outputSink.appendBase64(binary->getDataBuffer(), binary->size());
+        return;
+    }
+#endif
+    m_outputSink << prop->getStr().cstr();
+}
+
+void SVGDrawingGeneratorPrivate::endPage() {
+    if (m_pendingEMF.empty() && m_pendingPages.empty()) {
+        writePage(m_outputSink);
+        m_outputSink.clear();
+        return;
+    }
+    PendingPage *page;
+    if (m_freePages.empty())
+        page = new PendingPage();
+    else {
+        page = m_freePages.back();
+        m_freePages.pop_back();
+    }
+    page->buffer.swap(m_outputSink);
+    page->emfs.swap(m_pendingEMF);
+    m_pendingPages.push_back(page);
+    flushPages(false);
+}
+
+void SVGDrawingGeneratorPrivate::flushPages(bool wait) {
+    // bound the memory used by the queued pages
+    size_t maxPending = 2 * (m_emfConverter ? m_emfConverter->threads() : 0);
+    while (!m_pendingPages.empty()) {
+        PendingPage *page = m_pendingPages.front();
+        if (!wait && m_pendingPages.size() <= maxPending) {
+            bool ready = true;
+            for (size_t i = 0; ready && i < page->emfs.size(); i++)
+                ready = page->emfs[i].result.wait_for(
+                            std::chrono::seconds(0)) ==
+                        std::future_status::ready;
+            if (!ready)
+                return;
+        }
+        for (size_t i = 0; i < page->emfs.size(); i++) {
+            PendingEMF &emf = page->emfs[i];
+            emf.svg = emf.result.get();
+            page->buffer.fillSlot(emf.slot, emf.svg->data(), emf.svg->size());
+        }
+        writePage(page->buffer);
+        page->buffer.clear();
+        page->emfs.clear();
+        m_pendingPages.pop_front();
+        m_freePages.push_back(page);
+    }
+}
+
+void SVGDrawingGeneratorPrivate::discardPages() {
+    m_pendingEMF.clear();
+    while (!m_pendingPages.empty()) {
+        PendingPage *page = m_pendingPages.front();
+        page->buffer.clear();
+        page->emfs.clear();
+        m_pendingPages.pop_front();
+        m_freePages.push_back(page);
+    }
+}
+
+void SVGDrawingGeneratorPrivate::writePage(const SVGOutputBuffer &buffer) {
+    const std::vector<struct iovec> &chunks = buffer.chunks();
+    m_sink->writePage(chunks.empty() ? NULL : &chunks[0], chunks.size());
+    if (m_stats) {
+        size_t bytes = 0;
+        for (size_t i = 0; i < chunks.size(); i++)
+            bytes += chunks[i].iov_len;
+        m_stats->add(SVGStats::PAGES);
+        m_stats->add(SVGStats::BYTES_EMITTED, bytes);
+    }
+}
+
+void SVGDrawingGeneratorPrivate::resetStyleClasses() {
+    m_styleClassIds.clear();
+    m_styleClasses.clear();
+    m_styleClass = -1;
 }
 
+
 SVGDrawingGenerator::SVGDrawingGenerator(librevenge::RVNGStringVector &vec,
                                          const librevenge::RVNGString &nmSpace)
-    : m_pImpl(new SVGDrawingGeneratorPrivate(vec, nmSpace)) {
+    : m_pImpl(new SVGDrawingGeneratorPrivate(new StringVectorPageSink(vec),
+                                             true, nmSpace)),
+      textLastX(0), textLastFontSize(0), textIsParagraph(false),
+      firtLineWritten(false), textNewLine(false), textSpaceCounter(0) {
+}
+
+SVGDrawingGenerator::SVGDrawingGenerator(SVGPageSink &sink,
+                                         const librevenge::RVNGString &nmSpace)
+    : m_pImpl(new SVGDrawingGeneratorPrivate(&sink, false, nmSpace)),
+      textLastX(0), textLastFontSize(0), textIsParagraph(false),
+      firtLineWritten(false), textNewLine(false), textSpaceCounter(0) {
 }
 
 SVGDrawingGenerator::~SVGDrawingGenerator() {
     delete m_pImpl;
 }
 
+void SVGDrawingGenerator::setStyleClasses(bool enable) {
+    m_pImpl->m_useStyleClasses = enable;
+}
+
+void SVGDrawingGenerator::setEMFCache(SVGEMFCache *cache) {
+    m_pImpl->m_emfCache = cache;
+}
+
+void SVGDrawingGenerator::setStats(SVGStats *stats) {
+    m_pImpl->m_stats = stats;
+}
+
+void SVGDrawingGenerator::setTrace(SVGTrace *trace) {
+    m_pImpl->m_trace = trace;
+}
+
+void SVGDrawingGenerator::setScale(double scale) {
+    m_pImpl->m_transform.setScale(scale);
+    // the stroke widths of the current style are scaled too
+    m_pImpl->m_styleDeclValid = false;
+}
+
+void SVGDrawingGenerator::setOrigin(double x, double y) {
+    m_pImpl->m_transform.setOrigin(x, y);
+}
+
+void SVGDrawingGenerator::setSimplification(double tolerance) {
+    m_pImpl->m_simplifier.setTolerance(tolerance);
+}
+
+void SVGDrawingGenerator::setEMFThreads(unsigned nbThreads) {
+    if (m_pImpl->m_emfConverter &&
+        m_pImpl->m_emfConverter->threads() == nbThreads)
+        return;
+    // the conversions already queued are completed by the destructor
+    delete m_pImpl->m_emfConverter;
+    m_pImpl->m_emfConverter = nbThreads ? new SVGEMFConverter(nbThreads) : NULL;
+}
+
 void SVGDrawingGenerator::startDocument(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::START_DOCUMENT);
+    // the generator can be reused for several documents, start each one
+    // from a clean state so that the output doesn't depend on the history
+    m_pImpl->m_idSpanMap.clear();
+    m_pImpl->m_gradient.clear();
+    m_pImpl->m_style.clear();
+    m_pImpl->m_styleProps.decode(m_pImpl->m_style);
+    m_pImpl->m_styleDeclValid = false;
+    m_pImpl->resetStyleClasses();
+    m_pImpl->m_gradientIndex = 1;
+    m_pImpl->m_shadowIndex = 1;
+    m_pImpl->m_patternIndex = 1;
+    m_pImpl->m_arrowStartIndex = 1;
+    m_pImpl->m_arrowEndIndex = 1;
+    m_pImpl->m_layerId = 1000;
+    m_pImpl->m_pageIndex = 0;
+    m_pImpl->m_outputSink.clear();
+    m_pImpl->discardPages();
+    textLastX = 0;
+    textLastFontSize = 0;
+    textIsParagraph = false;
+    firtLineWritten = false;
+    textNewLine = false;
+    textSpaceCounter = 0;
 }
 void SVGDrawingGenerator::endDocument() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::END_DOCUMENT);
+    m_pImpl->flushPages(true);
 }
 void SVGDrawingGenerator::setDocumentMetaData(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::SET_DOCUMENT_META_DATA);
 }
 void SVGDrawingGenerator::defineEmbeddedFont(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::DEFINE_EMBEDDED_FONT);
 }
 
 void SVGDrawingGenerator::startPage(
     const librevenge::RVNGPropertyList &propList) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::START_PAGE);
+    if (m_pImpl->m_trace)
+        m_pImpl->m_pageStart = SVGTrace::now();
+    m_pImpl->resetStyleClasses();
     //#if 0
     m_pImpl->m_outputSink
         << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
@@ -768,34 +1353,49 @@ void SVGDrawingGenerator::startPage(
     if (propList["svg:width"])
         m_pImpl->m_outputSink
             << "width=\""
-            << doubleToString(631 * (propList["svg:width"]->getDouble()))
+            << FormattedDouble(m_pImpl->m_transform.length(
+                   propList["svg:width"]->getDouble()))
             << "\" ";
     if (propList["svg:height"])
         m_pImpl->m_outputSink
             << "height=\""
-            << doubleToString(631 * (propList["svg:height"]->getDouble()))
+            << FormattedDouble(m_pImpl->m_transform.length(
+                   propList["svg:height"]->getDouble()))
             << "\"";
     m_pImpl->m_outputSink << " >\n";
 }
 
 void SVGDrawingGenerator::endPage() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace, SVGStats::END_PAGE);
+    m_pImpl->writeStyleClasses();
     m_pImpl->m_outputSink << "</" << m_pImpl->getNamespaceAndDelim()
                           << "svg>\n";
-    m_pImpl->m_vec.append(m_pImpl->m_outputSink.str().c_str());
-    m_pImpl->m_outputSink.str("");
+    m_pImpl->endPage();
+    if (m_pImpl->m_trace)
+        m_pImpl->m_trace->record("page", "page", m_pImpl->m_pageStart,
+                                 m_pImpl->m_pageIndex);
+    m_pImpl->m_pageIndex++;
 }
 
 void SVGDrawingGenerator::startMasterPage(
     const librevenge::RVNGPropertyList &) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::START_MASTER_PAGE);
 }
 
 void SVGDrawingGenerator::endMasterPage() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::END_MASTER_PAGE);
     // we don't do anything with master pages yet, so just reset the content
-    m_pImpl->m_outputSink.str("");
+    m_pImpl->m_outputSink.clear();
+    m_pImpl->m_pendingEMF.clear();
+    m_pImpl->resetStyleClasses();
 }
 
 void SVGDrawingGenerator::startLayer(
     const librevenge::RVNGPropertyList &propList) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::START_LAYER);
     m_pImpl->m_outputSink << "<" << m_pImpl->getNamespaceAndDelim() << "g";
     if (propList["svg:id"])
         m_pImpl->m_outputSink << " id=\"Layer"
@@ -810,84 +1410,115 @@ void SVGDrawingGenerator::startLayer(
 }
 
 void SVGDrawingGenerator::endLayer() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::END_LAYER);
     m_pImpl->m_outputSink << "</" << m_pImpl->getNamespaceAndDelim() << "g>\n";
 }
 
 void SVGDrawingGenerator::startEmbeddedGraphics(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::START_EMBEDDED_GRAPHICS);
     m_pImpl->m_outputSink
         << "<!-- [startEmbeddedGraphics] not implemented -->\n";
 }
 void SVGDrawingGenerator::endEmbeddedGraphics() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::END_EMBEDDED_GRAPHICS);
     m_pImpl->m_outputSink << "<!-- [endEmbeddedGraphics] not implemented -->\n";
 }
 
 void SVGDrawingGenerator::openGroup(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::OPEN_GROUP);
 }
 void SVGDrawingGenerator::closeGroup() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::CLOSE_GROUP);
 }
 
 void SVGDrawingGenerator::setStyle(
     const librevenge::RVNGPropertyList &propList) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::SET_STYLE);
     m_pImpl->setStyle(propList);
 }
 
 void SVGDrawingGenerator::drawRectangle(
     const librevenge::RVNGPropertyList &propList) {
-    if (!propList["svg:x"] || !propList["svg:y"] || !propList["svg:width"] ||
-        !propList["svg:height"])
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::DRAW_RECTANGLE);
+    SVGProperties props(propList);
+    if (!props[KEY_SVG_X] || !props[KEY_SVG_Y] || !props[KEY_SVG_WIDTH] ||
+        !props[KEY_SVG_HEIGHT])
         return;
     m_pImpl->m_outputSink << "<" << m_pImpl->getNamespaceAndDelim() << "rect ";
+    const SVGTransform &transform = m_pImpl->m_transform;
     m_pImpl->m_outputSink
-        << "x=\"" << doubleToString(631 * propList["svg:x"]->getDouble())
-        << "\" y=\"" << doubleToString(631 * propList["svg:y"]->getDouble())
-        << "\" ";
+        << "x=\"" << FormattedDouble(transform.x(props[KEY_SVG_X]->getDouble()))
+        << "\" y=\""
+        << FormattedDouble(transform.y(props[KEY_SVG_Y]->getDouble())) << "\" ";
     m_pImpl->m_outputSink
         << "width=\""
-        << doubleToString(631 * propList["svg:width"]->getDouble())
+        << FormattedDouble(transform.length(props[KEY_SVG_WIDTH]->getDouble()))
         << "\" height=\""
-        << doubleToString(631 * propList["svg:height"]->getDouble()) << "\" ";
-    if (propList["svg:rx"] && propList["svg:rx"]->getDouble() > 0 &&
-        propList["svg:ry"] && propList["svg:ry"]->getDouble() > 0)
+        << FormattedDouble(transform.length(props[KEY_SVG_HEIGHT]->getDouble()))
+        << "\" ";
+    if (props[KEY_SVG_RX] && props[KEY_SVG_RX]->getDouble() > 0 &&
+        props[KEY_SVG_RY] && props[KEY_SVG_RY]->getDouble() > 0)
         m_pImpl->m_outputSink
-            << "rx=\"" << doubleToString(631 * propList["svg:rx"]->getDouble())
+            << "rx=\""
+            << FormattedDouble(transform.length(props[KEY_SVG_RX]->getDouble()))
             << "\" ry=\""
-            << doubleToString(631 * propList["svg:ry"]->getDouble()) << "\" ";
+            << FormattedDouble(transform.length(props[KEY_SVG_RY]->getDouble()))
+            << "\" ";
     m_pImpl->writeStyle();
     m_pImpl->m_outputSink << "/>\n";
 }
 
 void SVGDrawingGenerator::drawEllipse(
     const librevenge::RVNGPropertyList &propList) {
-    if (!propList["svg:cx"] || !propList["svg:cy"] || !propList["svg:rx"] ||
-        !propList["svg:ry"])
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::DRAW_ELLIPSE);
+    SVGProperties props(propList);
+    if (!props[KEY_SVG_CX] || !props[KEY_SVG_CY] || !props[KEY_SVG_RX] ||
+        !props[KEY_SVG_RY])
         return;
     m_pImpl->m_outputSink << "<" << m_pImpl->getNamespaceAndDelim()
                           << "ellipse ";
+    const SVGTransform &transform = m_pImpl->m_transform;
     m_pImpl->m_outputSink
-        << "cx=\"" << doubleToString(631 * propList["svg:cx"]->getDouble())
-        << "\" cy=\"" << doubleToString(631 * propList["svg:cy"]->getDouble())
+        << "cx=\""
+        << FormattedDouble(transform.x(props[KEY_SVG_CX]->getDouble()))
+        << "\" cy=\""
+        << FormattedDouble(transform.y(props[KEY_SVG_CY]->getDouble()))
         << "\" ";
     m_pImpl->m_outputSink
-        << "rx=\"" << doubleToString(631 * propList["svg:rx"]->getDouble())
-        << "\" ry=\"" << doubleToString(631 * propList["svg:ry"]->getDouble())
+        << "rx=\""
+        << FormattedDouble(transform.length(props[KEY_SVG_RX]->getDouble()))
+        << "\" ry=\""
+        << FormattedDouble(transform.length(props[KEY_SVG_RY]->getDouble()))
         << "\" ";
     m_pImpl->writeStyle();
-    if (propList["librevenge:rotate"] &&
-        (propList["librevenge:rotate"]->getDouble() < 0 ||
-         propList["librevenge:rotate"]->getDouble() > 0))
+    if (props[KEY_LIBREVENGE_ROTATE] &&
+        (props[KEY_LIBREVENGE_ROTATE]->getDouble() < 0 ||
+         props[KEY_LIBREVENGE_ROTATE]->getDouble() > 0))
         m_pImpl->m_outputSink
             << " transform=\" rotate("
-            << doubleToString(-propList["librevenge:rotate"]->getDouble())
-            << ", " << doubleToString(631 * propList["svg:cy"]->getDouble())
-            << ", " << doubleToString(631 * propList["svg:cy"]->getDouble())
+            << FormattedDouble(-props[KEY_LIBREVENGE_ROTATE]->getDouble())
+            << ", "
+            << FormattedDouble(transform.y(props[KEY_SVG_CY]->getDouble()))
+            << ", "
+            << FormattedDouble(transform.y(props[KEY_SVG_CY]->getDouble()))
             << ")\" ";
     m_pImpl->m_outputSink << "/>\n";
 }
 
 void SVGDrawingGenerator::drawPolyline(
     const librevenge::RVNGPropertyList &propList) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::DRAW_POLYLINE);
     const librevenge::RVNGPropertyListVector *vertices =
         propList.child("svg:points");
     if (vertices && vertices->count())
@@ -896,6 +1527,8 @@ void SVGDrawingGenerator::drawPolyline(
 
 void SVGDrawingGenerator::drawPolygon(
     const librevenge::RVNGPropertyList &propList) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::DRAW_POLYGON);
     const librevenge::RVNGPropertyListVector *vertices =
         propList.child("svg:points");
     if (vertices && vertices->count())
@@ -904,87 +1537,25 @@ void SVGDrawingGenerator::drawPolygon(
 
 void SVGDrawingGenerator::drawPath(
     const librevenge::RVNGPropertyList &propList) {
-    const librevenge::RVNGPropertyListVector *path = propList.child("svg:d");
-    if (!path)
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::DRAW_PATH);
+#ifdef HAVE_RVNG_PATH
+    // libvisio sends its paths as arrays, which need no decoding
+    const librevenge::RVNGPath *typedPath = propList.path("svg:d");
+    if (typedPath) {
+        m_pImpl->drawPath(*typedPath);
         return;
-    m_pImpl->m_outputSink << "<" << m_pImpl->getNamespaceAndDelim()
-                          << "path d=\" ";
-    bool isClosed = false;
-    unsigned i = 0;
-    for (i = 0; i < path->count(); i++) {
-        librevenge::RVNGPropertyList pList((*path)[i]);
-        if (!pList["librevenge:path-action"])
-            continue;
-        std::string action = pList["librevenge:path-action"]->getStr().cstr();
-        if (action.length() != 1)
-            continue;
-        bool coordOk = pList["svg:x"] && pList["svg:y"];
-        bool coord1Ok = coordOk && pList["svg:x1"] && pList["svg:y1"];
-        bool coord2Ok = coord1Ok && pList["svg:x2"] && pList["svg:y2"];
-        if (pList["svg:x"] && action[0] == 'H')
-            m_pImpl->m_outputSink
-                << "\nH" << doubleToString(631 * (pList["svg:x"]->getDouble()));
-        else if (pList["svg:y"] && action[0] == 'V')
-            m_pImpl->m_outputSink
-                << "\nV" << doubleToString(631 * (pList["svg:y"]->getDouble()));
-        else if (coordOk &&
-                 (action[0] == 'M' || action[0] == 'L' || action[0] == 'T')) {
-            m_pImpl->m_outputSink << "\n" << action;
-            m_pImpl->m_outputSink
-                << doubleToString(631 * (pList["svg:x"]->getDouble())) << ","
-                << doubleToString(631 * (pList["svg:y"]->getDouble()));
-        } else if (coord1Ok && (action[0] == 'Q' || action[0] == 'S')) {
-            m_pImpl->m_outputSink << "\n" << action;
-            m_pImpl->m_outputSink
-                << doubleToString(631 * (pList["svg:x1"]->getDouble())) << ","
-                << doubleToString(631 * (pList["svg:y1"]->getDouble())) << " ";
-            m_pImpl->m_outputSink
-                << doubleToString(631 * (pList["svg:x"]->getDouble())) << ","
-                << doubleToString(631 * (pList["svg:y"]->getDouble()));
-        } else if (coord2Ok && action[0] == 'C') {
-            m_pImpl->m_outputSink << "\nC";
-            m_pImpl->m_outputSink
-                << doubleToString(631 * (pList["svg:x1"]->getDouble())) << ","
-                << doubleToString(631 * (pList["svg:y1"]->getDouble())) << " ";
-            m_pImpl->m_outputSink
-                << doubleToString(631 * (pList["svg:x2"]->getDouble())) << ","
-                << doubleToString(631 * (pList["svg:y2"]->getDouble())) << " ";
-            m_pImpl->m_outputSink
-                << doubleToString(631 * (pList["svg:x"]->getDouble())) << ","
-                << doubleToString(631 * (pList["svg:y"]->getDouble()));
-        } else if (coordOk && pList["svg:rx"] && pList["svg:ry"] &&
-                   action[0] == 'A') {
-            m_pImpl->m_outputSink << "\nA";
-            m_pImpl->m_outputSink
-                << doubleToString(631 * (pList["svg:rx"]->getDouble())) << ","
-                << doubleToString(631 * (pList["svg:ry"]->getDouble())) << " ";
-            m_pImpl->m_outputSink
-                << doubleToString(pList["librevenge:rotate"]
-                                      ? pList["librevenge:rotate"]->getDouble()
-                                      : 0) << " ";
-            m_pImpl->m_outputSink
-                << (pList["librevenge:large-arc"]
-                        ? pList["librevenge:large-arc"]->getInt()
-                        : 1) << ",";
-            m_pImpl->m_outputSink << (pList["librevenge:sweep"]
-                                          ? pList["librevenge:sweep"]->getInt()
-                                          : 1) << " ";
-            m_pImpl->m_outputSink
-                << doubleToString(631 * (pList["svg:x"]->getDouble())) << ","
-                << doubleToString(631 * (pList["svg:y"]->getDouble()));
-        } else if (action[0] == 'Z') {
-            isClosed = true;
-            m_pImpl->m_outputSink << "\nZ";
-        }
     }
-
-    m_pImpl->m_outputSink << "\" \n";
-    m_pImpl->writeStyle(isClosed);
-    m_pImpl->m_outputSink << "/>\n";
+#endif
+    const librevenge::RVNGPropertyListVector *path = propList.child("svg:d");
+    if (path)
+        m_pImpl->drawPath(*path);
 }
 
 void SVGDrawingGenerator::drawGraphicObject(
     const librevenge::RVNGPropertyList &propList) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::DRAW_GRAPHIC_OBJECT);
     if (!propList["librevenge:mime-type"] ||
         propList["librevenge:mime-type"]->getStr().len() <= 0)
         return;
@@ -992,30 +1563,48 @@ void SVGDrawingGenerator::drawGraphicObject(
         return;
     // emf binary blob handling
     if (propList["librevenge:mime-type"]->getStr() == "image/emf") {
-        librevenge::RVNGBinaryData raw_data(
-            propList["office:binary-data"]->getStr());
+        const unsigned char *emf_data;
+        size_t emf_size;
+        getBinaryData(propList["office:binary-data"], m_pImpl->m_binaryScratch,
+                      emf_data, emf_size);
         // options->imgWidth = (int)propList["svg:width"]->getDouble();
         // options->imgHeight = (int)propList["svg:height"]->getDouble();
-        char *svg_out = NULL;
-        char *emf_content = (char *)raw_data.getDataBuffer();
-        size_t emf_size = (size_t)raw_data.getBase64Data().size();
-        generatorOptions *options =
-            (generatorOptions *)calloc(1, sizeof(generatorOptions));
-        options->verbose = false;
-        options->emfplus = true;
-        // options->nameSpace = (char *)"svg";
-        options->nameSpace = (char *)m_pImpl->m_nmSpace.c_str();
-        options->svgDelimiter = false;
-        options->imgWidth = propList["svg:width"]->getDouble() * 631;
-        options->imgHeight = propList["svg:height"]->getDouble() * 631;
-
-        // extract emf blob in separate file (DEBUGGING)
-        // std::ofstream ofs (std::to_string(rand()), std::ios::out |
-        // std::ios::binary);
-        // ofs.write(emf_content, emf_size);
-        // ofs.close();
-
-        int ret = emf2svg(emf_content, emf_size, &svg_out, options);
+        char *emf_content = (char *)emf_data;
+        double imgWidth =
+            m_pImpl->m_transform.length(propList["svg:width"]->getDouble());
+        double imgHeight =
+            m_pImpl->m_transform.length(propList["svg:height"]->getDouble());
+
+        SVGEMFCache::Fragment svg_out;
+        if (m_pImpl->m_emfCache)
+            svg_out = m_pImpl->m_emfCache->find(SVGEMFKey(emf_content, emf_size,
+                                                          imgWidth, imgHeight,
+                                                          m_pImpl->m_nmSpace));
+        if (m_pImpl->m_stats) {
+            m_pImpl->m_stats->add(SVGStats::EMF_IMAGES);
+            if (svg_out)
+                m_pImpl->m_stats->add(SVGStats::EMF_CACHE_HITS);
+        }
+        std::shared_future<SVGEMFCache::Fragment> svg_pending;
+        if (!svg_out) {
+            // extract emf blob in separate file (DEBUGGING)
+            // std::ofstream ofs (std::to_string(rand()), std::ios::out |
+            // std::ios::binary);
+            // ofs.write(emf_content, emf_size);
+            // ofs.close();
+
+            if (m_pImpl->m_emfConverter)
+                svg_pending = m_pImpl->m_emfConverter->convert(
+                    emf_content, emf_size, imgWidth, imgHeight,
+                    m_pImpl->m_nmSpace, m_pImpl->m_emfCache, m_pImpl->m_stats,
+                    m_pImpl->m_trace);
+            else {
+                SVGScopedTimer timer(m_pImpl->m_stats, SVGStats::EMF_INLINE);
+                svg_out = convertEMF(emf_content, emf_size, imgWidth, imgHeight,
+                                     m_pImpl->m_nmSpace, m_pImpl->m_emfCache,
+                                     m_pImpl->m_stats, m_pImpl->m_trace);
+            }
+        }
 
         // m_pImpl->m_outputSink << "<!-- start emf conversion -->\n";
         m_pImpl->m_outputSink << "<" << m_pImpl->getNamespaceAndDelim() << "g ";
@@ -1028,21 +1617,28 @@ void SVGDrawingGenerator::drawGraphicObject(
         bool flipY(propList["draw:mirror-vertical"] &&
                    propList["draw:mirror-vertical"]->getInt());
 
-        // m_pImpl->m_outputSink << "x=\"" << doubleToString(631*x) << "\" y=\""
-        // << doubleToString(631*y) << "\" ";
-        // m_pImpl->m_outputSink << "width=\"" << doubleToString(631*width) <<
-        // "\" height=\"" << doubleToString(631*height) << "\" ";
+        // m_pImpl->m_outputSink << "x=\"" << FormattedDouble(631*x) <<
+        // "\" y=\"" << FormattedDouble(631*y) << "\" ";
+        // m_pImpl->m_outputSink << "width=\"" << FormattedDouble(631*width) <<
+        // "\" height=\"" << FormattedDouble(631*height) << "\" ";
         m_pImpl->m_outputSink << "transform=\"";
-        m_pImpl->m_outputSink << " translate(" << doubleToString(631 * x)
-                              << ", " << doubleToString(631 * y) << ") ";
+        m_pImpl->m_outputSink
+            << " translate(" << FormattedDouble(m_pImpl->m_transform.x(x))
+            << ", " << FormattedDouble(m_pImpl->m_transform.y(y)) << ") ";
         m_pImpl->m_outputSink << "\" ";
         m_pImpl->m_outputSink << " >\n";
-        m_pImpl->m_outputSink << svg_out;
+        if (svg_out)
+            m_pImpl->m_outputSink << *svg_out;
+        else {
+            // spliced in by endPage once converted
+            SVGDrawingGeneratorPrivate::PendingEMF pending;
+            pending.slot = m_pImpl->m_outputSink.addSlot();
+            pending.result = svg_pending;
+            m_pImpl->m_pendingEMF.push_back(pending);
+        }
         m_pImpl->m_outputSink << "</" << m_pImpl->getNamespaceAndDelim()
                               << "g>\n";
         // m_pImpl->m_outputSink << "<!-- end emf conversion -->\n";
-        free(svg_out);
-        free(options);
         return;
     } else {
         m_pImpl->m_outputSink << "<" << m_pImpl->getNamespaceAndDelim()
@@ -1058,19 +1654,21 @@ void SVGDrawingGenerator::drawGraphicObject(
             bool flipY(propList["draw:mirror-vertical"] &&
                        propList["draw:mirror-vertical"]->getInt());
 
-            m_pImpl->m_outputSink << "x=\"" << doubleToString(631 * x)
-                                  << "\" y=\"" << doubleToString(631 * y)
-                                  << "\" ";
-            m_pImpl->m_outputSink << "width=\"" << doubleToString(631 * width)
-                                  << "\" height=\""
-                                  << doubleToString(631 * height) << "\" ";
+            const SVGTransform &transform = m_pImpl->m_transform;
+            m_pImpl->m_outputSink << "x=\"" << FormattedDouble(transform.x(x))
+                                  << "\" y=\""
+                                  << FormattedDouble(transform.y(y)) << "\" ";
+            m_pImpl->m_outputSink
+                << "width=\"" << FormattedDouble(transform.length(width))
+                << "\" height=\"" << FormattedDouble(transform.length(height))
+                << "\" ";
             if (flipX || flipY || propList["librevenge:rotate"]) {
                 double xmiddle = x + width / 2.0;
                 double ymiddle = y + height / 2.0;
                 m_pImpl->m_outputSink << "transform=\"";
-                m_pImpl->m_outputSink << " translate("
-                                      << doubleToString(631 * xmiddle) << ", "
-                                      << doubleToString(631 * ymiddle) << ") ";
+                m_pImpl->m_outputSink
+                    << " translate(" << FormattedDouble(transform.x(xmiddle))
+                    << ", " << FormattedDouble(transform.y(ymiddle)) << ") ";
                 m_pImpl->m_outputSink << " scale(" << (flipX ? "-1" : "1")
                                       << ", " << (flipY ? "-1" : "1") << ") ";
                 // rotation is around the center of the object's bounding box
@@ -1080,32 +1678,35 @@ void SVGDrawingGenerator::drawGraphicObject(
                         angle -= 360.0;
                     while (angle < -180.0)
                         angle += 360.0;
-                    m_pImpl->m_outputSink << " rotate(" << doubleToString(angle)
-                                          << ") ";
+                    m_pImpl->m_outputSink
+                        << " rotate(" << FormattedDouble(angle) << ") ";
                 }
-                m_pImpl->m_outputSink << " translate("
-                                      << doubleToString(-631 * xmiddle) << ", "
-                                      << doubleToString(-631 * ymiddle) << ") ";
+                m_pImpl->m_outputSink
+                    << " translate(" << FormattedDouble(-transform.x(xmiddle))
+                    << ", " << FormattedDouble(-transform.y(ymiddle)) << ") ";
                 m_pImpl->m_outputSink << "\" ";
             }
         }
         m_pImpl->m_outputSink
             << "xlink:href=\"data:"
             << propList["librevenge:mime-type"]->getStr().cstr() << ";base64,";
-        m_pImpl->m_outputSink
-            << propList["office:binary-data"]->getStr().cstr();
+        m_pImpl->writeBinary(propList["office:binary-data"]);
         m_pImpl->m_outputSink << "\" />\n";
     }
 }
 
 void SVGDrawingGenerator::drawConnector(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::DRAW_CONNECTOR);
     m_pImpl->m_outputSink << "<!-- [drawConnector] not implemented -->\n";
     // TODO: implement me
 }
 
 void SVGDrawingGenerator::startTextObject(
     const librevenge::RVNGPropertyList &propList) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::START_TEXT_OBJECT);
     double x = 0.0;
     double y = 0.0;
     double height = 0.0;
@@ -1144,9 +1745,11 @@ void SVGDrawingGenerator::startTextObject(
     if (propList["fo:padding-left"])
         x += propList["fo:padding-left"]->getDouble();
 
-    textLastX = 631 * x;
-    m_pImpl->m_outputSink << "x=\"" << doubleToString(631 * x) << "\" y=\""
-                          << doubleToString(631 * y) << "\"";
+    const SVGTransform &transform = m_pImpl->m_transform;
+    textLastX = transform.x(x);
+    m_pImpl->m_outputSink << "x=\"" << FormattedDouble(transform.x(x))
+                          << "\" y=\"" << FormattedDouble(transform.y(y))
+                          << "\"";
 
     // rotation is around the center of the object's bounding box
     if (propList["librevenge:rotate"] &&
@@ -1157,53 +1760,72 @@ void SVGDrawingGenerator::startTextObject(
             angle -= 360.0;
         while (angle < -180.0)
             angle += 360.0;
-        m_pImpl->m_outputSink << " transform=\"rotate(" << doubleToString(angle)
-                              << ", " << doubleToString(631 * xmiddle) << ", "
-                              << doubleToString(631 * ymiddle) << ")\" ";
+        m_pImpl->m_outputSink
+            << " transform=\"rotate(" << FormattedDouble(angle) << ", "
+            << FormattedDouble(transform.x(xmiddle)) << ", "
+            << FormattedDouble(transform.y(ymiddle)) << ")\" ";
     }
     m_pImpl->m_outputSink << ">\n";
 }
 
 void SVGDrawingGenerator::endTextObject() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::END_TEXT_OBJECT);
     m_pImpl->m_outputSink << "</" << m_pImpl->getNamespaceAndDelim()
                           << "text>\n";
 }
 
 void SVGDrawingGenerator::openOrderedListLevel(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::OPEN_ORDERED_LIST_LEVEL);
     m_pImpl->m_outputSink
         << "<!-- [openOrderedListLevel] not implemented -->\n";
 }
 void SVGDrawingGenerator::closeOrderedListLevel() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::CLOSE_ORDERED_LIST_LEVEL);
     m_pImpl->m_outputSink
         << "<!-- [closeOrderedListLevel] not implemented -->\n";
 }
 
 void SVGDrawingGenerator::openUnorderedListLevel(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::OPEN_UNORDERED_LIST_LEVEL);
     m_pImpl->m_outputSink
         << "<!-- [openUnorderedListLevel] not implemented -->\n";
 }
 void SVGDrawingGenerator::closeUnorderedListLevel() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::CLOSE_UNORDERED_LIST_LEVEL);
     m_pImpl->m_outputSink
         << "<!-- [closeUnorderedListLevel] not implemented -->\n";
 }
 
 void SVGDrawingGenerator::openListElement(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::OPEN_LIST_ELEMENT);
     m_pImpl->m_outputSink << "<!-- [openListElement] not implemented -->\n";
 }
 void SVGDrawingGenerator::closeListElement() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::CLOSE_LIST_ELEMENT);
     m_pImpl->m_outputSink << "<!-- [closeListElement] not implemented -->\n";
 }
 
 void SVGDrawingGenerator::defineParagraphStyle(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::DEFINE_PARAGRAPH_STYLE);
     m_pImpl->m_outputSink
         << "<!-- [defineParagraphStyle] not implemented -->\n";
 }
 void SVGDrawingGenerator::openParagraph(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::OPEN_PARAGRAPH);
     textIsParagraph = 1;
     firtLineWritten = 0;
     textSpaceCounter = 0;
@@ -1211,6 +1833,8 @@ void SVGDrawingGenerator::openParagraph(
     m_pImpl->m_outputSink << "<!-- [openParagraph] marker -->\n";
 }
 void SVGDrawingGenerator::closeParagraph() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::CLOSE_PARAGRAPH);
     textIsParagraph = 0;
     textNewLine = 1;
     textSpaceCounter = 0;
@@ -1219,6 +1843,8 @@ void SVGDrawingGenerator::closeParagraph() {
 
 void SVGDrawingGenerator::defineCharacterStyle(
     const librevenge::RVNGPropertyList &propList) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::DEFINE_CHARACTER_STYLE);
     if (!propList["librevenge:span-id"]) {
         // librevenge::RVNG_DEBUG_MSG(("SVGDrawingGenerator::defineCharacterStyle:
         // can not find the span-id\n"));
@@ -1229,6 +1855,8 @@ void SVGDrawingGenerator::defineCharacterStyle(
 
 void SVGDrawingGenerator::openSpan(
     const librevenge::RVNGPropertyList &propList) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::OPEN_SPAN);
     librevenge::RVNGPropertyList pList(propList);
     if (propList["librevenge:span-id"] &&
         m_pImpl->m_idSpanMap.find(propList["librevenge:span-id"]->getInt()) !=
@@ -1258,7 +1886,7 @@ void SVGDrawingGenerator::openSpan(
         textLastFontSize = pList["fo:font-size"]->getDouble();
         m_pImpl->m_outputSink
             << "font-size=\""
-            << doubleToString(pList["fo:font-size"]->getDouble()) << "\" ";
+            << FormattedDouble(pList["fo:font-size"]->getDouble()) << "\" ";
     }
     if (pList["fo:color"])
         m_pImpl->m_outputSink << "fill=\"" << pList["fo:color"]->getStr().cstr()
@@ -1270,31 +1898,40 @@ void SVGDrawingGenerator::openSpan(
     if (pList["svg:fill-opacity"])
         m_pImpl->m_outputSink
             << "fill-opacity=\""
-            << doubleToString(pList["svg:fill-opacity"]->getDouble()) << "\" ";
+            << FormattedDouble(pList["svg:fill-opacity"]->getDouble()) << "\" ";
     if (pList["svg:stroke-opacity"])
         m_pImpl->m_outputSink
             << "stroke-opacity=\""
-            << doubleToString(pList["svg:stroke-opacity"]->getDouble())
+            << FormattedDouble(pList["svg:stroke-opacity"]->getDouble())
             << "\" ";
     m_pImpl->m_outputSink << ">\n";
 }
 
 void SVGDrawingGenerator::closeSpan() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::CLOSE_SPAN);
     m_pImpl->m_outputSink << "</" << m_pImpl->getNamespaceAndDelim()
                           << "tspan>\n";
 }
 
 void SVGDrawingGenerator::openLink(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::OPEN_LINK);
 }
 void SVGDrawingGenerator::closeLink() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::CLOSE_LINK);
 }
 
 void SVGDrawingGenerator::insertText(const librevenge::RVNGString &str) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::INSERT_TEXT);
     if (textIsParagraph) {
         std::string line;
-        const char *text = librevenge::RVNGString::escapeXML(str).cstr();
-        std::stringstream in(text);
+        const librevenge::RVNGString text =
+            librevenge::RVNGString::escapeXML(str);
+        std::stringstream in(text.cstr());
         std::string SPACE = " ";
         int oldSpaceCounter = textSpaceCounter;
         for (std::string line; getline(in, line);) {
@@ -1303,11 +1940,12 @@ void SVGDrawingGenerator::insertText(const librevenge::RVNGString &str) {
                 m_pImpl->m_outputSink << "<" << m_pImpl->getNamespaceAndDelim()
                                       << "tspan ";
                 if (textNewLine)
-                    m_pImpl->m_outputSink << "x=\"" << doubleToString(textLastX)
-                                          << "\" ";
-                if (firtLineWritten && textNewLine)
                     m_pImpl->m_outputSink
-                        << "dy=\"" << doubleToString(textLastFontSize) << "\" ";
+                        << "x=\"" << FormattedDouble(textLastX) << "\" ";
+                if (firtLineWritten && textNewLine)
+                    m_pImpl->m_outputSink << "dy=\""
+                                          << FormattedDouble(textLastFontSize)
+                                          << "\" ";
                 else
                     firtLineWritten = 1;
                 m_pImpl->m_outputSink << "xml:space=\"preserve\" ";
@@ -1325,16 +1963,20 @@ void SVGDrawingGenerator::insertText(const librevenge::RVNGString &str) {
         if (textSpaceCounter <= oldSpaceCounter)
             textNewLine = 0;
     } else {
-        m_pImpl->m_outputSink << librevenge::RVNGString::escapeXML(str).cstr();
+        m_pImpl->m_outputSink.appendEscaped(str.cstr());
     }
 }
 
 void SVGDrawingGenerator::insertTab() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::INSERT_TAB);
     m_pImpl->m_outputSink << "\n<!-- [insertTab] marker -->\n";
     m_pImpl->m_outputSink << "\t";
 }
 
 void SVGDrawingGenerator::insertSpace() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::INSERT_SPACE);
     m_pImpl->m_outputSink << "\n<!-- [insertSpace] marker -->\n";
     m_pImpl->m_outputSink << " ";
     if (textIsParagraph)
@@ -1342,6 +1984,8 @@ void SVGDrawingGenerator::insertSpace() {
 }
 
 void SVGDrawingGenerator::insertLineBreak() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::INSERT_LINE_BREAK);
     m_pImpl->m_outputSink << "\n<!-- [insertLineBreak] marker -->\n";
     if (textIsParagraph)
         textNewLine = 1;
@@ -1350,44 +1994,60 @@ void SVGDrawingGenerator::insertLineBreak() {
 
 void SVGDrawingGenerator::insertField(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::INSERT_FIELD);
     m_pImpl->m_outputSink << "<!-- [insertField] not implemented -->\n";
 }
 
 void SVGDrawingGenerator::startTableObject(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::START_TABLE_OBJECT);
     m_pImpl->m_outputSink << "<!-- [startTableObject] not implemented -->\n";
     // TODO: implement me
 }
 
 void SVGDrawingGenerator::openTableRow(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::OPEN_TABLE_ROW);
     m_pImpl->m_outputSink << "<!-- [openTableRow] not implemented -->\n";
     // TODO: implement me
 }
 
 void SVGDrawingGenerator::closeTableRow() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::CLOSE_TABLE_ROW);
     m_pImpl->m_outputSink << "<!-- [closeTableRow] not implemented -->\n";
     // TODO: implement me
 }
 
 void SVGDrawingGenerator::openTableCell(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::OPEN_TABLE_CELL);
     m_pImpl->m_outputSink << "<!-- [openTableCell] not implemented -->\n";
     // TODO: implement me
 }
 
 void SVGDrawingGenerator::closeTableCell() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::CLOSE_TABLE_CELL);
     m_pImpl->m_outputSink << "<!-- [closeTableCell] not implemented -->\n";
     // TODO: implement me
 }
 
 void SVGDrawingGenerator::insertCoveredTableCell(
     const librevenge::RVNGPropertyList & /*propList*/) {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::INSERT_COVERED_TABLE_CELL);
     m_pImpl->m_outputSink << "<!-- [ConveredTableCell] not implemented -->\n";
     // TODO: implement me
 }
 
 void SVGDrawingGenerator::endTableObject() {
+    CallbackScope scope(m_pImpl->m_stats, m_pImpl->m_trace,
+                        SVGStats::END_TABLE_OBJECT);
     m_pImpl->m_outputSink << "<!-- [endTableObject] not implemented -->\n";
     // TODO: implement me
 }
@@ -0,0 +1,140 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * cache of the EMF images already converted to SVG
+ */
+
+#include <string.h>
+#include <utility>
+
+#include "SVGEMFCache.h"
+
+namespace vss2svg {
+
+namespace {
+
+inline uint64_t mix(uint64_t h, uint64_t value) {
+    h ^= value * 0x9e3779b97f4a7c15ULL;
+    h = (h << 31) | (h >> 33);
+    return h * 0xff51afd7ed558ccdULL;
+}
+
+//! word at a time hash, good enough to tell images apart
+uint64_t hashBytes(uint64_t h, const char *data, size_t size) {
+    uint64_t word;
+    for (; size >= 8; data += 8, size -= 8) {
+        memcpy(&word, data, 8);
+        h = mix(h, word);
+    }
+    word = 0;
+    memcpy(&word, data, size);
+    return mix(h, word ^ size);
+}
+
+uint64_t hashDouble(uint64_t h, double value) {
+    uint64_t word;
+    memcpy(&word, &value, sizeof(word));
+    return mix(h, word);
+}
+}
+
+SVGEMFKey::SVGEMFKey(const char *emf_, size_t size_, double width_,
+                     double height_, const std::string &nmSpace_)
+    : emf(emf_), size(size_), width(width_), height(height_),
+      nmSpace(nmSpace_), hash(0) {
+    uint64_t h = hashBytes(size, emf, size);
+    h = hashDouble(h, width);
+    h = hashDouble(h, height);
+    h = hashBytes(h, nmSpace.data(), nmSpace.size());
+    // final avalanche
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    hash = h ^ (h >> 33);
+}
+
+SVGEMFCache::SVGEMFCache(size_t budget)
+    : m_budget(budget), m_memory(0), m_hits(0), m_misses(0), m_entries(),
+      m_index(), m_mutex() {
+}
+
+bool SVGEMFCache::matches(const Entry &entry, const SVGEMFKey &key) {
+    return entry.hash == key.hash && entry.width == key.width &&
+           entry.height == key.height && entry.nmSpace == key.nmSpace &&
+           entry.emf.size() == key.size &&
+           memcmp(entry.emf.data(), key.emf, key.size) == 0;
+}
+
+size_t SVGEMFCache::footprint(const Entry &entry) {
+    return sizeof(Entry) + entry.emf.size() + entry.nmSpace.size() +
+           entry.svg->size();
+}
+
+void SVGEMFCache::erase(EntryList::iterator entry) {
+    m_memory -= footprint(*entry);
+    m_index.erase(entry->hash);
+    m_entries.erase(entry);
+}
+
+SVGEMFCache::Fragment SVGEMFCache::find(const SVGEMFKey &key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unordered_map<uint64_t, EntryList::iterator>::iterator it =
+        m_index.find(key.hash);
+    if (it == m_index.end() || !matches(*it->second, key)) {
+        m_misses++;
+        return Fragment();
+    }
+    m_hits++;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->svg;
+}
+
+void SVGEMFCache::insert(const SVGEMFKey &key, const Fragment &svg) {
+    Entry entry;
+    entry.hash = key.hash;
+    entry.emf.assign(key.emf, key.size);
+    entry.width = key.width;
+    entry.height = key.height;
+    entry.nmSpace = key.nmSpace;
+    entry.svg = svg;
+    size_t size = footprint(entry);
+    if (size > m_budget)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // either another worker converted it meanwhile, or a hash collision:
+    // keep the latest one
+    std::unordered_map<uint64_t, EntryList::iterator>::iterator it =
+        m_index.find(key.hash);
+    if (it != m_index.end())
+        erase(it->second);
+    while (!m_entries.empty() && m_memory + size > m_budget)
+        erase(--m_entries.end());
+    m_entries.push_front(std::move(entry));
+    m_index[key.hash] = m_entries.begin();
+    m_memory += size;
+}
+
+void SVGEMFCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_memory = 0;
+}
+
+unsigned long SVGEMFCache::hits() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+unsigned long SVGEMFCache::misses() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+size_t SVGEMFCache::memory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memory;
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,103 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * conversion of the EMF images, inline or on a pool of threads
+ */
+
+#include <stdlib.h>
+#include <memory>
+
+#include <emf2svg.h>
+
+#include "SVGEMFConverter.h"
+
+namespace vss2svg {
+
+SVGEMFCache::Fragment convertEMF(const char *emf, size_t size, double width,
+                                 double height, const std::string &nmSpace,
+                                 SVGEMFCache *cache, SVGStats *stats,
+                                 SVGTrace *trace) {
+    SVGScopedTimer timer(stats, SVGStats::EMF);
+    SVGTraceScope span(trace, "emf2svg", "emf");
+    char *svg_buf = NULL;
+    generatorOptions *options =
+        (generatorOptions *)calloc(1, sizeof(generatorOptions));
+    options->verbose = false;
+    options->emfplus = true;
+    options->nameSpace = (char *)nmSpace.c_str();
+    options->svgDelimiter = false;
+    options->imgWidth = width;
+    options->imgHeight = height;
+
+    emf2svg((char *)emf, size, &svg_buf, options);
+    SVGEMFCache::Fragment svg =
+        std::make_shared<const std::string>(svg_buf ? svg_buf : "");
+    if (cache && svg_buf)
+        cache->insert(SVGEMFKey(emf, size, width, height, nmSpace), svg);
+    free(svg_buf);
+    free(options);
+    return svg;
+}
+
+SVGEMFConverter::SVGEMFConverter(unsigned nbThreads)
+    : m_threads(), m_tasks(), m_stop(false), m_mutex(), m_wakeUp() {
+    for (unsigned i = 0; i < nbThreads; i++)
+        m_threads.push_back(std::thread(&SVGEMFConverter::run, this));
+}
+
+SVGEMFConverter::~SVGEMFConverter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeUp.notify_all();
+    for (size_t i = 0; i < m_threads.size(); i++)
+        m_threads[i].join();
+}
+
+std::shared_future<SVGEMFCache::Fragment>
+SVGEMFConverter::convert(const char *emf, size_t size, double width,
+                         double height, const std::string &nmSpace,
+                         SVGEMFCache *cache, SVGStats *stats,
+                         SVGTrace *trace) {
+    Task *task = new Task();
+    task->emf.assign(emf, size);
+    task->width = width;
+    task->height = height;
+    task->nmSpace = nmSpace;
+    task->cache = cache;
+    task->stats = stats;
+    task->trace = trace;
+    std::shared_future<SVGEMFCache::Fragment> result =
+        task->result.get_future().share();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(task);
+    }
+    m_wakeUp.notify_one();
+    return result;
+}
+
+void SVGEMFConverter::run() {
+    for (;;) {
+        Task *task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (m_tasks.empty() && !m_stop)
+                m_wakeUp.wait(lock);
+            // the queue is drained before stopping
+            if (m_tasks.empty())
+                return;
+            task = m_tasks.front();
+            m_tasks.pop_front();
+        }
+        task->result.set_value(convertEMF(task->emf.data(), task->emf.size(),
+                                          task->width, task->height,
+                                          task->nmSpace, task->cache,
+                                          task->stats, task->trace));
+        delete task;
+    }
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
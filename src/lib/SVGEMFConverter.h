@@ -0,0 +1,77 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * conversion of the EMF images, inline or on a pool of threads
+ */
+
+#ifndef SVGEMFCONVERTER_H
+#define SVGEMFCONVERTER_H
+
+#include <stddef.h>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SVGEMFCache.h"
+#include "SVGStats.h"
+#include "SVGTrace.h"
+
+namespace vss2svg {
+
+//! run emf2svg on size bytes of emf, storing the result in cache if any,
+//! adding the time spent to the EMF timer of stats and recording it in
+//! trace if any
+SVGEMFCache::Fragment convertEMF(const char *emf, size_t size, double width,
+                                 double height, const std::string &nmSpace,
+                                 SVGEMFCache *cache, SVGStats *stats,
+                                 SVGTrace *trace);
+
+/* Pool of threads running convertEMF in the background. The EMF bytes
+ * are copied, so the caller doesn't need to keep them. The remaining
+ * conversions are completed before the pool is destroyed. */
+class SVGEMFConverter {
+  public:
+    explicit SVGEMFConverter(unsigned nbThreads);
+    ~SVGEMFConverter();
+
+    std::shared_future<SVGEMFCache::Fragment>
+    convert(const char *emf, size_t size, double width, double height,
+            const std::string &nmSpace, SVGEMFCache *cache, SVGStats *stats,
+            SVGTrace *trace);
+
+    unsigned threads() const {
+        return (unsigned)m_threads.size();
+    }
+
+  private:
+    SVGEMFConverter(const SVGEMFConverter &);
+    SVGEMFConverter &operator=(const SVGEMFConverter &);
+
+    struct Task {
+        std::string emf;
+        double width;
+        double height;
+        std::string nmSpace;
+        SVGEMFCache *cache;
+        SVGStats *stats;
+        SVGTrace *trace;
+        std::promise<SVGEMFCache::Fragment> result;
+    };
+
+    void run();
+
+    std::vector<std::thread> m_threads;
+    std::deque<Task *> m_tasks;
+    bool m_stop;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+};
+}
+
+#endif // SVGEMFCONVERTER_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
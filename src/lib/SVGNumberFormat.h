@@ -0,0 +1,116 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * locale independent number formatting for the SVG output
+ */
+
+#ifndef SVGNUMBERFORMAT_H
+#define SVGNUMBERFORMAT_H
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <ostream>
+
+namespace vss2svg {
+
+//! maximum number of characters written by formatDouble (plus a NUL)
+static const unsigned FORMAT_DOUBLE_MAX = 32;
+
+namespace detail {
+
+static const char digitPairs[201] = "00010203040506070809"
+                                    "10111213141516171819"
+                                    "20212223242526272829"
+                                    "30313233343536373839"
+                                    "40414243444546474849"
+                                    "50515253545556575859"
+                                    "60616263646566676869"
+                                    "70717273747576777879"
+                                    "80818283848586878889"
+                                    "90919293949596979899";
+
+//! slow path, used when the fast one can't guarantee printf's rounding
+inline unsigned formatDoubleSlow(double value, char *buf) {
+    int len = snprintf(buf, FORMAT_DOUBLE_MAX, "%.4f", value);
+    if (len < 0)
+        len = 0;
+    if (len >= (int)FORMAT_DOUBLE_MAX)
+        len = FORMAT_DOUBLE_MAX - 1;
+    // don't depend on the C locale decimal separator
+    for (int i = 0; i < len; i++)
+        if (buf[i] == ',')
+            buf[i] = '.';
+    return len;
+}
+}
+
+/* Write value with 4 decimals in buf, which must hold at least
+ * FORMAT_DOUBLE_MAX characters. The output is the same as the one of
+ * RVNGDoubleProperty::getStr(), that is "%.4f" in the C locale with the
+ * values rounding to zero written "0.0000", but nothing is allocated.
+ * Returns the number of characters written, buf is not NUL terminated. */
+inline unsigned formatDouble(double value, char *buf) {
+    if (value < 0.0001 && value > -0.0001) {
+        memcpy(buf, "0.0000", 6);
+        return 6;
+    }
+    // past 1e11 the scaled value loses the precision needed to round
+    // like printf; nan and inf fail the comparison too
+    if (!(value < 1e11 && value > -1e11))
+        return detail::formatDoubleSlow(value, buf);
+
+    double scaled = value * 10000.0;
+    double integral = floor(scaled);
+    double frac = scaled - integral;
+    // too close to a tie for the product rounding to be trusted
+    if (fabs(frac - 0.5) <= fabs(scaled) * 1e-15)
+        return detail::formatDoubleSlow(value, buf);
+    unsigned long long n =
+        (unsigned long long)fabs(frac < 0.5 ? integral : integral + 1.0);
+
+    // digits are generated backwards in a scratch area, then copied
+    char tmp[FORMAT_DOUBLE_MAX];
+    char *end = tmp + sizeof(tmp);
+    char *p = end;
+    unsigned fraction = (unsigned)(n % 10000);
+    unsigned long long whole = n / 10000;
+    p -= 2;
+    memcpy(p, detail::digitPairs + 2 * (fraction % 100), 2);
+    p -= 2;
+    memcpy(p, detail::digitPairs + 2 * (fraction / 100), 2);
+    *--p = '.';
+    while (whole >= 100) {
+        p -= 2;
+        memcpy(p, detail::digitPairs + 2 * (whole % 100), 2);
+        whole /= 100;
+    }
+    if (whole >= 10) {
+        p -= 2;
+        memcpy(p, detail::digitPairs + 2 * whole, 2);
+    } else
+        *--p = char('0' + whole);
+    if (value < 0)
+        *--p = '-';
+
+    unsigned len = (unsigned)(end - p);
+    memcpy(buf, p, len);
+    return len;
+}
+
+//! a formatted double living on the stack, to be streamed in the output
+struct FormattedDouble {
+    explicit FormattedDouble(double value) : len(formatDouble(value, buf)) {
+    }
+    char buf[FORMAT_DOUBLE_MAX];
+    unsigned len;
+};
+
+inline std::ostream &operator<<(std::ostream &os, const FormattedDouble &d) {
+    return os.write(d.buf, d.len);
+}
+}
+
+#endif // SVGNUMBERFORMAT_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,215 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * append only output buffer used to build the SVG pages
+ */
+
+#include <stdio.h>
+#include <algorithm>
+
+#include "SVGBinaryData.h"
+#include "SVGOutputBuffer.h"
+
+namespace vss2svg {
+
+SVGOutputBuffer::SVGOutputBuffer(size_t blockSize)
+    : m_blockSize(blockSize), m_blocks(), m_current(0), m_cur(NULL),
+      m_end(NULL), m_slots(), m_chunks() {
+    m_blocks.push_back(new char[m_blockSize]);
+    m_cur = m_blocks[0];
+    m_end = m_cur + m_blockSize;
+}
+
+SVGOutputBuffer::~SVGOutputBuffer() {
+    for (size_t i = 0; i < m_blocks.size(); i++)
+        delete[] m_blocks[i];
+}
+
+void SVGOutputBuffer::nextBlock() {
+    if (++m_current == m_blocks.size())
+        m_blocks.push_back(new char[m_blockSize]);
+    m_cur = m_blocks[m_current];
+    m_end = m_cur + m_blockSize;
+}
+
+void SVGOutputBuffer::appendSlow(const char *data, size_t size) {
+    while (size) {
+        if (m_cur == m_end)
+            nextBlock();
+        size_t len = (size_t)(m_end - m_cur);
+        if (len > size)
+            len = size;
+        memcpy(m_cur, data, len);
+        m_cur += len;
+        data += len;
+        size -= len;
+    }
+}
+
+void SVGOutputBuffer::appendEscaped(const char *str) {
+    const char *start = str;
+    for (; *str; ++str) {
+        const char *entity;
+        switch (*str) {
+        case '&':
+            entity = "&amp;";
+            break;
+        case '<':
+            entity = "&lt;";
+            break;
+        case '>':
+            entity = "&gt;";
+            break;
+        case '\'':
+            entity = "&apos;";
+            break;
+        case '"':
+            entity = "&quot;";
+            break;
+        default:
+            continue;
+        }
+        append(start, (size_t)(str - start));
+        append(entity, strlen(entity));
+        start = str + 1;
+    }
+    append(start, (size_t)(str - start));
+}
+
+void SVGOutputBuffer::appendInt(long value) {
+    char buf[24];
+    char *end = buf + sizeof(buf);
+    char *p = end;
+    unsigned long n = value < 0 ? 0UL - (unsigned long)value : value;
+    do {
+        *--p = char('0' + n % 10);
+        n /= 10;
+    } while (n);
+    if (value < 0)
+        *--p = '-';
+    append(p, (size_t)(end - p));
+}
+
+void SVGOutputBuffer::appendBase64(const unsigned char *data, size_t size) {
+    // encode whole groups straight in the blocks, the padded tail (and
+    // the groups straddling two blocks) go through a small buffer
+    while (size >= 3) {
+        size_t groups = (size_t)(m_end - m_cur) / 4;
+        if (groups > size / 3)
+            groups = size / 3;
+        if (!groups) {
+            char buf[4];
+            encodeBase64(data, 3, buf);
+            append(buf, 4);
+            data += 3;
+            size -= 3;
+            continue;
+        }
+        encodeBase64(data, 3 * groups, m_cur);
+        m_cur += 4 * groups;
+        data += 3 * groups;
+        size -= 3 * groups;
+    }
+    if (size) {
+        char buf[4];
+        encodeBase64(data, size, buf);
+        append(buf, 4);
+    }
+}
+
+SVGOutputBuffer &SVGOutputBuffer::operator<<(double value) {
+    char buf[FORMAT_DOUBLE_MAX];
+    int len = snprintf(buf, sizeof(buf), "%g", value);
+    if (len < 0)
+        len = 0;
+    if (len >= (int)sizeof(buf))
+        len = sizeof(buf) - 1;
+    for (int i = 0; i < len; i++)
+        if (buf[i] == ',')
+            buf[i] = '.';
+    append(buf, len);
+    return *this;
+}
+
+size_t SVGOutputBuffer::addSlot() {
+    Slot slot;
+    slot.block = m_current;
+    slot.offset = (size_t)(m_cur - m_blocks[m_current]);
+    slot.data = NULL;
+    slot.size = 0;
+    m_slots.push_back(slot);
+    return m_slots.size() - 1;
+}
+
+void SVGOutputBuffer::fillSlot(size_t slot, const char *data, size_t size) {
+    m_slots[slot].data = data;
+    m_slots[slot].size = size;
+}
+
+void SVGOutputBuffer::swap(SVGOutputBuffer &other) {
+    std::swap(m_blockSize, other.m_blockSize);
+    m_blocks.swap(other.m_blocks);
+    std::swap(m_current, other.m_current);
+    std::swap(m_cur, other.m_cur);
+    std::swap(m_end, other.m_end);
+    m_slots.swap(other.m_slots);
+}
+
+void SVGOutputBuffer::clear() {
+    m_current = 0;
+    m_cur = m_blocks[0];
+    m_end = m_cur + m_blockSize;
+    m_slots.clear();
+}
+
+size_t SVGOutputBuffer::size() const {
+    size_t size =
+        m_current * m_blockSize + (size_t)(m_cur - m_blocks[m_current]);
+    for (size_t i = 0; i < m_slots.size(); i++)
+        size += m_slots[i].size;
+    return size;
+}
+
+namespace {
+
+inline void addChunk(std::vector<struct iovec> &chunks, const char *data,
+                     size_t size) {
+    if (!size)
+        return;
+    struct iovec chunk;
+    chunk.iov_base = (void *)data;
+    chunk.iov_len = size;
+    chunks.push_back(chunk);
+}
+}
+
+const std::vector<struct iovec> &SVGOutputBuffer::chunks() const {
+    m_chunks.clear();
+    size_t slot = 0;
+    for (size_t i = 0; i <= m_current; i++) {
+        size_t used =
+            i < m_current ? m_blockSize : (size_t)(m_cur - m_blocks[i]);
+        size_t start = 0;
+        // the slots are in order, split the block around each of them
+        for (; slot < m_slots.size() && m_slots[slot].block == i; slot++) {
+            addChunk(m_chunks, m_blocks[i] + start,
+                     m_slots[slot].offset - start);
+            addChunk(m_chunks, m_slots[slot].data, m_slots[slot].size);
+            start = m_slots[slot].offset;
+        }
+        addChunk(m_chunks, m_blocks[i] + start, used - start);
+    }
+    return m_chunks;
+}
+
+std::string SVGOutputBuffer::str() const {
+    std::string result;
+    result.reserve(size());
+    const std::vector<struct iovec> &content = chunks();
+    for (size_t i = 0; i < content.size(); i++)
+        result.append((const char *)content[i].iov_base, content[i].iov_len);
+    return result;
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,136 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * append only output buffer used to build the SVG pages
+ */
+
+#ifndef SVGOUTPUTBUFFER_H
+#define SVGOUTPUTBUFFER_H
+
+#include <stddef.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <string>
+#include <vector>
+
+#include "SVGNumberFormat.h"
+
+namespace vss2svg {
+
+/* Chunked arena of byte blocks the pages are written in.
+ * Appending never moves what was already written, clear() keeps the
+ * blocks for the next page, and the content is handed out as a list of
+ * iovec (one per used block) which can be given to writev as is.
+ * Slots reserve a place for content only known later (the conversion of
+ * an image running in another thread), which is spliced in by chunks()
+ * without moving anything. */
+class SVGOutputBuffer {
+  public:
+    explicit SVGOutputBuffer(size_t blockSize = 64 * 1024);
+    ~SVGOutputBuffer();
+
+    void append(const char *data, size_t size) {
+        if (size <= (size_t)(m_end - m_cur)) {
+            memcpy(m_cur, data, size);
+            m_cur += size;
+        } else
+            appendSlow(data, size);
+    }
+    void append(char c) {
+        if (m_cur == m_end)
+            nextBlock();
+        *m_cur++ = c;
+    }
+    //! append str with the XML special characters escaped
+    void appendEscaped(const char *str);
+    //! append value formatted like RVNGDoubleProperty::getStr()
+    void appendDouble(double value) {
+        char buf[FORMAT_DOUBLE_MAX];
+        append(buf, formatDouble(value, buf));
+    }
+    void appendInt(long value);
+    //! append the base64 encoding of size bytes of data
+    void appendBase64(const unsigned char *data, size_t size);
+
+    //! reserve a slot at the current position, returns its id
+    size_t addSlot();
+    //! give the content of slot, which is not copied and must stay valid
+    //! until the buffer is cleared; a slot never filled is left empty
+    void fillSlot(size_t slot, const char *data, size_t size);
+    //! exchange the content (and the blocks) of two buffers
+    void swap(SVGOutputBuffer &other);
+
+    //! drop the content and the slots, keeping the blocks allocated
+    void clear();
+    //! number of bytes written since the last clear
+    size_t size() const;
+    //! the content, as a list of chunks in order
+    const std::vector<struct iovec> &chunks() const;
+    //! copy the content in one string, for the callers that need it
+    std::string str() const;
+
+    SVGOutputBuffer &operator<<(const char *str) {
+        append(str, strlen(str));
+        return *this;
+    }
+    SVGOutputBuffer &operator<<(const std::string &str) {
+        append(str.data(), str.size());
+        return *this;
+    }
+    SVGOutputBuffer &operator<<(char c) {
+        append(c);
+        return *this;
+    }
+    SVGOutputBuffer &operator<<(int value) {
+        appendInt(value);
+        return *this;
+    }
+    SVGOutputBuffer &operator<<(unsigned value) {
+        appendInt(value);
+        return *this;
+    }
+    SVGOutputBuffer &operator<<(long value) {
+        appendInt(value);
+        return *this;
+    }
+    SVGOutputBuffer &operator<<(unsigned long value) {
+        appendInt((long)value);
+        return *this;
+    }
+    //! same output as std::ostream: "%g"
+    SVGOutputBuffer &operator<<(double value);
+    SVGOutputBuffer &operator<<(const FormattedDouble &value) {
+        append(value.buf, value.len);
+        return *this;
+    }
+
+  private:
+    SVGOutputBuffer(const SVGOutputBuffer &);
+    SVGOutputBuffer &operator=(const SVGOutputBuffer &);
+
+    void appendSlow(const char *data, size_t size);
+    //! make the next block (allocating it if needed) the current one
+    void nextBlock();
+
+    struct Slot {
+        //! where the slot is, the offset can be the size of the block
+        size_t block;
+        size_t offset;
+        const char *data;
+        size_t size;
+    };
+
+    size_t m_blockSize;
+    std::vector<char *> m_blocks;
+    //! index of the block being written
+    size_t m_current;
+    char *m_cur;
+    char *m_end;
+    std::vector<Slot> m_slots;
+    mutable std::vector<struct iovec> m_chunks;
+};
+}
+
+#endif // SVGOUTPUTBUFFER_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,70 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * page sinks receiving the SVG pages produced by SVGDrawingGenerator
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "SVGPageSink.h"
+
+namespace vss2svg {
+
+SVGFilePageSink::SVGFilePageSink(const std::string &dir)
+    : m_dir(dir), m_pageCount(0), m_good(true) {
+}
+
+void SVGFilePageSink::reset(const std::string &dir) {
+    m_dir = dir;
+    m_pageCount = 0;
+    m_good = true;
+}
+
+void SVGFilePageSink::writePage(const struct iovec *chunks, size_t count) {
+    std::string filename =
+        m_dir + "/image-" + std::to_string(m_pageCount++) + ".svg";
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0) {
+        m_good = false;
+        return;
+    }
+    // writev may write less than asked, continue from where it stopped
+    std::vector<struct iovec> pending(chunks, chunks + count);
+    // the files end with an empty line, as when they were written with
+    // std::endl after the page
+    static char newline[] = "\n";
+    struct iovec end = {newline, 1};
+    pending.push_back(end);
+    size_t first = 0;
+    while (first < pending.size()) {
+        size_t nb = pending.size() - first;
+        if (nb > IOV_MAX)
+            nb = IOV_MAX;
+        ssize_t written = writev(fd, &pending[first], (int)nb);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            m_good = false;
+            break;
+        }
+        while (first < pending.size() &&
+               (size_t)written >= pending[first].iov_len) {
+            written -= pending[first].iov_len;
+            first++;
+        }
+        if (written > 0) {
+            pending[first].iov_base = (char *)pending[first].iov_base + written;
+            pending[first].iov_len -= written;
+        }
+    }
+    if (close(fd) != 0)
+        m_good = false;
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,86 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * simplification of the polylines written in the SVG output
+ */
+
+#include "SVGSimplifier.h"
+
+namespace vss2svg {
+
+namespace {
+
+//! squared distance from (px, py) to the segment from a to b
+double segmentDistance2(const double *a, const double *b, double px,
+                        double py) {
+    double dx = b[0] - a[0], dy = b[1] - a[1];
+    px -= a[0];
+    py -= a[1];
+    double length2 = dx * dx + dy * dy;
+    // the distance to the segment rather than to the line, which would
+    // drop the points going back past its ends
+    double t = length2 > 0 ? (px * dx + py * dy) / length2 : 0;
+    if (t < 0)
+        t = 0;
+    else if (t > 1)
+        t = 1;
+    double ex = px - t * dx, ey = py - t * dy;
+    return ex * ex + ey * ey;
+}
+}
+
+size_t SVGSimplifier::simplify(double *points, size_t count) {
+    if (!enabled() || count < 2)
+        return count;
+
+    if (count > 2) {
+        const double tolerance2 = m_tolerance * m_tolerance;
+        m_keep.assign(count, 0);
+        m_keep[0] = m_keep[count - 1] = 1;
+        m_stack.clear();
+        m_stack.push_back(std::make_pair((size_t)0, count - 1));
+        while (!m_stack.empty()) {
+            size_t first = m_stack.back().first;
+            size_t last = m_stack.back().second;
+            m_stack.pop_back();
+            if (last - first < 2)
+                continue;
+            const double *a = points + 2 * first;
+            const double *b = points + 2 * last;
+            double farthest2 = -1;
+            size_t farthest = first;
+            for (size_t i = first + 1; i < last; i++) {
+                double d2 = segmentDistance2(a, b, points[2 * i],
+                                             points[2 * i + 1]);
+                if (d2 > farthest2) {
+                    farthest2 = d2;
+                    farthest = i;
+                }
+            }
+            if (farthest2 <= tolerance2)
+                continue;
+            m_keep[farthest] = 1;
+            m_stack.push_back(std::make_pair(first, farthest));
+            m_stack.push_back(std::make_pair(farthest, last));
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (!m_keep[i])
+                continue;
+            points[2 * kept] = points[2 * i];
+            points[2 * kept + 1] = points[2 * i + 1];
+            kept++;
+        }
+        count = kept;
+    }
+
+    // a last segment of length zero
+    if (points[2 * count - 2] == points[2 * count - 4] &&
+        points[2 * count - 1] == points[2 * count - 3])
+        count--;
+    return count;
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
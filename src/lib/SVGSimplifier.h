@@ -0,0 +1,56 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * simplification of the polylines written in the SVG output
+ */
+
+#ifndef SVGSIMPLIFIER_H
+#define SVGSIMPLIFIER_H
+
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+namespace vss2svg {
+
+/* Douglas-Peucker simplification of polylines given as arrays of x y
+ * pairs: a point is dropped when it is at most the tolerance away from
+ * the simplified polyline, which removes the collinear and the repeated
+ * points. The tolerance is in the units of the points; 0, the default,
+ * disables the simplification. The working memory is kept between
+ * calls. */
+class SVGSimplifier {
+  public:
+    SVGSimplifier() : m_tolerance(0), m_keep(), m_stack() {
+    }
+
+    void setTolerance(double tolerance) {
+        m_tolerance = tolerance;
+    }
+    double tolerance() const {
+        return m_tolerance;
+    }
+    bool enabled() const {
+        return m_tolerance > 0;
+    }
+
+    /* Simplify the count points of points, keeping the first and the last
+     * ones, then drop the last point if it repeats the one before. The
+     * points kept are moved to the front, in order; returns their
+     * number. */
+    size_t simplify(double *points, size_t count);
+
+  private:
+    SVGSimplifier(const SVGSimplifier &);
+    SVGSimplifier &operator=(const SVGSimplifier &);
+
+    double m_tolerance;
+    std::vector<unsigned char> m_keep;
+    //! ranges of points left to simplify
+    std::vector<std::pair<size_t, size_t>> m_stack;
+};
+}
+
+#endif // SVGSIMPLIFIER_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
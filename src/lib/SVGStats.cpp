@@ -0,0 +1,276 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * timers and counters of the phases of a conversion
+ */
+
+#include <chrono>
+#include <iomanip>
+
+#include "SVGStats.h"
+
+namespace vss2svg {
+
+namespace {
+
+#define SVG_STATS_NAME(id, name) #name,
+const char *const callbackNames[] = {SVG_STATS_CALLBACKS(SVG_STATS_NAME)};
+#undef SVG_STATS_NAME
+
+const char *const counterNames[] = {
+    "pages",       "bytes_emitted",   "emf_images",  "emf_cache_hits",
+    "sub_streams", "bytes_extracted", "nurbs_points", "points_dropped"};
+
+//! the phases reported, derived from the timers
+enum Phase {
+    PHASE_TOTAL,
+    PHASE_EXTRACTION,
+    PHASE_DECOMPRESSION,
+    PHASE_PARSING,
+    PHASE_STYLES_PASS,
+    PHASE_CONTENT_PASS,
+    PHASE_DRAWING,
+    PHASE_SVG_EMISSION,
+    PHASE_EMF2SVG,
+    PHASE_COUNT
+};
+
+const char *const phaseNames[] = {
+    "total",        "extraction",   "decompression",
+    "parsing",      "styles_pass",  "content_pass",
+    "drawing",      "svg_emission", "emf2svg"};
+
+uint64_t minus(uint64_t a, uint64_t b) {
+    return a > b ? a - b : 0;
+}
+
+void getPhases(const SVGStats &stats, uint64_t *phases) {
+    uint64_t total = stats.time(SVGStats::CONVERSION);
+    uint64_t extraction = stats.time(SVGStats::EXTRACTION);
+    uint64_t parsing = stats.time(SVGStats::PARSING);
+    uint64_t callbacks = stats.time(SVGStats::CALLBACKS);
+    phases[PHASE_TOTAL] = total;
+    phases[PHASE_EXTRACTION] = extraction;
+    phases[PHASE_DECOMPRESSION] = stats.time(SVGStats::DECOMPRESSION);
+    phases[PHASE_PARSING] = parsing;
+    phases[PHASE_STYLES_PASS] = stats.time(SVGStats::STYLES);
+    phases[PHASE_CONTENT_PASS] = stats.time(SVGStats::CONTENT);
+    // what remains is spent by libvisio drawing the collected pages
+    phases[PHASE_DRAWING] = minus(total, extraction + parsing + callbacks);
+    phases[PHASE_SVG_EMISSION] =
+        minus(callbacks, stats.time(SVGStats::EMF_INLINE));
+    phases[PHASE_EMF2SVG] = stats.time(SVGStats::EMF);
+}
+
+double toMs(uint64_t ns) {
+    return (double)ns / 1e6;
+}
+}
+
+SVGStats::SVGStats() : m_begin(0), m_called(false) {
+    reset();
+}
+
+void SVGStats::beginConversion() {
+    m_called = false;
+    m_begin = now();
+}
+
+void SVGStats::endConversion() {
+    if (!m_begin)
+        return;
+    addTime(CONVERSION, now() - m_begin);
+    m_begin = 0;
+}
+
+void SVGStats::addCall(Callback callback, uint64_t ns) {
+    // libvisio parses the whole document before it calls the generator
+    if (m_begin && !m_called.exchange(true, std::memory_order_relaxed))
+        addTime(PARSING,
+                minus(now() - ns - m_begin, time(EXTRACTION)));
+    m_calls[callback].fetch_add(1, std::memory_order_relaxed);
+    m_callTimes[callback].fetch_add(ns, std::memory_order_relaxed);
+    addTime(CALLBACKS, ns);
+}
+
+void SVGStats::reset() {
+    for (unsigned i = 0; i < CALLBACK_COUNT; i++) {
+        m_calls[i] = 0;
+        m_callTimes[i] = 0;
+    }
+    for (unsigned i = 0; i < COUNTER_COUNT; i++)
+        m_counters[i] = 0;
+    for (unsigned i = 0; i < TIMER_COUNT; i++)
+        m_timers[i] = 0;
+    m_begin = 0;
+    m_called = false;
+}
+
+void SVGStats::merge(const SVGStats &other) {
+    for (unsigned i = 0; i < CALLBACK_COUNT; i++) {
+        m_calls[i] += other.m_calls[i].load(std::memory_order_relaxed);
+        m_callTimes[i] += other.m_callTimes[i].load(std::memory_order_relaxed);
+    }
+    for (unsigned i = 0; i < COUNTER_COUNT; i++)
+        m_counters[i] += other.m_counters[i].load(std::memory_order_relaxed);
+    for (unsigned i = 0; i < TIMER_COUNT; i++)
+        m_timers[i] += other.m_timers[i].load(std::memory_order_relaxed);
+}
+
+void SVGStats::write(std::ostream &os) const {
+    uint64_t phases[PHASE_COUNT];
+    getPhases(*this, phases);
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    os << "phases (ms):\n";
+    for (unsigned i = 0; i < PHASE_COUNT; i++)
+        os << "  " << std::left << std::setw(26) << phaseNames[i]
+           << std::right << std::setw(12) << toMs(phases[i]) << "\n";
+    os << "counters:\n";
+    for (unsigned i = 0; i < COUNTER_COUNT; i++)
+        os << "  " << std::left << std::setw(26) << counterNames[i]
+           << std::right << std::setw(12) << value(Counter(i)) << "\n";
+    os << "callbacks (calls, ms):\n";
+    for (unsigned i = 0; i < CALLBACK_COUNT; i++) {
+        if (!calls(Callback(i)))
+            continue;
+        os << "  " << std::left << std::setw(26) << callbackNames[i]
+           << std::right << std::setw(12) << calls(Callback(i))
+           << std::setw(12)
+           << toMs(m_callTimes[i].load(std::memory_order_relaxed)) << "\n";
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void SVGStats::writeJSON(std::ostream &os) const {
+    uint64_t phases[PHASE_COUNT];
+    getPhases(*this, phases);
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    os << "{\n  \"phases_ms\": {";
+    for (unsigned i = 0; i < PHASE_COUNT; i++)
+        os << (i ? ", " : "") << "\"" << phaseNames[i]
+           << "\": " << toMs(phases[i]);
+    os << "},\n  \"counters\": {";
+    for (unsigned i = 0; i < COUNTER_COUNT; i++)
+        os << (i ? ", " : "") << "\"" << counterNames[i]
+           << "\": " << value(Counter(i));
+    os << "},\n  \"callbacks\": {";
+    bool first = true;
+    for (unsigned i = 0; i < CALLBACK_COUNT; i++) {
+        if (!calls(Callback(i)))
+            continue;
+        os << (first ? "\n" : ",\n") << "    \"" << callbackNames[i]
+           << "\": {\"calls\": " << calls(Callback(i)) << ", \"ms\": "
+           << toMs(m_callTimes[i].load(std::memory_order_relaxed)) << "}";
+        first = false;
+    }
+    os << (first ? "}" : "\n  }") << "\n}\n";
+    os.flags(flags);
+    os.precision(precision);
+}
+
+const char *SVGStats::callbackName(Callback callback) {
+    return callback < CALLBACK_COUNT ? callbackNames[callback] : "";
+}
+
+uint64_t SVGStats::now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+SVGStatsInputStream::SVGStatsInputStream(librevenge::RVNGInputStream *input,
+                                         SVGStats &stats)
+    : m_input(input), m_stats(stats), m_own(false) {
+}
+
+SVGStatsInputStream::~SVGStatsInputStream() {
+    if (m_own)
+        delete m_input;
+}
+
+librevenge::RVNGInputStream *
+SVGStatsInputStream::wrap(librevenge::RVNGInputStream *stream) {
+    if (!stream)
+        return NULL;
+    m_stats.add(SVGStats::SUB_STREAMS);
+    SVGStatsInputStream *wrapped = new SVGStatsInputStream(stream, m_stats);
+    wrapped->m_own = true;
+    return wrapped;
+}
+
+bool SVGStatsInputStream::isStructured() {
+    // the directory of the container is read by the first call
+    SVGScopedTimer timer(&m_stats, SVGStats::EXTRACTION);
+    return m_input->isStructured();
+}
+
+unsigned SVGStatsInputStream::subStreamCount() {
+    SVGScopedTimer timer(&m_stats, SVGStats::EXTRACTION);
+    return m_input->subStreamCount();
+}
+
+const char *SVGStatsInputStream::subStreamName(unsigned id) {
+    return m_input->subStreamName(id);
+}
+
+bool SVGStatsInputStream::existsSubStream(const char *name) {
+    SVGScopedTimer timer(&m_stats, SVGStats::EXTRACTION);
+    return m_input->existsSubStream(name);
+}
+
+librevenge::RVNGInputStream *
+SVGStatsInputStream::getSubStreamByName(const char *name) {
+    librevenge::RVNGInputStream *stream;
+    {
+        SVGScopedTimer timer(&m_stats, SVGStats::EXTRACTION);
+        stream = m_input->getSubStreamByName(name);
+    }
+    return wrap(stream);
+}
+
+librevenge::RVNGInputStream *
+SVGStatsInputStream::getSubStreamById(unsigned id) {
+    librevenge::RVNGInputStream *stream;
+    {
+        SVGScopedTimer timer(&m_stats, SVGStats::EXTRACTION);
+        stream = m_input->getSubStreamById(id);
+    }
+    return wrap(stream);
+}
+
+const unsigned char *SVGStatsInputStream::read(unsigned long numBytes,
+                                               unsigned long &numBytesRead) {
+    // only the sub-streams are extracted, the input itself is just read
+    if (!m_own)
+        return m_input->read(numBytes, numBytesRead);
+    const unsigned char *data;
+    {
+        SVGScopedTimer timer(&m_stats, SVGStats::EXTRACTION);
+        data = m_input->read(numBytes, numBytesRead);
+    }
+    m_stats.add(SVGStats::BYTES_EXTRACTED, numBytesRead);
+    return data;
+}
+
+int SVGStatsInputStream::seek(long offset,
+                              librevenge::RVNG_SEEK_TYPE seekType) {
+    // seeking back in a compressed sub-stream inflates it again
+    SVGScopedTimer timer(m_own ? &m_stats : NULL, SVGStats::EXTRACTION);
+    return m_input->seek(offset, seekType);
+}
+
+long SVGStatsInputStream::tell() {
+    return m_input->tell();
+}
+
+bool SVGStatsInputStream::isEnd() {
+    return m_input->isEnd();
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,159 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * property lists decoded once for the style and geometry emitters
+ */
+
+#include <string.h>
+
+#include "SVGStyle.h"
+
+namespace vss2svg {
+
+namespace {
+
+struct KeyName {
+    const char *name;
+    SVGKey key;
+};
+
+// sorted by name for the binary search
+static const KeyName keyNames[] = {
+    {"draw:angle", KEY_DRAW_ANGLE},
+    {"draw:border", KEY_DRAW_BORDER},
+    {"draw:cx", KEY_DRAW_CX},
+    {"draw:cy", KEY_DRAW_CY},
+    {"draw:distance", KEY_DRAW_DISTANCE},
+    {"draw:dots1", KEY_DRAW_DOTS1},
+    {"draw:dots1-length", KEY_DRAW_DOTS1_LENGTH},
+    {"draw:dots2", KEY_DRAW_DOTS2},
+    {"draw:dots2-length", KEY_DRAW_DOTS2_LENGTH},
+    {"draw:end-color", KEY_DRAW_END_COLOR},
+    {"draw:fill", KEY_DRAW_FILL},
+    {"draw:fill-color", KEY_DRAW_FILL_COLOR},
+    {"draw:fill-image", KEY_DRAW_FILL_IMAGE},
+    {"draw:marker-end-path", KEY_DRAW_MARKER_END_PATH},
+    {"draw:marker-start-path", KEY_DRAW_MARKER_START_PATH},
+    {"draw:opacity", KEY_DRAW_OPACITY},
+    {"draw:shadow", KEY_DRAW_SHADOW},
+    {"draw:shadow-color", KEY_DRAW_SHADOW_COLOR},
+    {"draw:shadow-offset-x", KEY_DRAW_SHADOW_OFFSET_X},
+    {"draw:shadow-offset-y", KEY_DRAW_SHADOW_OFFSET_Y},
+    {"draw:shadow-opacity", KEY_DRAW_SHADOW_OPACITY},
+    {"draw:start-color", KEY_DRAW_START_COLOR},
+    {"draw:stroke", KEY_DRAW_STROKE},
+    {"draw:style", KEY_DRAW_STYLE},
+    {"librevenge:end-opacity", KEY_LIBREVENGE_END_OPACITY},
+    {"librevenge:large-arc", KEY_LIBREVENGE_LARGE_ARC},
+    {"librevenge:mime-type", KEY_LIBREVENGE_MIME_TYPE},
+    {"librevenge:path-action", KEY_LIBREVENGE_PATH_ACTION},
+    {"librevenge:rotate", KEY_LIBREVENGE_ROTATE},
+    {"librevenge:start-opacity", KEY_LIBREVENGE_START_OPACITY},
+    {"librevenge:sweep", KEY_LIBREVENGE_SWEEP},
+    {"svg:cx", KEY_SVG_CX},
+    {"svg:cy", KEY_SVG_CY},
+    {"svg:fill-rule", KEY_SVG_FILL_RULE},
+    {"svg:height", KEY_SVG_HEIGHT},
+    {"svg:offset", KEY_SVG_OFFSET},
+    {"svg:r", KEY_SVG_R},
+    {"svg:rx", KEY_SVG_RX},
+    {"svg:ry", KEY_SVG_RY},
+    {"svg:stop-color", KEY_SVG_STOP_COLOR},
+    {"svg:stop-opacity", KEY_SVG_STOP_OPACITY},
+    {"svg:stroke-color", KEY_SVG_STROKE_COLOR},
+    {"svg:stroke-linecap", KEY_SVG_STROKE_LINECAP},
+    {"svg:stroke-linejoin", KEY_SVG_STROKE_LINEJOIN},
+    {"svg:stroke-opacity", KEY_SVG_STROKE_OPACITY},
+    {"svg:stroke-width", KEY_SVG_STROKE_WIDTH},
+    {"svg:width", KEY_SVG_WIDTH},
+    {"svg:x", KEY_SVG_X},
+    {"svg:x1", KEY_SVG_X1},
+    {"svg:x2", KEY_SVG_X2},
+    {"svg:y", KEY_SVG_Y},
+    {"svg:y1", KEY_SVG_Y1},
+    {"svg:y2", KEY_SVG_Y2},
+};
+
+} // anonymous namespace
+
+SVGKey svgKey(const char *name) {
+    size_t low = 0, high = KEY_COUNT;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        int cmp = strcmp(name, keyNames[mid].name);
+        if (cmp == 0)
+            return keyNames[mid].key;
+        if (cmp < 0)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+    return KEY_COUNT;
+}
+
+void SVGProperties::clear() {
+    for (unsigned i = 0; i < KEY_COUNT; i++)
+        m_props[i] = NULL;
+}
+
+void SVGProperties::resolve(const librevenge::RVNGPropertyList &list) {
+    clear();
+    librevenge::RVNGPropertyList::Iter i(list);
+    for (i.rewind(); i.next();) {
+        SVGKey key = svgKey(i.key());
+        if (key != KEY_COUNT)
+            m_props[key] = i();
+    }
+}
+
+void SVGStyle::decode(const librevenge::RVNGPropertyList &list) {
+    resolve(list);
+
+    fill = FILL_UNSET;
+    if ((*this)[KEY_DRAW_FILL]) {
+        librevenge::RVNGString str = (*this)[KEY_DRAW_FILL]->getStr();
+        if (str == "none")
+            fill = FILL_NONE;
+        else if (str == "solid")
+            fill = FILL_SOLID;
+        else if (str == "gradient")
+            fill = FILL_GRADIENT;
+        else if (str == "bitmap")
+            fill = FILL_BITMAP;
+        else
+            fill = FILL_OTHER;
+    }
+
+    stroke = STROKE_UNSET;
+    if ((*this)[KEY_DRAW_STROKE]) {
+        librevenge::RVNGString str = (*this)[KEY_DRAW_STROKE]->getStr();
+        if (str == "none")
+            stroke = STROKE_NONE;
+        else if (str == "solid")
+            stroke = STROKE_SOLID;
+        else if (str == "dash")
+            stroke = STROKE_DASH;
+        else
+            stroke = STROKE_OTHER;
+    }
+
+    gradient = GRADIENT_UNSET;
+    if ((*this)[KEY_DRAW_STYLE]) {
+        librevenge::RVNGString str = (*this)[KEY_DRAW_STYLE]->getStr();
+        if (str == "linear")
+            gradient = GRADIENT_LINEAR;
+        else if (str == "axial")
+            gradient = GRADIENT_AXIAL;
+        else if (str == "radial" || str == "rectangular" || str == "square" ||
+                 str == "ellipsoid")
+            gradient = GRADIENT_RADIAL;
+        else
+            gradient = GRADIENT_OTHER;
+    }
+
+    shadow = (*this)[KEY_DRAW_SHADOW] &&
+             (*this)[KEY_DRAW_SHADOW]->getStr() == "visible";
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
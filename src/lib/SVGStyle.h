@@ -0,0 +1,134 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * property lists decoded once for the style and geometry emitters
+ */
+
+#ifndef SVGSTYLE_H
+#define SVGSTYLE_H
+
+#include <librevenge/librevenge.h>
+
+namespace vss2svg {
+
+//! the property names read by the generator, interned
+enum SVGKey {
+    KEY_DRAW_ANGLE,
+    KEY_DRAW_BORDER,
+    KEY_DRAW_CX,
+    KEY_DRAW_CY,
+    KEY_DRAW_DISTANCE,
+    KEY_DRAW_DOTS1,
+    KEY_DRAW_DOTS1_LENGTH,
+    KEY_DRAW_DOTS2,
+    KEY_DRAW_DOTS2_LENGTH,
+    KEY_DRAW_END_COLOR,
+    KEY_DRAW_FILL,
+    KEY_DRAW_FILL_COLOR,
+    KEY_DRAW_FILL_IMAGE,
+    KEY_DRAW_MARKER_END_PATH,
+    KEY_DRAW_MARKER_START_PATH,
+    KEY_DRAW_OPACITY,
+    KEY_DRAW_SHADOW,
+    KEY_DRAW_SHADOW_COLOR,
+    KEY_DRAW_SHADOW_OFFSET_X,
+    KEY_DRAW_SHADOW_OFFSET_Y,
+    KEY_DRAW_SHADOW_OPACITY,
+    KEY_DRAW_START_COLOR,
+    KEY_DRAW_STROKE,
+    KEY_DRAW_STYLE,
+    KEY_LIBREVENGE_END_OPACITY,
+    KEY_LIBREVENGE_LARGE_ARC,
+    KEY_LIBREVENGE_MIME_TYPE,
+    KEY_LIBREVENGE_PATH_ACTION,
+    KEY_LIBREVENGE_ROTATE,
+    KEY_LIBREVENGE_START_OPACITY,
+    KEY_LIBREVENGE_SWEEP,
+    KEY_SVG_CX,
+    KEY_SVG_CY,
+    KEY_SVG_FILL_RULE,
+    KEY_SVG_HEIGHT,
+    KEY_SVG_OFFSET,
+    KEY_SVG_R,
+    KEY_SVG_RX,
+    KEY_SVG_RY,
+    KEY_SVG_STOP_COLOR,
+    KEY_SVG_STOP_OPACITY,
+    KEY_SVG_STROKE_COLOR,
+    KEY_SVG_STROKE_LINECAP,
+    KEY_SVG_STROKE_LINEJOIN,
+    KEY_SVG_STROKE_OPACITY,
+    KEY_SVG_STROKE_WIDTH,
+    KEY_SVG_WIDTH,
+    KEY_SVG_X,
+    KEY_SVG_X1,
+    KEY_SVG_X2,
+    KEY_SVG_Y,
+    KEY_SVG_Y1,
+    KEY_SVG_Y2,
+    KEY_COUNT
+};
+
+//! interned id of a property name, KEY_COUNT if the generator ignores it
+SVGKey svgKey(const char *name);
+
+/* A property list with the properties the generator reads resolved in a
+ * single walk of the list, so that each of them is then found by an
+ * array access instead of a std::string construction and a map search.
+ * The pointers are owned by the list, which must outlive this object and
+ * not be modified meanwhile. */
+class SVGProperties {
+  public:
+    SVGProperties() {
+        clear();
+    }
+    explicit SVGProperties(const librevenge::RVNGPropertyList &list) {
+        resolve(list);
+    }
+    void resolve(const librevenge::RVNGPropertyList &list);
+    void clear();
+
+    const librevenge::RVNGProperty *operator[](SVGKey key) const {
+        return m_props[key];
+    }
+    double getDouble(SVGKey key, double defaultValue) const {
+        return m_props[key] ? m_props[key]->getDouble() : defaultValue;
+    }
+    int getInt(SVGKey key, int defaultValue) const {
+        return m_props[key] ? m_props[key]->getInt() : defaultValue;
+    }
+
+  private:
+    const librevenge::RVNGProperty *m_props[KEY_COUNT];
+};
+
+//! the current style, with its string valued enumerations decoded
+struct SVGStyle : public SVGProperties {
+    //! draw:fill
+    enum Fill { FILL_UNSET, FILL_NONE, FILL_SOLID, FILL_GRADIENT, FILL_BITMAP,
+                FILL_OTHER };
+    //! draw:stroke
+    enum Stroke { STROKE_UNSET, STROKE_NONE, STROKE_SOLID, STROKE_DASH,
+                  STROKE_OTHER };
+    //! draw:style of gradients, radial, rectangular, square and ellipsoid
+    //! are all drawn as radial ones
+    enum Gradient { GRADIENT_UNSET, GRADIENT_LINEAR, GRADIENT_AXIAL,
+                    GRADIENT_RADIAL, GRADIENT_OTHER };
+
+    SVGStyle()
+        : SVGProperties(), fill(FILL_UNSET), stroke(STROKE_UNSET),
+          gradient(GRADIENT_UNSET), shadow(false) {
+    }
+    void decode(const librevenge::RVNGPropertyList &list);
+
+    Fill fill;
+    Stroke stroke;
+    Gradient gradient;
+    //! draw:shadow is "visible"
+    bool shadow;
+};
+}
+
+#endif // SVGSTYLE_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,119 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * spans of a conversion, exported in the Chrome trace event format
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include "SVGTrace.h"
+
+namespace vss2svg {
+
+namespace {
+
+std::atomic<unsigned> nextThread(1);
+
+//! small identifier of the calling thread, for the tid of the events
+unsigned threadId() {
+    static thread_local unsigned id = 0;
+    if (!id)
+        id = nextThread++;
+    return id;
+}
+
+//! nanoseconds as the microseconds of the trace format
+void writeMicroseconds(std::ostream &os, uint64_t ns) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%llu.%03u", (unsigned long long)(ns / 1000),
+             (unsigned)(ns % 1000));
+    os << buf;
+}
+
+void writeString(std::ostream &os, const char *str) {
+    os << '"';
+    for (; *str; str++) {
+        unsigned char c = (unsigned char)*str;
+        if (c == '"' || c == '\\')
+            os << '\\' << (char)c;
+        else if (c >= 0x20)
+            os << (char)c;
+    }
+    os << '"';
+}
+}
+
+SVGTrace::SVGTrace(size_t capacity)
+    : m_events(new Event[capacity ? capacity : 1]),
+      m_capacity(capacity ? capacity : 1), m_next(0), m_origin(now()) {
+    // fault the pages in now rather than while recording
+    memset(m_events, 0, m_capacity * sizeof(Event));
+}
+
+SVGTrace::~SVGTrace() {
+    delete[] m_events;
+}
+
+void SVGTrace::record(const char *name, const char *category, uint64_t start,
+                      long id) {
+    uint64_t end = now();
+    size_t slot = m_next.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= m_capacity)
+        return;
+    Event &event = m_events[slot];
+    event.name = name;
+    event.category = category;
+    event.start = start;
+    event.duration = end - start;
+    event.id = id;
+    event.thread = threadId();
+}
+
+void SVGTrace::reset() {
+    m_next = 0;
+    m_origin = now();
+}
+
+size_t SVGTrace::size() const {
+    size_t next = m_next.load(std::memory_order_relaxed);
+    return next < m_capacity ? next : m_capacity;
+}
+
+size_t SVGTrace::dropped() const {
+    size_t next = m_next.load(std::memory_order_relaxed);
+    return next > m_capacity ? next - m_capacity : 0;
+}
+
+void SVGTrace::writeJSON(std::ostream &os) const {
+    size_t count = size();
+    os << "{\"traceEvents\": [";
+    for (size_t i = 0; i < count; i++) {
+        const Event &event = m_events[i];
+        os << (i ? ",\n" : "\n") << "{\"name\": ";
+        writeString(os, event.name);
+        os << ", \"cat\": ";
+        writeString(os, event.category);
+        os << ", \"ph\": \"X\", \"ts\": ";
+        writeMicroseconds(os, event.start > m_origin ? event.start - m_origin
+                                                     : 0);
+        os << ", \"dur\": ";
+        writeMicroseconds(os, event.duration);
+        os << ", \"pid\": 1, \"tid\": " << event.thread;
+        if (event.id >= 0)
+            os << ", \"args\": {\"id\": " << event.id << "}";
+        os << "}";
+    }
+    os << "\n], \"displayTimeUnit\": \"ms\", \"otherData\": {\"dropped\": "
+       << dropped() << "}}\n";
+}
+
+uint64_t SVGTrace::now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,50 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * page level transform of the coordinates written in the SVG output
+ */
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "SVGTransform.h"
+
+namespace vss2svg {
+
+void SVGTransform::setScale(double scale) {
+    m_scale = scale;
+    setOrigin(m_originX, m_originY);
+}
+
+void SVGTransform::setOrigin(double x, double y) {
+    m_originX = x;
+    m_originY = y;
+    m_tx = -(m_scale * x);
+    m_ty = -(m_scale * y);
+}
+
+void SVGTransform::points(const double *in, double *out, size_t count) const {
+    size_t i = 0;
+#ifdef __SSE2__
+    // a point per register, two at a time; the multiply and the add are
+    // rounded separately, as x() and y() do
+    const __m128d scale = _mm_set1_pd(m_scale);
+    const __m128d translation = _mm_set_pd(m_ty, m_tx);
+    for (; i + 2 <= count; i += 2) {
+        __m128d p0 = _mm_loadu_pd(in + 2 * i);
+        __m128d p1 = _mm_loadu_pd(in + 2 * i + 2);
+        _mm_storeu_pd(out + 2 * i,
+                      _mm_add_pd(_mm_mul_pd(p0, scale), translation));
+        _mm_storeu_pd(out + 2 * i + 2,
+                      _mm_add_pd(_mm_mul_pd(p1, scale), translation));
+    }
+#endif
+    for (; i < count; i++) {
+        out[2 * i] = x(in[2 * i]);
+        out[2 * i + 1] = y(in[2 * i + 1]);
+    }
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,62 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * page level transform of the coordinates written in the SVG output
+ */
+
+#ifndef SVGTRANSFORM_H
+#define SVGTRANSFORM_H
+
+#include <stddef.h>
+
+namespace vss2svg {
+
+//! SVG user units per inch, unless the generator is given another scale
+static const double SVG_DEFAULT_SCALE = 631;
+
+/* Maps the inches given by libvisio to SVG user units: the lengths are
+ * multiplied by the scale, the points are in addition moved so that the
+ * origin lands on (0, 0). With the default origin the result is exactly
+ * the scaled value. The points of a polyline or of a path are mapped as
+ * whole arrays by points(), with SIMD where available, before they are
+ * formatted. */
+class SVGTransform {
+  public:
+    SVGTransform()
+        : m_scale(SVG_DEFAULT_SCALE), m_originX(0), m_originY(0), m_tx(-0.0),
+          m_ty(-0.0) {
+    }
+
+    //! units per inch
+    void setScale(double scale);
+    //! the point, in inches, mapped to (0, 0)
+    void setOrigin(double x, double y);
+
+    double scale() const {
+        return m_scale;
+    }
+    double x(double value) const {
+        return m_scale * value + m_tx;
+    }
+    double y(double value) const {
+        return m_scale * value + m_ty;
+    }
+    double length(double value) const {
+        return m_scale * value;
+    }
+
+    //! map count points, given as x y pairs, from in to out; both arrays
+    //! hold 2 * count values and may be the same
+    void points(const double *in, double *out, size_t count) const;
+
+  private:
+    double m_scale;
+    double m_originX, m_originY;
+    //! translation in user units, -0.0 leaving the scaled values as is
+    double m_tx, m_ty;
+};
+}
+
+#endif // SVGTRANSFORM_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
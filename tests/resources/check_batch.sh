@@ -0,0 +1,104 @@
+#!/bin/sh
+
+OUTDIR="../out/batch"
+vssDIR="./vss"
+ret=0
+
+ABSPATH=$(readlink -f "$(dirname $0)")
+
+help(){
+    cat <<EOF2
+usage: `basename $0` [-h] [-i <visio file>]
+
+Script checking that the batch modes of vss2svg-conv (--list, --glob and
+--dir) convert inputs of the same name in different directories to
+different output directories, and refuse to convert two inputs to the
+same one
+
+arguments:
+  -h: diplays this help
+  -i: input converted (default: first .vss file of '`readlink -f "$ABSPATH/$vssDIR"`')
+EOF2
+    exit 1
+}
+
+while getopts ":hi:" opt; do
+  case $opt in
+    h)
+        help
+        ;;
+    i)
+        INPUT=`readlink -f "$OPTARG"`
+        ;;
+    \?)
+        echo "Invalid option: -$OPTARG" >&2
+        help
+        ;;
+    :)
+        echo "Option -$OPTARG requires an argument." >&2
+        help
+        ;;
+  esac
+done
+
+cd $ABSPATH
+. ./colors.sh
+[ -z "$INPUT" ] && INPUT=`find $vssDIR -type f -name "*.vss" 2>/dev/null |sort |head -n 1`
+if [ -z "$INPUT" ] || ! [ -f "$INPUT" ]
+then
+    printf "[${BRed}FAIL${RCol}] no input file, give one with -i\n"
+    exit 1
+fi
+INPUT=`readlink -f "$INPUT"`
+CMD="`readlink -f ../../vss2svg-conv`"
+rm -rf $OUTDIR
+mkdir -p $OUTDIR/in/p $OUTDIR/in/q
+OUTDIR=`readlink -f $OUTDIR`
+
+# the same file, twice under the same name
+NAME=`basename "$INPUT"`
+cp "$INPUT" "$OUTDIR/in/p/$NAME"
+cp "$INPUT" "$OUTDIR/in/q/$NAME"
+$CMD -i "$INPUT" -o "$OUTDIR/single" >/dev/null 2>&1
+PAGES=`ls "$OUTDIR/single" |wc -l`
+
+# the pages of both inputs must be found, each in its own directory
+check_pages(){
+    mode="$1"
+    out="$2"
+    for d in p q
+    do
+        n=`ls "$out/$d/$NAME" 2>/dev/null |wc -l`
+        if [ $n -ne $PAGES ] || [ $PAGES -eq 0 ]
+        then
+            printf "[${BYel}ERROR${RCol}] $mode: $n page(s) in '$out/$d/$NAME', expected $PAGES\n"
+            ret=1
+        fi
+    done
+}
+
+$CMD -g "$OUTDIR/in/*/$NAME" -o "$OUTDIR/glob" -j 2 >/dev/null 2>&1 || ret=1
+check_pages "--glob" "$OUTDIR/glob"
+
+printf "$OUTDIR/in/p/$NAME\n$OUTDIR/in/q/$NAME\n" >"$OUTDIR/list"
+$CMD -l "$OUTDIR/list" -o "$OUTDIR/list.out" -j 2 >/dev/null 2>&1 || ret=1
+check_pages "--list" "$OUTDIR/list.out"
+
+$CMD -d "$OUTDIR/in" -o "$OUTDIR/dir" -j 2 >/dev/null 2>&1 || ret=1
+check_pages "--dir" "$OUTDIR/dir"
+
+# the same input listed twice can't go to two directories
+printf "$OUTDIR/in/p/$NAME\n$OUTDIR/in/p/../p/$NAME\n" >"$OUTDIR/list.dup"
+if $CMD -l "$OUTDIR/list.dup" -o "$OUTDIR/dup" >/dev/null 2>&1
+then
+    printf "[${BYel}ERROR${RCol}] --list: an input listed twice was converted\n"
+    ret=1
+fi
+
+if [ $ret -ne 0 ]
+then
+    printf "[${BRed}FAIL${RCol}] Check exited with error(s)\n"
+else
+    printf "[${BGre}SUCCESS${RCol}] Check Ok\n"
+fi
+exit $ret
@@ -2,6 +2,7 @@
 
 OUTDIR="../out"
 vssDIR="./vss"
+SAMPLEDIR="./samples"
 ret=0
 VAGRIND_CMD="valgrind --tool=memcheck --leak-check=yes --show-reachable=yes --num-callers=20 --track-fds=yes --error-exitcode=42"
 
@@ -15,6 +16,10 @@ usage: `basename $0` [-h] [-v] [-e <vss dir>] [-s] [-n]
 
 Script checking memleaks, segfault and svg correctness of vss2svg-conv
 
+The files of '`readlink -f "$ABSPATH/$SAMPLEDIR"`' are converted too, and
+their pages compared with the ones of '$SAMPLEDIR/ref', which must be
+identical
+
 arguments:
   -h: diplays this help
   -v: verbose mode, print vss records
@@ -85,10 +90,16 @@ mkdir -p $OUTDIR
 CMD="`readlink -f ../../vss2svg-conv`"
 OUTDIR=`readlink -f $OUTDIR`
 DTD=`readlink -f ./svg11-flat.dtd`
-for vss in `find $vssDIR -type f -name "*.vss" |sort`
+# the options of the converter, with and without the replay of the first
+# pass when it is available
+CONVOPTS=""
+$CMD --help 2>/dev/null | grep -q -- "--single-pass" && CONVOPTS="-r"
+for vss in `find $vssDIR -type f -name "*.vss" 2>/dev/null |sort` \
+    `find $SAMPLEDIR -maxdepth 1 -type f ! -name "*.py" |sort`
 do
     vss="`readlink -f $vss`"
     SVG="${OUTDIR}/`basename ${vss}`"
+    REF="`readlink -f $SAMPLEDIR`/ref/`basename ${vss}`"
     verbose_print "\n############## `basename "${vss}"` ####################"
     verbose_print "Command: $CMD $RESIZE_OPTS -i \"$vss\" -o \"${SVG}\""
     $VAGRIND_CMD $CMD $RESIZE_OPTS -i "$vss" -o ${SVG} $VERBOSE_OPT
@@ -119,6 +130,25 @@ do
             fi
         done
     fi
+    # the reference pages are written at the default size
+    if [ -d "$REF" ] && [ -z "$RESIZE_OPTS" ]
+    then
+        for opts in "" $CONVOPTS
+        do
+            rm -rf "${SVG}.ref"
+            $CMD $opts -i "$vss" -o "${SVG}.ref" >/dev/null 2>&1
+            if ! diff -r "$REF" "${SVG}.ref" >/dev/null 2>&1
+            then
+                printf "[${BYel}ERROR${RCol}] vss2svg-conv output differs from the reference\n"
+                printf "source vss:  $vss\n"
+                printf "reference :  $REF\n"
+                printf "command   :  $CMD $opts -i \"$vss\" -o \"${SVG}.ref\"\n\n"
+                diff -r "$REF" "${SVG}.ref"
+                ret=1
+            fi
+        done
+        rm -rf "${SVG}.ref"
+    fi
     verbose_print "\n#####################################################\n"
     [ "${STOPONERROR}" = "yes" ] && [ $ret -eq 1 ] && exit 1
 done
@@ -0,0 +1,59 @@
+#!/bin/sh
+
+OUTDIR="../out/streams"
+ret=0
+
+ABSPATH=$(readlink -f "$(dirname $0)")
+
+help(){
+    cat <<EOF2
+usage: `basename $0` [-h] [-v]
+
+Script running the checks of the input streams (ZIP entries and OLE2
+streams), built with 'cmake -DSTREAMCHECKS=ON .'
+
+arguments:
+  -h: diplays this help
+  -v: runs the checks under valgrind
+EOF2
+    exit 1
+}
+
+while getopts ":hv" opt; do
+  case $opt in
+    h)
+        help
+        ;;
+    v)
+        VALGRIND="valgrind -q --error-exitcode=42"
+        ;;
+    \?)
+        echo "Invalid option: -$OPTARG" >&2
+        help
+        ;;
+  esac
+done
+
+cd $ABSPATH
+. ./colors.sh
+rm -rf $OUTDIR
+mkdir -p $OUTDIR
+
+for check in zipstream olestream
+do
+    CMD="../../check-$check"
+    if ! [ -x "$CMD" ]
+    then
+        printf "[${BRed}FAIL${RCol}] '$CMD' not found, build it with 'cmake -DSTREAMCHECKS=ON .'\n"
+        exit 1
+    fi
+    $VALGRIND $CMD $OUTDIR
+    if [ $? -ne 0 ]
+    then
+        printf "[${BYel}ERROR${RCol}] check of the ${check} failed\n"
+        ret=1
+    else
+        printf "[${BGre}SUCCESS${RCol}] check of the ${check}\n"
+    fi
+done
+exit $ret
@@ -0,0 +1,659 @@
+#!/usr/bin/env python3
+"""vss2svg
+
+Generates the small Visio files of tests/resources/samples: the same two
+masters written as binary Visio 5, 2000 (6) and 2003 (11) documents, in
+compressed and uncompressed streams, inside an OLE2 storage, and as VDX,
+VSDX and VSSX files.
+
+The files are checked in, this script only documents how they were made:
+
+    ./mksamples.py [<output dir>]
+
+The layout written is the one read by libvisio, not a complete one: no
+summary information, no names, no document pages in the binary files.
+"""
+
+import os
+import struct
+import sys
+import zipfile
+
+# stream and chunk types, see libvisio's VSDDocumentStructure.h
+TRAILER_STREAM = 0x14
+COLORS = 0x16
+STYLES = 0x1a
+STENCILS = 0x1d
+STENCIL_PAGE = 0x1e
+SHAPES = 0x28
+PAGE_SHEET = 0x46
+SHAPE_SHAPE = 0x48
+STYLE_SHEET = 0x4a
+TEXT = 0x0e
+SHAPE_LIST = 0x65
+GEOM_LIST = 0x6c
+SHAPE_ID = 0x83
+LINE = 0x85
+FILL_AND_SHADOW = 0x86
+GEOMETRY = 0x89
+MOVE_TO = 0x8a
+LINE_TO = 0x8b
+ARC_TO = 0x8c
+ELLIPSE = 0x8f
+PAGE_PROPS = 0x92
+XFORM_DATA = 0x9b
+
+# stream formats: blob, blob followed by pointers to substreams, chunks
+BLOB = 0x40
+POINTERS = 0x50
+CHUNKS = 0xd0
+COMPRESSED = 0x02
+
+MINUS_ONE = 0xffffffff
+
+COLOURS = [
+    (0x00, 0x00, 0x00), (0xff, 0xff, 0xff), (0xff, 0x00, 0x00),
+    (0x00, 0xff, 0x00), (0x00, 0x00, 0xff), (0xff, 0xff, 0x00),
+    (0xff, 0x80, 0x00), (0x80, 0x80, 0x80),
+]
+BLACK, WHITE, RED, GREEN, BLUE, YELLOW, ORANGE, GREY = range(len(COLOURS))
+
+# The content of the samples. Each master is a page size and its shapes,
+# the geometries are lists of (row type, values) tuples.
+STYLESHEETS = [
+    # line width, line colour, fill foreground, fill pattern
+    (0.01, BLACK, WHITE, 1),
+    (0.03, GREEN, YELLOW, 1),
+]
+
+MASTERS = [
+    {
+        'width': 2.0, 'height': 1.5,
+        'shapes': [
+            {
+                'id': 1, 'style': 0,
+                'xform': (1.0, 0.75, 1.5, 1.0, 0.75, 0.5, 0.0, 0, 0),
+                'line': (0.02, RED), 'fill': (BLUE, 1),
+                'geometry': [
+                    ('move', (0.0, 0.0)), ('line', (1.5, 0.0)),
+                    ('line', (1.5, 1.0)), ('line', (0.0, 1.0)),
+                    ('line', (0.0, 0.0)),
+                ],
+                'text': 'Hello',
+            },
+            {
+                'id': 2, 'style': 1,
+                'xform': (0.5, 0.5, 0.6, 0.4, 0.3, 0.2, 0.0, 0, 0),
+                'geometry': [
+                    ('ellipse', (0.3, 0.2, 0.6, 0.2, 0.3, 0.4)),
+                ],
+            },
+        ],
+    },
+    {
+        'width': 3.0, 'height': 2.0,
+        'shapes': [
+            {
+                'id': 1, 'style': 0,
+                'xform': (1.5, 1.0, 2.0, 1.0, 1.0, 0.5, 0.5235987755982988,
+                          1, 0),
+                'line': (0.015, ORANGE), 'fill': (GREY, 1),
+                'geometry': [
+                    ('move', (0.0, 0.0)), ('line', (2.0, 0.0)),
+                    ('arc', (2.0, 1.0, 0.25)), ('line', (0.0, 1.0)),
+                    ('arc', (0.0, 0.0, -0.25)),
+                ],
+            },
+        ],
+    },
+]
+
+
+def u8(v):
+    return struct.pack('<B', v)
+
+
+def u16(v):
+    return struct.pack('<H', v & 0xffff)
+
+
+def u32(v):
+    return struct.pack('<I', v & 0xffffffff)
+
+
+def dbl(v):
+    return struct.pack('<d', v)
+
+
+def cells(*values):
+    """values as written in the binary rows: a unit byte and a double"""
+    return b''.join(b'\x00' + dbl(v) for v in values)
+
+
+def rgba(index):
+    return bytes(COLOURS[index]) + b'\x00'
+
+
+def lz77(data):
+    """compresses as the binary Visio streams are: a flag byte giving,
+    from the lowest bit, whether each of the 8 next tokens is a literal
+    or a 2 bytes reference into the last 4096 output bytes"""
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        flag = 0
+        tokens = bytearray()
+        for bit in range(8):
+            if pos >= len(data):
+                break
+            best, bestLen = 0, 0
+            for src in range(max(0, pos - 4095), pos):
+                length = 0
+                while (length < 18 and pos + length < len(data) and
+                       data[src + length] == data[pos + length]):
+                    length += 1
+                if length > bestLen:
+                    best, bestLen = src, length
+            if bestLen >= 3:
+                pointer = ((best & 4095) - 18) % 4096
+                tokens += bytes([pointer & 0xff,
+                                 ((pointer >> 4) & 0xf0) | (bestLen - 3)])
+                pos += bestLen
+            else:
+                flag |= 1 << bit
+                tokens.append(data[pos])
+                pos += 1
+        out.append(flag)
+        out += tokens
+    return bytes(out)
+
+
+class BinaryWriter:
+    """writes the VisioDocument stream of a version 5, 6 or 11 file"""
+
+    def __init__(self, version, compressed):
+        self.version = version
+        self.compressed = compressed
+        self.data = bytearray()
+
+    def header(self, level, chunkType, chunkId, dataLength):
+        if self.version == 5:
+            return (u16(chunkType) + u16(chunkId) + u8(level) + u8(0) +
+                    u16(0) + u32(dataLength))
+        return (u32(chunkType) + u32(chunkId) + u32(0) + u32(dataLength) +
+                u16(level) + u8(0x50))
+
+    def trailer(self, chunkType):
+        """size of the trailer libvisio expects after the chunk"""
+        if self.version == 5:
+            return 0
+        if self.version == 6:
+            if chunkType in (0x2c, 0x0d) or 0x64 <= chunkType <= 0x76:
+                return 8
+            return 0
+        trailer = 0
+        if chunkType in (0x71, 0x70, 0x6b, 0x6a, 0x69, 0x66, 0x65, 0x2c):
+            trailer += 8
+        if chunkType in (0x64, 0x65, 0x66, 0x69, 0x6a, 0x6b, 0x6f, 0x71,
+                         0x92, 0xa9, 0xb4, 0xb6, 0xb9, 0xc7) and \
+                trailer not in (12, 4):
+            trailer += 4
+        return trailer
+
+    def chunk(self, level, chunkType, data, chunkId=0):
+        return (self.header(level, chunkType, chunkId, len(data)) + data +
+                b'\x00' * self.trailer(chunkType))
+
+    def stream(self, fmt, data):
+        """appends a stream to the document, returns its pointer"""
+        if self.compressed:
+            fmt |= COMPRESSED
+            data = lz77(data)
+        offset = len(self.data)
+        self.data += data
+        return (fmt, offset, len(data))
+
+    def pointer(self, ptrType, ptr):
+        fmt, offset, length = ptr
+        if self.version == 5:
+            return u16(ptrType) + u16(fmt) + u32(0) + u32(offset) + \
+                u32(length)
+        return u32(ptrType) + u32(0) + u32(offset) + u32(length) + u16(fmt)
+
+    # offset of the pointer count in the version 5 streams
+    V5_COUNT = {TRAILER_STREAM: 0x82, STYLES: 0x12, STENCILS: 0x1e,
+                STENCIL_PAGE: 0x36}
+
+    def pointers(self, ptrType, pointers, head=b''):
+        """the blob of a stream followed by the pointers to its
+        substreams, given as (type, pointer) pairs"""
+        ptrs = b''.join(self.pointer(t, p) for t, p in pointers)
+        if self.version == 5:
+            at = self.V5_COUNT.get(ptrType, 0x1e if ptrType > 0x45 else 0xa)
+            blob = head.ljust(at, b'\x00') + u16(len(pointers)) + ptrs
+        else:
+            blob = (u32(0x14) + u32(0) + head.ljust(8, b'\x00') + u32(0) +
+                    u32(len(pointers)) + u32(0) + ptrs)
+        if self.compressed:
+            # the decompressed blobs start with 4 bytes libvisio skips
+            blob = u32(len(blob)) + blob
+        return blob
+
+    def line(self, level, width, colour):
+        if self.version == 5:
+            data = cells(width) + u8(colour) + u8(1)
+        else:
+            data = cells(width) + b'\x00' + rgba(colour) + u8(1)
+        return self.chunk(level, LINE, data + b'\x00' * 10 + u8(0) * 3)
+
+    def fill(self, level, colour, pattern):
+        if self.version == 5:
+            data = u8(colour) + u8(WHITE) + u8(pattern) + u8(BLACK) + \
+                u8(WHITE) + u8(0)
+        else:
+            data = (u8(colour) + rgba(colour) + u8(WHITE) + rgba(WHITE) +
+                    u8(pattern) + u8(BLACK) + rgba(BLACK) + u8(WHITE) +
+                    rgba(WHITE) + u8(0))
+            if self.version == 11:
+                data += b'\x00\x00' + dbl(0.0) + cells(0.0)
+        return self.chunk(level, FILL_AND_SHADOW, data)
+
+    def ids(self, *values):
+        if self.version == 5:
+            return b''.join(u16(v) for v in values)
+        return b''.join(u32(0) + u32(v) for v in values)
+
+    def row(self, kind, values):
+        rowType = {'move': MOVE_TO, 'line': LINE_TO, 'arc': ARC_TO,
+                   'ellipse': ELLIPSE}[kind]
+        return rowType, cells(*values)
+
+    def list(self, level, listType, records):
+        """a list chunk and its elements, given as (type, data) pairs"""
+        if self.version != 5:
+            out = self.chunk(level, listType, u32(0) + u32(0))
+            for i, (recordType, data) in enumerate(records):
+                out += self.chunk(level + 1, recordType, data, i)
+            return out
+        # the version 5 elements are records of the list chunk, located by
+        # a table at its end listing them from the last one
+        data = bytearray()
+        offsets = []
+        for recordType, record in records:
+            while len(data) % 4:
+                data.append(0)
+            offsets.append(len(data))
+            data += record
+        table = b''.join(u16(t) + u16(o) for (t, _), o in
+                         reversed(list(zip(records, offsets))))
+        data += table + u16(len(records)) + u16(len(data))
+        return self.chunk(level, listType, bytes(data))
+
+    def geometry(self, level, rows):
+        return self.list(level, GEOM_LIST, [(GEOMETRY, u8(0))] +
+                         [self.row(*r) for r in rows])
+
+    def text(self, level, text):
+        if self.version == 11:
+            data = text.encode('utf-16-le')
+        else:
+            data = text.encode('latin-1')
+        return self.chunk(level, TEXT, b'\x00' * 8 + data)
+
+    def shape(self, shape):
+        style = shape['style']
+        if self.version == 5:
+            data = (u16(0) + u16(0) + u16(0) + u16(MINUS_ONE) +
+                    u16(MINUS_ONE) + u16(style) + u16(style) + u16(style))
+        else:
+            data = (b'\x00' * 10 + u32(0) + u32(0) + u32(MINUS_ONE) +
+                    u32(0) + u32(MINUS_ONE) + u32(0) + u32(style) + u32(0) +
+                    u32(style) + u32(0) + u32(style))
+        out = self.chunk(1, SHAPE_SHAPE, data, shape['id'])
+        xform = shape['xform']
+        out += self.chunk(2, XFORM_DATA, cells(*xform[:7]) +
+                          u8(xform[7]) + u8(xform[8]))
+        if 'line' in shape:
+            out += self.line(2, *shape['line'])
+        if 'fill' in shape:
+            out += self.fill(2, *shape['fill'])
+        out += self.geometry(2, shape['geometry'])
+        if 'text' in shape:
+            out += self.text(2, shape['text'])
+        return self.stream(CHUNKS, out)
+
+    def master(self, master):
+        sheet = self.chunk(1, PAGE_SHEET, b'\x00' * 8) + self.chunk(
+            2, PAGE_PROPS, cells(master['width'], master['height'], 0.0,
+                                 0.0, 1.0, 1.0))
+        # the order in which the shapes are drawn
+        uint = u16 if self.version == 5 else u32
+        sheet += self.list(2, SHAPE_LIST, [(SHAPE_ID, uint(s['id']))
+                                           for s in master['shapes']])
+        shapes = [(SHAPE_SHAPE, self.shape(s)) for s in master['shapes']]
+        children = [
+            (PAGE_SHEET, self.stream(CHUNKS, sheet)),
+            (SHAPES, self.stream(POINTERS, self.pointers(SHAPES, shapes))),
+        ]
+        if self.version == 5:
+            head = u16(MINUS_ONE)
+        else:
+            head = u32(MINUS_ONE)
+        return self.stream(POINTERS, self.pointers(STENCIL_PAGE, children,
+                                                   head))
+
+    def styles(self):
+        sheets = []
+        for i, (width, colour, fillColour, pattern) in \
+                enumerate(STYLESHEETS):
+            if self.version == 5:
+                data = b'\x00' * 10 + u16(MINUS_ONE) * 3
+            else:
+                data = (b'\x00' * 0x22 + u32(MINUS_ONE) + u32(0) +
+                        u32(MINUS_ONE) + u32(0) + u32(MINUS_ONE))
+            chunks = (self.chunk(1, STYLE_SHEET, data, i) +
+                      self.line(2, width, colour) +
+                      self.fill(2, fillColour, pattern))
+            sheets.append((STYLE_SHEET, self.stream(CHUNKS, chunks)))
+        return self.stream(POINTERS, self.pointers(STYLES, sheets))
+
+    def colours(self):
+        data = u16(0) + u8(len(COLOURS)) + u8(0)
+        data += b''.join(rgba(i) for i in range(len(COLOURS)))
+        if self.compressed:
+            data = u32(len(data)) + data
+        return self.stream(BLOB, data)
+
+    def document(self):
+        self.data = bytearray(0x40)
+        colours = self.colours()
+        styles = self.styles()
+        masters = [(STENCIL_PAGE, self.master(m)) for m in MASTERS]
+        stencils = self.stream(POINTERS, self.pointers(STENCILS, masters))
+        trailer = self.stream(POINTERS, self.pointers(TRAILER_STREAM, [
+            (COLORS, colours), (STYLES, styles), (STENCILS, stencils)]))
+        self.data[0:21] = b'Visio (TM) Drawing\r\n\x00'
+        self.data[0x1a] = self.version
+        ptr = self.pointer(TRAILER_STREAM, trailer)
+        self.data[0x24:0x24 + len(ptr)] = ptr
+        return bytes(self.data)
+
+
+def ole2(name, stream):
+    """an OLE2 storage holding a single stream, in the mini stream when
+    it is under 4096 bytes"""
+    sector = 512
+    free, end, fatSector = 0xffffffff, 0xfffffffe, 0xfffffffd
+
+    def pad(data, size):
+        return data + b'\x00' * (-len(data) % size)
+
+    def entry(entryName, entryType, child, start, size):
+        encoded = entryName.encode('utf-16-le') + b'\x00\x00'
+        return (encoded.ljust(64, b'\x00') + u16(len(encoded)) +
+                u8(entryType) + u8(1) + u32(free) + u32(free) + u32(child) +
+                b'\x00' * 36 + u32(start) + u32(size) + u32(0))
+
+    mini = len(stream) < 4096
+    # sectors: FAT, directory, then the mini FAT and the mini stream or
+    # the stream itself
+    fat = [fatSector, end]
+    if mini:
+        miniData = pad(stream, 64)
+        miniFat = [i + 1 for i in range(len(miniData) // 64)]
+        miniFat[-1] = end
+        miniFatSector = len(fat)
+        fat.append(end)
+        rootStart = len(fat)
+        data = pad(miniData, sector)
+        streamStart = 0
+    else:
+        miniFat = []
+        miniFatSector = end
+        rootStart = end
+        streamStart = len(fat)
+        data = pad(stream, sector)
+    count = len(data) // sector
+    first = len(fat)
+    fat += [first + i + 1 for i in range(count)]
+    fat[-1] = end
+    if len(fat) > sector // 4:
+        raise ValueError('stream too big for a single FAT sector')
+
+    directory = (entry('Root Entry', 5, 1, rootStart,
+                       len(miniData) if mini else 0) +
+                 entry(name, 2, free, streamStart, len(stream)))
+    directory += entry('', 0, free, 0, 0) * 2
+
+    header = (b'\xd0\xcf\x11\xe0\xa1\xb1\x1a\xe1' + b'\x00' * 16 +
+              u16(0x3e) + u16(3) + u16(0xfffe) + u16(9) + u16(6) +
+              b'\x00' * 6 + u32(0) + u32(1) + u32(1) + u32(0) + u32(4096) +
+              u32(miniFatSector) + u32(1 if mini else 0) + u32(end) +
+              u32(0) + u32(0) + u32(free) * 108)
+    out = header
+    out += b''.join(u32(v) for v in fat).ljust(sector, b'\xff')
+    out += directory
+    if mini:
+        out += b''.join(u32(v) for v in miniFat).ljust(sector, b'\xff')
+    out += data
+    return out
+
+
+def colour(index):
+    return '#%02x%02x%02x' % COLOURS[index]
+
+
+def vsdxShape(shape):
+    pinX, pinY, width, height, locX, locY, angle, flipX, flipY = \
+        shape['xform']
+    style = shape['style']
+    out = ('<Shape ID="%d" Type="Shape" LineStyle="%d" FillStyle="%d" '
+           'TextStyle="%d">' % (shape['id'], style, style, style))
+    for name, value in (('PinX', pinX), ('PinY', pinY), ('Width', width),
+                        ('Height', height), ('LocPinX', locX),
+                        ('LocPinY', locY), ('Angle', angle),
+                        ('FlipX', flipX), ('FlipY', flipY)):
+        out += '<Cell N="%s" V="%r"/>' % (name, value)
+    if 'line' in shape:
+        out += '<Cell N="LineWeight" V="%r"/><Cell N="LineColor" V="%s"/>' \
+            '<Cell N="LinePattern" V="1"/>' % (shape['line'][0],
+                                               colour(shape['line'][1]))
+    if 'fill' in shape:
+        out += '<Cell N="FillForegnd" V="%s"/><Cell N="FillPattern" ' \
+            'V="%d"/>' % (colour(shape['fill'][0]), shape['fill'][1])
+    out += '<Section N="Geometry" IX="0"><Cell N="NoFill" V="0"/>' \
+        '<Cell N="NoLine" V="0"/>'
+    for ix, (kind, values) in enumerate(shape['geometry']):
+        rowType, names = {
+            'move': ('MoveTo', 'XY'), 'line': ('LineTo', 'XY'),
+            'arc': ('ArcTo', 'XYA'), 'ellipse': ('Ellipse', 'XYABCD')
+        }[kind]
+        out += '<Row T="%s" IX="%d">' % (rowType, ix + 1)
+        for name, value in zip(names, values):
+            out += '<Cell N="%s" V="%r"/>' % (name, value)
+        out += '</Row>'
+    out += '</Section>'
+    if 'text' in shape:
+        out += '<Text>%s</Text>' % shape['text']
+    return out + '</Shape>'
+
+
+def vdxShape(shape):
+    pinX, pinY, width, height, locX, locY, angle, flipX, flipY = \
+        shape['xform']
+    style = shape['style']
+    out = ('<Shape ID="%d" Type="Shape" LineStyle="%d" FillStyle="%d" '
+           'TextStyle="%d"><XForm>' % (shape['id'], style, style, style))
+    for name, value in (('PinX', pinX), ('PinY', pinY), ('Width', width),
+                        ('Height', height), ('LocPinX', locX),
+                        ('LocPinY', locY), ('Angle', angle),
+                        ('FlipX', flipX), ('FlipY', flipY)):
+        out += '<%s>%r</%s>' % (name, value, name)
+    out += '</XForm>'
+    if 'line' in shape:
+        out += '<Line><LineWeight>%r</LineWeight><LineColor>%s</LineColor>' \
+            '<LinePattern>1</LinePattern></Line>' % (
+                shape['line'][0], colour(shape['line'][1]))
+    if 'fill' in shape:
+        out += '<Fill><FillForegnd>%s</FillForegnd><FillPattern>%d' \
+            '</FillPattern></Fill>' % (colour(shape['fill'][0]),
+                                       shape['fill'][1])
+    out += '<Geom IX="0"><NoFill>0</NoFill><NoLine>0</NoLine>'
+    for ix, (kind, values) in enumerate(shape['geometry']):
+        rowType, names = {
+            'move': ('MoveTo', 'XY'), 'line': ('LineTo', 'XY'),
+            'arc': ('ArcTo', 'XYA'), 'ellipse': ('Ellipse', 'XYABCD')
+        }[kind]
+        out += '<%s IX="%d">' % (rowType, ix + 1)
+        for name, value in zip(names, values):
+            out += '<%s>%r</%s>' % (name, value, name)
+        out += '</%s>' % rowType
+    out += '</Geom>'
+    if 'text' in shape:
+        out += '<Text>%s</Text>' % shape['text']
+    return out + '</Shape>'
+
+
+def vdx():
+    out = ('<?xml version="1.0" encoding="utf-8"?>\n<VisioDocument '
+           'xmlns="http://schemas.microsoft.com/visio/2003/core">'
+           '<Colors>')
+    for i in range(len(COLOURS)):
+        out += '<ColorEntry IX="%d" RGB="%s"/>' % (i, colour(i))
+    out += '</Colors><StyleSheets>'
+    for i, (width, lineColour, fillColour, pattern) in \
+            enumerate(STYLESHEETS):
+        out += ('<StyleSheet ID="%d"><Line><LineWeight>%r</LineWeight>'
+                '<LineColor>%s</LineColor><LinePattern>1</LinePattern>'
+                '</Line><Fill><FillForegnd>%s</FillForegnd><FillPattern>%d'
+                '</FillPattern></Fill></StyleSheet>' % (
+                    i, width, colour(lineColour),
+                    colour(fillColour), pattern))
+    out += '</StyleSheets><Masters>'
+    for i, master in enumerate(MASTERS):
+        out += ('<Master ID="%d" NameU="M%d" Name="M%d"><PageSheet>'
+                '<PageProps><PageWidth>%r</PageWidth><PageHeight>%r'
+                '</PageHeight></PageProps></PageSheet><Shapes>' % (
+                    i, i, i, master['width'], master['height']))
+        out += ''.join(vdxShape(s) for s in master['shapes'])
+        out += '</Shapes></Master>'
+    return (out + '</Masters></VisioDocument>\n').encode('utf-8')
+
+
+VISIO_NS = 'http://schemas.microsoft.com/office/visio/2012/main'
+R_NS = 'http://schemas.openxmlformats.org/officeDocument/2006/relationships'
+PKG_NS = 'http://schemas.openxmlformats.org/package/2006/relationships'
+VISIO_REL = 'http://schemas.microsoft.com/visio/2010/relationships/'
+XML_HEAD = '<?xml version="1.0" encoding="utf-8" standalone="yes"?>\n'
+
+
+def rels(targets):
+    out = XML_HEAD + '<Relationships xmlns="%s">' % PKG_NS
+    for i, (relType, target) in enumerate(targets):
+        out += '<Relationship Id="rId%d" Type="%s" Target="%s"/>' % (
+            i + 1, relType, target)
+    return out + '</Relationships>'
+
+
+def opc(stencil):
+    """the parts of a VSSX file, or of a VSDX one with a page using the
+    first master"""
+    content = 'vnd.ms-visio.stencil' if stencil else 'vnd.ms-visio.drawing'
+    parts = []
+    types = (XML_HEAD + '<Types xmlns="http://schemas.openxmlformats.org/'
+             'package/2006/content-types"><Default Extension="rels" '
+             'ContentType="application/vnd.openxmlformats-package.'
+             'relationships+xml"/><Default Extension="xml" ContentType='
+             '"application/xml"/><Override PartName="/visio/document.xml" '
+             'ContentType="application/%s.main+xml"/></Types>' % content)
+    parts.append(('[Content_Types].xml', types))
+    parts.append(('_rels/.rels', rels([(VISIO_REL + 'document',
+                                        'visio/document.xml')])))
+
+    document = (XML_HEAD + '<VisioDocument xmlns="%s" xmlns:r="%s">'
+                '<Colors>' % (VISIO_NS, R_NS))
+    for i in range(len(COLOURS)):
+        document += '<ColorEntry IX="%d" RGB="%s"/>' % (i, colour(i))
+    document += '</Colors><StyleSheets>'
+    for i, (width, lineColour, fillColour, pattern) in \
+            enumerate(STYLESHEETS):
+        document += ('<StyleSheet ID="%d" NameU="S%d" Name="S%d">'
+                     '<Cell N="LineWeight" V="%r"/><Cell N="LineColor" '
+                     'V="%s"/><Cell N="LinePattern" V="1"/><Cell '
+                     'N="FillForegnd" V="%s"/><Cell N="FillPattern" V="%d"/>'
+                     '</StyleSheet>' % (i, i, i, width,
+                                        colour(lineColour),
+                                        colour(fillColour), pattern))
+    document += '</StyleSheets></VisioDocument>'
+    parts.append(('visio/document.xml', document))
+    documentRels = [(VISIO_REL + 'masters', 'masters/masters.xml')]
+    if not stencil:
+        documentRels.append((VISIO_REL + 'pages', 'pages/pages.xml'))
+    parts.append(('visio/_rels/document.xml.rels', rels(documentRels)))
+
+    masters = XML_HEAD + '<Masters xmlns="%s" xmlns:r="%s">' % (VISIO_NS,
+                                                                 R_NS)
+    for i, master in enumerate(MASTERS):
+        masters += ('<Master ID="%d" NameU="M%d" Name="M%d"><PageSheet>'
+                    '<Cell N="PageWidth" V="%r"/><Cell N="PageHeight" '
+                    'V="%r"/></PageSheet><Rel r:id="rId%d"/></Master>' % (
+                        i, i, i, master['width'], master['height'], i + 1))
+        contents = (XML_HEAD + '<MasterContents xmlns="%s" xmlns:r="%s">'
+                    '<Shapes>' % (VISIO_NS, R_NS))
+        contents += ''.join(vsdxShape(s) for s in master['shapes'])
+        contents += '</Shapes></MasterContents>'
+        parts.append(('visio/masters/master%d.xml' % (i + 1), contents))
+    masters += '</Masters>'
+    parts.append(('visio/masters/masters.xml', masters))
+    parts.append(('visio/masters/_rels/masters.xml.rels', rels(
+        [(VISIO_REL + 'master', 'master%d.xml' % (i + 1))
+         for i in range(len(MASTERS))])))
+
+    if not stencil:
+        parts.append(('visio/pages/pages.xml', XML_HEAD + (
+            '<Pages xmlns="%s" xmlns:r="%s"><Page ID="0" NameU="P0" '
+            'Name="P0"><PageSheet><Cell N="PageWidth" V="4.0"/><Cell '
+            'N="PageHeight" V="3.0"/></PageSheet><Rel r:id="rId1"/></Page>'
+            '</Pages>' % (VISIO_NS, R_NS))))
+        parts.append(('visio/pages/_rels/pages.xml.rels', rels(
+            [(VISIO_REL + 'page', 'page1.xml')])))
+        parts.append(('visio/pages/page1.xml', XML_HEAD + (
+            '<PageContents xmlns="%s" xmlns:r="%s"><Shapes><Shape ID="1" '
+            'Type="Shape" Master="0"><Cell N="PinX" V="2.0"/><Cell '
+            'N="PinY" V="1.5"/></Shape></Shapes></PageContents>' % (
+                VISIO_NS, R_NS))))
+    return parts
+
+
+def writeZip(path, parts):
+    with zipfile.ZipFile(path, 'w', zipfile.ZIP_DEFLATED) as z:
+        for name, data in parts:
+            info = zipfile.ZipInfo(name, (2016, 1, 1, 0, 0, 0))
+            info.compress_type = zipfile.ZIP_DEFLATED
+            z.writestr(info, data)
+
+
+def main():
+    outDir = sys.argv[1] if len(sys.argv) > 1 else \
+        os.path.dirname(os.path.abspath(__file__))
+    binaries = [
+        ('shapes-v11.vss', 11, False),
+        ('shapes-v11.vsd', 11, True),
+        ('shapes-v6.vss', 6, True),
+        ('shapes-v5.vsd', 5, False),
+    ]
+    for name, version, compressed in binaries:
+        stream = BinaryWriter(version, compressed).document()
+        if name.endswith('.vsd'):
+            # keep the .vsd files out of the mini stream
+            stream = stream.ljust(4096, b'\x00')
+        with open(os.path.join(outDir, name), 'wb') as f:
+            f.write(ole2('VisioDocument', stream))
+    with open(os.path.join(outDir, 'shapes.vdx'), 'wb') as f:
+        f.write(vdx())
+    writeZip(os.path.join(outDir, 'shapes.vssx'), opc(True))
+    writeZip(os.path.join(outDir, 'shapes.vsdx'), opc(False))
+
+
+if __name__ == '__main__':
+    main()
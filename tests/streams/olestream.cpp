@@ -0,0 +1,330 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * check of the OLE2 sub-streams of librevenge-stream. An OLE2 file is
+ * written in <dir> with small streams (in the mini stream), big streams
+ * and a storage holding both, the sectors of every chain being scattered
+ * over the file. It is then read through each kind of input stream:
+ *  - every stream is listed and exists,
+ *  - every stream, opened several times in a random order with the
+ *    parent moved in between, has the content it was written with.
+ *
+ * usage: check-olestream <dir>
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <string.h>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "streamcheck.h"
+
+using namespace streamcheck;
+
+namespace {
+
+const unsigned long SECTOR_SIZE = 512;
+const unsigned long MINI_SECTOR_SIZE = 64;
+//! streams under this size are in the mini stream
+const unsigned long MINI_STREAM_CUTOFF = 4096;
+const unsigned long ENTRY_SIZE = 128;
+
+const unsigned long FREESECT = 0xffffffff;
+const unsigned long ENDOFCHAIN = 0xfffffffe;
+const unsigned long FATSECT = 0xfffffffd;
+const unsigned long NOSTREAM = 0xffffffff;
+
+const unsigned ROUNDS = 5;
+
+struct Stream {
+    std::string path;
+    std::vector<unsigned char> data;
+};
+
+std::vector<Stream> streams() {
+    // sizes around the cutoff and the sector sizes, so that the mini
+    // stream, its allocation table and the directory take several sectors
+    static const struct {
+        const char *path;
+        unsigned long size;
+    } layout[] = {{"Small", 100},     {"Cutoff-1", 4095}, {"Mini1", 3000},
+                  {"Mini2", 2500},    {"Mini3", 3900},    {"Dir/Small", 1000},
+                  {"Dir/Big", 20000}, {"Cutoff", 4096},   {"Big", 100000},
+                  {"Huge", 300001}};
+    std::vector<Stream> result;
+    for (size_t i = 0; i < sizeof(layout) / sizeof(*layout); i++) {
+        Stream s;
+        s.path = layout[i].path;
+        Random random(i + 1);
+        for (unsigned long j = 0; j < layout[i].size; j++)
+            s.data.push_back((unsigned char)random.next(256));
+        result.push_back(s);
+    }
+    return result;
+}
+
+void put16(unsigned char *out, unsigned value) {
+    out[0] = value & 0xff;
+    out[1] = (value >> 8) & 0xff;
+}
+
+void put32(unsigned char *out, unsigned long value) {
+    put16(out, value & 0xffff);
+    put16(out + 2, (value >> 16) & 0xffff);
+}
+
+struct DirEntry {
+    std::string name;
+    unsigned type;
+    unsigned long child, right, start, size;
+    //! index of the stream, for the stream entries
+    size_t stream;
+};
+
+//! a chain of big sectors, and what it holds
+struct Chain {
+    std::vector<unsigned char> data;
+    std::vector<unsigned long> sectors;
+};
+
+//! link the sectors of a chain in an allocation table
+void link(std::vector<unsigned long> &table,
+          const std::vector<unsigned long> &sectors) {
+    for (size_t i = 0; i < sectors.size(); i++)
+        table[sectors[i]] =
+            i + 1 < sectors.size() ? sectors[i + 1] : ENDOFCHAIN;
+}
+
+unsigned long sectorCount(unsigned long size, unsigned long sectorSize) {
+    return (size + sectorSize - 1) / sectorSize;
+}
+
+std::vector<unsigned char> oleFile(const std::vector<Stream> &streams) {
+    // directory: the root, the storages and the streams, the children of an
+    // entry chained through their right siblings
+    std::vector<DirEntry> entries;
+    DirEntry root = {"Root Entry", 5, NOSTREAM, NOSTREAM, ENDOFCHAIN, 0, 0};
+    entries.push_back(root);
+    for (size_t i = 0; i < streams.size(); i++) {
+        unsigned long parent = 0;
+        std::string name = streams[i].path;
+        size_t slash = name.find('/');
+        if (slash != std::string::npos) {
+            std::string storage = name.substr(0, slash);
+            name = name.substr(slash + 1);
+            for (parent = 1; parent < entries.size(); parent++)
+                if (entries[parent].type == 1 &&
+                    entries[parent].name == storage)
+                    break;
+            if (parent == entries.size()) {
+                DirEntry dir = {storage, 1, NOSTREAM, entries[0].child, 0, 0,
+                                0};
+                entries[0].child = parent;
+                entries.push_back(dir);
+            }
+        }
+        DirEntry e = {name,       2,
+                      NOSTREAM,   entries[parent].child,
+                      ENDOFCHAIN, streams[i].data.size(),
+                      i};
+        entries[parent].child = entries.size();
+        entries.push_back(e);
+    }
+
+    // the small streams, one after the other in the mini stream
+    Chain miniStream, miniFat;
+    std::vector<unsigned long> miniTable;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].type != 2 || entries[i].size >= MINI_STREAM_CUTOFF)
+            continue;
+        const std::vector<unsigned char> &data =
+            streams[entries[i].stream].data;
+        std::vector<unsigned long> sectors;
+        unsigned long count = sectorCount(data.size(), MINI_SECTOR_SIZE);
+        for (unsigned long s = 0; s < count; s++)
+            sectors.push_back(miniTable.size() + s);
+        entries[i].start = sectors[0];
+        miniTable.resize(miniTable.size() + sectors.size());
+        link(miniTable, sectors);
+        miniStream.data.insert(miniStream.data.end(), data.begin(), data.end());
+        miniStream.data.resize(miniTable.size() * MINI_SECTOR_SIZE);
+    }
+    entries[0].size = miniStream.data.size();
+    miniTable.resize(sectorCount(miniTable.size() * 4, SECTOR_SIZE) *
+                         SECTOR_SIZE / 4,
+                     FREESECT);
+    miniFat.data.resize(miniTable.size() * 4);
+    for (size_t i = 0; i < miniTable.size(); i++)
+        put32(&miniFat.data[i * 4], miniTable[i]);
+
+    // the chains in big sectors: the directory, the mini stream, its
+    // allocation table and the big streams
+    std::vector<Chain> chains(3);
+    chains[0].data.resize(
+        sectorCount(entries.size(), SECTOR_SIZE / ENTRY_SIZE) * SECTOR_SIZE);
+    chains[1] = miniStream;
+    chains[2] = miniFat;
+    std::vector<size_t> chainOf(entries.size(), 0);
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].type != 2 || entries[i].size < MINI_STREAM_CUTOFF)
+            continue;
+        chainOf[i] = chains.size();
+        Chain c;
+        c.data = streams[entries[i].stream].data;
+        chains.push_back(c);
+    }
+
+    // the allocation table takes the first sectors, the chains take the
+    // next ones a few at a time in turn, so that they are scattered
+    unsigned long total = 0, fatSectors = 0;
+    for (size_t i = 0; i < chains.size(); i++)
+        total += sectorCount(chains[i].data.size(), SECTOR_SIZE);
+    while (fatSectors * SECTOR_SIZE / 4 < total + fatSectors)
+        fatSectors++;
+    Random random(42);
+    unsigned long next = fatSectors;
+    for (bool left = true; left;) {
+        left = false;
+        for (size_t i = 0; i < chains.size(); i++) {
+            unsigned long needed =
+                sectorCount(chains[i].data.size(), SECTOR_SIZE) -
+                chains[i].sectors.size();
+            for (unsigned long n = 1 + random.next(4); n && needed;
+                 n--, needed--)
+                chains[i].sectors.push_back(next++);
+            left = left || needed;
+        }
+    }
+    std::vector<unsigned long> fat(fatSectors * SECTOR_SIZE / 4, FREESECT);
+    for (unsigned long i = 0; i < fatSectors; i++)
+        fat[i] = FATSECT;
+    for (size_t i = 0; i < chains.size(); i++)
+        link(fat, chains[i].sectors);
+
+    if (!chains[1].sectors.empty())
+        entries[0].start = chains[1].sectors[0];
+    for (size_t i = 0; i < entries.size(); i++)
+        if (chainOf[i])
+            entries[i].start = chains[chainOf[i]].sectors[0];
+    for (size_t i = 0; i < entries.size(); i++) {
+        unsigned char *e = &chains[0].data[i * ENTRY_SIZE];
+        for (size_t c = 0; c < entries[i].name.size(); c++)
+            put16(e + 2 * c, (unsigned char)entries[i].name[c]);
+        put16(e + 64, 2 * (entries[i].name.size() + 1));
+        e[66] = entries[i].type;
+        e[67] = 1;
+        put32(e + 68, NOSTREAM);
+        put32(e + 72, entries[i].right);
+        put32(e + 76, entries[i].child);
+        put32(e + 116, entries[i].start);
+        put32(e + 120, entries[i].size);
+    }
+    // the unused entries have no siblings
+    for (size_t i = entries.size(); i * ENTRY_SIZE < chains[0].data.size();
+         i++) {
+        unsigned char *e = &chains[0].data[i * ENTRY_SIZE];
+        put32(e + 68, NOSTREAM);
+        put32(e + 72, NOSTREAM);
+        put32(e + 76, NOSTREAM);
+    }
+
+    std::vector<unsigned char> out((1 + next) * SECTOR_SIZE, 0);
+    static const unsigned char magic[] = {0xd0, 0xcf, 0x11, 0xe0,
+                                          0xa1, 0xb1, 0x1a, 0xe1};
+    memcpy(&out[0], magic, sizeof(magic));
+    put16(&out[0x18], 0x3e);
+    put16(&out[0x1a], 3);
+    put16(&out[0x1c], 0xfffe);
+    put16(&out[0x1e], 9);
+    put16(&out[0x20], 6);
+    put32(&out[0x2c], fatSectors);
+    put32(&out[0x30], chains[0].sectors[0]);
+    put32(&out[0x38], MINI_STREAM_CUTOFF);
+    put32(&out[0x3c], chains[2].sectors.empty() ? ENDOFCHAIN
+                                                : chains[2].sectors[0]);
+    put32(&out[0x40], chains[2].sectors.size());
+    put32(&out[0x44], ENDOFCHAIN);
+    for (unsigned long i = 0; i < 109; i++)
+        put32(&out[0x4c + 4 * i], i < fatSectors ? i : FREESECT);
+    for (size_t i = 0; i < fat.size(); i++)
+        put32(&out[SECTOR_SIZE + 4 * i], fat[i]);
+    for (size_t i = 0; i < chains.size(); i++)
+        for (size_t s = 0; s < chains[i].sectors.size(); s++) {
+            unsigned long offset = s * SECTOR_SIZE;
+            unsigned long size =
+                std::min(SECTOR_SIZE, chains[i].data.size() - offset);
+            memcpy(&out[(1 + chains[i].sectors[s]) * SECTOR_SIZE],
+                   &chains[i].data[offset], size);
+        }
+    return out;
+}
+
+std::string readStreams(librevenge::RVNGInputStream *input,
+                        const std::vector<Stream> &streams) {
+    if (!input->isStructured())
+        return "not seen as OLE2";
+    std::set<std::string> names;
+    for (unsigned i = 0; i < input->subStreamCount(); i++)
+        if (input->subStreamName(i))
+            names.insert(input->subStreamName(i));
+    for (size_t i = 0; i < streams.size(); i++)
+        if (!names.count(streams[i].path) ||
+            !input->existsSubStream(streams[i].path.c_str()))
+            return "missing stream " + streams[i].path;
+    if (input->existsSubStream("Missing"))
+        return "a missing stream exists";
+
+    Random random(7);
+    for (unsigned round = 0; round < ROUNDS * streams.size(); round++) {
+        const Stream &s = streams[random.next(streams.size())];
+        // the stream must not depend on where the parent was left
+        input->seek(random.next(1000), librevenge::RVNG_SEEK_SET);
+        std::unique_ptr<librevenge::RVNGInputStream> sub(
+            input->getSubStreamByName(s.path.c_str()));
+        if (!sub)
+            return "no stream " + s.path;
+        unsigned long got = 0;
+        const unsigned char *data = sub->read(s.data.size() + 1000, got);
+        if (got != s.data.size() || memcmp(data, &s.data[0], got) ||
+            !sub->isEnd())
+            return "wrong content of the stream " + s.path;
+    }
+    return "";
+}
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <dir>\n";
+        return 1;
+    }
+    std::string path = std::string(argv[1]) + "/olestream.ole";
+
+    std::vector<Stream> content = streams();
+    std::vector<unsigned char> ole = oleFile(content);
+    if (!writeFile(path, ole)) {
+        std::cerr << "[ERROR] impossible to write '" << path << "'\n";
+        return 1;
+    }
+
+    int failed = 0;
+    for (int kind = 0; streamNames[kind]; kind++) {
+        std::unique_ptr<librevenge::RVNGInputStream> input(
+            openStream(kind, path, ole));
+        std::string error = readStreams(input.get(), content);
+        if (!error.empty()) {
+            std::cerr << "[ERROR] " << streamNames[kind] << ": " << error
+                      << "\n";
+            failed++;
+        } else
+            std::cerr << "[OK] " << streamNames[kind] << "\n";
+    }
+    return failed ? 1 : 0;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
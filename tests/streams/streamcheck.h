@@ -0,0 +1,76 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * helpers shared by the checks of the input streams: a reproducible
+ * generator, and the kinds of librevenge input streams a file is opened
+ * with
+ */
+
+#ifndef STREAMCHECK_H
+#define STREAMCHECK_H
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+namespace streamcheck {
+
+//! xorshift generator, so that the checks are the same everywhere
+class Random {
+  public:
+    explicit Random(unsigned seed) : m_state(seed) {
+    }
+    unsigned next() {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+    unsigned next(unsigned bound) {
+        return next() % bound;
+    }
+
+  private:
+    unsigned m_state;
+};
+
+inline bool writeFile(const std::string &path,
+                      const std::vector<unsigned char> &data) {
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    bool ok = fwrite(&data[0], 1, data.size(), f) == data.size();
+    return fclose(f) == 0 && ok;
+}
+
+//! names of the input streams, indexed by the kind given to openStream()
+static const char *streamNames[] = {"RVNGFileStream", "RVNGStringStream",
+#ifdef HAVE_RVNG_MMAP_STREAM
+                                    "RVNGMMapStream",
+#endif
+                                    NULL};
+
+//! the file written at path from data, opened as the kind of stream
+inline librevenge::RVNGInputStream *
+openStream(int kind, const std::string &path,
+           const std::vector<unsigned char> &data) {
+    switch (kind) {
+    case 0:
+        return new librevenge::RVNGFileStream(path.c_str());
+    case 1:
+        return new librevenge::RVNGStringStream(&data[0], data.size());
+#ifdef HAVE_RVNG_MMAP_STREAM
+    case 2:
+        return new librevenge::RVNGMMapStream(path.c_str());
+#endif
+    default:
+        return NULL;
+    }
+}
+}
+
+#endif // STREAMCHECK_H
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
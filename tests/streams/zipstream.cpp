@@ -0,0 +1,316 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+
+/* vss2svg
+ * check of the ZIP sub-streams of librevenge-stream. A ZIP file with a
+ * deflated 1 MB entry and a stored one is written in <dir>, then read
+ * through each kind of input stream:
+ *  - random reads and seeks in the deflated entry must give the same
+ *    data, positions and return values as a plain buffer holding the
+ *    uncompressed data,
+ *  - the same entry corrupted halfway through must still be read to an
+ *    end, without getting more data than the entry holds.
+ *
+ * usage: check-zipstream <dir>
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "streamcheck.h"
+
+using namespace streamcheck;
+
+namespace {
+
+const unsigned long ENTRY_SIZE = 1000000;
+// backward seeks inflate the entry again from its start, hence not more
+const unsigned OPERATIONS = 20000;
+
+//! compressible data, made of words from a small vocabulary
+std::vector<unsigned char> entryData() {
+    static const char *words[] = {"shape", "master", "stencil", "page",
+                                  "geometry", "line", "fill", "text",
+                                  "\n", " ", "0123456789", "<Cell/>"};
+    Random random(1);
+    std::vector<unsigned char> data;
+    while (data.size() < ENTRY_SIZE) {
+        const char *word = words[random.next(sizeof(words) / sizeof(*words))];
+        data.insert(data.end(), word, word + strlen(word));
+        if (random.next(8) == 0)
+            data.push_back((unsigned char)random.next(256));
+    }
+    data.resize(ENTRY_SIZE);
+    return data;
+}
+
+std::vector<unsigned char> deflateData(const std::vector<unsigned char> &in) {
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    // raw deflate, as in the ZIP entries
+    deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                 Z_DEFAULT_STRATEGY);
+    std::vector<unsigned char> out(deflateBound(&zs, in.size()));
+    zs.next_in = (Bytef *)&in[0];
+    zs.avail_in = in.size();
+    zs.next_out = &out[0];
+    zs.avail_out = out.size();
+    deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+void put16(std::vector<unsigned char> &out, unsigned value) {
+    out.push_back(value & 0xff);
+    out.push_back((value >> 8) & 0xff);
+}
+
+void put32(std::vector<unsigned char> &out, unsigned long value) {
+    put16(out, value & 0xffff);
+    put16(out, (value >> 16) & 0xffff);
+}
+
+struct Entry {
+    std::string name;
+    std::vector<unsigned char> data;
+    bool deflated;
+};
+
+std::vector<unsigned char> zipFile(const std::vector<Entry> &entries) {
+    std::vector<unsigned char> out, directory;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const Entry &e = entries[i];
+        std::vector<unsigned char> stored =
+            e.deflated ? deflateData(e.data) : e.data;
+        unsigned long crc = crc32(0, &e.data[0], e.data.size());
+        // the fields shared by the local and the central headers
+        std::vector<unsigned char> fields;
+        put16(fields, 20);
+        put16(fields, 0);
+        put16(fields, e.deflated ? 8 : 0);
+        put16(fields, 0);
+        put16(fields, 0x21);
+        put32(fields, crc);
+        put32(fields, stored.size());
+        put32(fields, e.data.size());
+        put16(fields, e.name.size());
+        put16(fields, 0);
+
+        put32(directory, 0x02014b50);
+        put16(directory, 20);
+        directory.insert(directory.end(), fields.begin(), fields.end());
+        put16(directory, 0);
+        put16(directory, 0);
+        put16(directory, 0);
+        put32(directory, 0);
+        put32(directory, out.size());
+        directory.insert(directory.end(), e.name.begin(), e.name.end());
+
+        put32(out, 0x04034b50);
+        out.insert(out.end(), fields.begin(), fields.end());
+        out.insert(out.end(), e.name.begin(), e.name.end());
+        out.insert(out.end(), stored.begin(), stored.end());
+    }
+    unsigned long directoryOffset = out.size();
+    out.insert(out.end(), directory.begin(), directory.end());
+    put32(out, 0x06054b50);
+    put16(out, 0);
+    put16(out, 0);
+    put16(out, entries.size());
+    put16(out, entries.size());
+    put32(out, directory.size());
+    put32(out, directoryOffset);
+    put16(out, 0);
+    return out;
+}
+
+//! the behaviour expected from an input stream over data: reads stop at the
+//! end, seeks out of the data stop at its bounds and return 1
+//! (RVNGStringStream is not used as it ignores the offset of RVNG_SEEK_END)
+class Reference {
+  public:
+    explicit Reference(const std::vector<unsigned char> &data)
+        : m_data(data), m_offset(0) {
+    }
+    const unsigned char *read(unsigned long size, unsigned long &got) {
+        got = std::min<unsigned long>(size, m_data.size() - m_offset);
+        const unsigned char *p = got ? &m_data[m_offset] : NULL;
+        m_offset += got;
+        return p;
+    }
+    int seek(long offset, librevenge::RVNG_SEEK_TYPE type) {
+        if (type == librevenge::RVNG_SEEK_CUR)
+            offset += m_offset;
+        else if (type == librevenge::RVNG_SEEK_END)
+            offset += m_data.size();
+        if (offset < 0 || offset > (long)m_data.size()) {
+            m_offset = offset < 0 ? 0 : m_data.size();
+            return 1;
+        }
+        m_offset = offset;
+        return 0;
+    }
+    long tell() const {
+        return m_offset;
+    }
+    bool isEnd() const {
+        return m_offset >= (long)m_data.size();
+    }
+
+  private:
+    const std::vector<unsigned char> &m_data;
+    long m_offset;
+};
+
+//! replays random reads and seeks on the entry and on the reference,
+//! returns an empty string or what differed
+std::string randomAccess(librevenge::RVNGInputStream *entry,
+                         const std::vector<unsigned char> &data) {
+    Reference reference(data);
+    Random random(5);
+    char error[256];
+    for (unsigned op = 0; op < OPERATIONS; op++) {
+        unsigned kind = random.next(10);
+        if (kind < 6) {
+            // mostly small reads, sometimes larger than the inflate window
+            unsigned long size =
+                random.next(3) ? random.next(5000) : random.next(300000);
+            unsigned long got = 0, expected = 0;
+            const unsigned char *a = entry->read(size, got);
+            const unsigned char *b = reference.read(size, expected);
+            if (got != expected || (got && memcmp(a, b, got))) {
+                snprintf(error, sizeof(error),
+                         "operation %u: read of %lu bytes gave %lu bytes "
+                         "instead of %lu",
+                         op, size, got, expected);
+                return error;
+            }
+        } else {
+            librevenge::RVNG_SEEK_TYPE type = librevenge::RVNG_SEEK_SET;
+            long offset = (long)random.next(ENTRY_SIZE + 100000) - 50000;
+            if (kind >= 8) {
+                type = librevenge::RVNG_SEEK_CUR;
+                offset = (long)random.next(20000) - 10000;
+            }
+            if (random.next(20) == 0) {
+                type = librevenge::RVNG_SEEK_END;
+                offset = -(long)random.next(1000);
+            }
+            int a = entry->seek(offset, type);
+            int b = reference.seek(offset, type);
+            if ((a != 0) != (b != 0)) {
+                snprintf(error, sizeof(error),
+                         "operation %u: seek to %ld (%d) returned %d "
+                         "instead of %d",
+                         op, offset, (int)type, a, b);
+                return error;
+            }
+        }
+        if (entry->tell() != reference.tell() ||
+            entry->isEnd() != reference.isEnd()) {
+            snprintf(error, sizeof(error),
+                     "operation %u: at %ld (end %d) instead of %ld (end %d)",
+                     op, entry->tell(), (int)entry->isEnd(), reference.tell(),
+                     (int)reference.isEnd());
+            return error;
+        }
+    }
+    return "";
+}
+
+//! reads the corrupted entry in 4 KiB steps, as the XML readers do
+std::string readCorrupted(librevenge::RVNGInputStream *entry) {
+    unsigned long total = 0, steps = 0;
+    while (!entry->isEnd()) {
+        unsigned long got = 0;
+        entry->read(4096, got);
+        total += got;
+        // each step must make progress, up to the size of the entry
+        if (total > ENTRY_SIZE || ++steps > ENTRY_SIZE / 4096 + 2)
+            return "the corrupted entry is read past its size";
+        if (got == 0 && !entry->isEnd())
+            return "the corrupted entry never ends";
+    }
+    return "";
+}
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <dir>\n";
+        return 1;
+    }
+    std::string dir(argv[1]);
+
+    std::vector<unsigned char> data = entryData();
+    std::vector<Entry> entries(2);
+    entries[0].name = "big";
+    entries[0].data = data;
+    entries[0].deflated = true;
+    const char *small = "stored entry";
+    entries[1].name = "small";
+    entries[1].data.assign(small, small + strlen(small));
+    entries[1].deflated = false;
+    std::vector<unsigned char> zip = zipFile(entries);
+
+    // invalid deflate blocks in the middle of the data of the first entry,
+    // which takes all but the last couple hundred bytes of the file
+    std::vector<unsigned char> corrupted(zip);
+    for (size_t i = zip.size() / 2; i < zip.size() / 2 + 4096; i++)
+        corrupted[i] = 0xff;
+
+    std::string zipPath = dir + "/zipstream.zip";
+    std::string corruptedPath = dir + "/zipstream-corrupted.zip";
+    if (!writeFile(zipPath, zip) || !writeFile(corruptedPath, corrupted)) {
+        std::cerr << "[ERROR] impossible to write the ZIP files in '" << dir
+                  << "'\n";
+        return 1;
+    }
+
+    int failed = 0;
+    for (int kind = 0; streamNames[kind]; kind++) {
+        std::string error;
+        std::unique_ptr<librevenge::RVNGInputStream> input(
+            openStream(kind, zipPath, zip));
+        std::unique_ptr<librevenge::RVNGInputStream> big(
+            input->getSubStreamByName("big"));
+        std::unique_ptr<librevenge::RVNGInputStream> stored(
+            input->getSubStreamByName("small"));
+        if (!big || !stored)
+            error = "missing entry";
+        else
+            error = randomAccess(big.get(), data);
+        if (error.empty()) {
+            unsigned long got = 0;
+            const unsigned char *content = stored->read(100, got);
+            if (got != strlen(small) || memcmp(content, small, got))
+                error = "wrong content of the stored entry";
+        }
+        if (error.empty()) {
+            std::unique_ptr<librevenge::RVNGInputStream> broken(
+                openStream(kind, corruptedPath, corrupted));
+            // a corrupted entry may as well be rejected up front
+            std::unique_ptr<librevenge::RVNGInputStream> entry(
+                broken->getSubStreamByName("big"));
+            if (entry)
+                error = readCorrupted(entry.get());
+        }
+        if (!error.empty()) {
+            std::cerr << "[ERROR] " << streamNames[kind] << ": " << error
+                      << "\n";
+            failed++;
+        } else
+            std::cerr << "[OK] " << streamNames[kind] << "\n";
+    }
+    return failed ? 1 : 0;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */